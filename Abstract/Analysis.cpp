@@ -274,24 +274,30 @@ void Analysis::removeSPCNodeDofs(SinglePointConstraint& spc, int nodePosition,
 }
 
 void Analysis::addBoundaryDOFS(int nodePosition, const DOFS dofs) {
-    boundaryDOFSByNodePosition[nodePosition] = DOFS(boundaryDOFSByNodePosition[nodePosition]) + dofs;
+    boundaryDOFS.allow(nodePosition, dofs);
 }
 
-const DOFS Analysis::findBoundaryDOFS(int nodePosition) const {
-    const auto& entry = boundaryDOFSByNodePosition.find(nodePosition);
-    if (entry == boundaryDOFSByNodePosition.end()) {
-        return DOFS::NO_DOFS;
-    } else {
-        return entry->second;
+void Analysis::addBoundaryDOFS(const vector<shared_ptr<BoundaryCondition>>& boundaryConditions) {
+    vector<NodeSet> nodeSets;
+    nodeSets.reserve(boundaryConditions.size());
+    for (const auto& boundaryCondition : boundaryConditions) {
+        nodeSets.push_back(boundaryCondition->nodePositions());
     }
+    boundaryDOFS.resize(max(boundaryDOFS.size(), static_cast<size_t>(model.mesh->countNodes())));
+    boundaryDOFS.allowAll(nodeSets, [&boundaryConditions](size_t i, int nodePosition) {
+        return boundaryConditions[i]->getDOFSForNode(nodePosition);
+    });
+    boundaryDOFS.compact();
+}
+
+const DOFS Analysis::findBoundaryDOFS(int nodePosition) const {
+    return model.commonBoundaryDOFS.find(nodePosition) + boundaryDOFS.find(nodePosition);
 }
 
 const set<int> Analysis::boundaryNodePositions() const {
-    set<int> result;
-    for (auto& entry : boundaryDOFSByNodePosition) {
-        result.insert(entry.first);
-    }
-    return result;
+    NodeSet nodePositions = boundaryDOFS.nodePositions();
+    nodePositions.insert(model.commonBoundaryDOFS.nodePositions());
+    return set<int>(nodePositions.begin(), nodePositions.end());
 }
 
 Analysis::~Analysis() {
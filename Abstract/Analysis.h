@@ -50,7 +50,7 @@ class ModelConfiguration;
 class Analysis: public Identifiable<Analysis> {
 private:
     friend ostream &operator<<(ostream &out, const Analysis& analysis);    //output
-    std::map<int, char> boundaryDOFSByNodePosition;
+    DOFMasks boundaryDOFS;
     const string label;         /**< User defined label for this instance of Analysis. **/
 public:
     enum Type {
@@ -110,6 +110,16 @@ public:
 
     void removeSPCNodeDofs(SinglePointConstraint& spc, int nodePosition, const DOFS dofs);
     void addBoundaryDOFS(int nodePosition, const DOFS dofs);
+    /**
+     * Adds the DOFs used by the boundary conditions on their nodes. Only the boundary
+     * conditions specific to this analysis are needed: the others are in the common
+     * boundary DOFs of the model.
+     */
+    void addBoundaryDOFS(const vector<std::shared_ptr<BoundaryCondition>>& boundaryConditions);
+    /**
+     * DOFs used on the node by the boundary conditions of the analysis, including the
+     * common ones of the model.
+     */
     const DOFS findBoundaryDOFS(int nodePosition) const;
     const set<int> boundaryNodePositions() const;
 
@@ -13,6 +13,7 @@
 
 #include <cfloat>
 #include "Dof.h"
+#include "NodeSet.h"
 #include "Utility.h"
 #include <unordered_map>
 #include <set>
@@ -26,7 +27,7 @@ public:
 		throw logic_error("boundary condition ineffective() used but not implemented");
 	}
 	virtual const DOFS getDOFSForNode(int nodePosition) const = 0;
-	virtual std::set<int> nodePositions() const = 0;
+	virtual NodeSet nodePositions() const = 0;
 	virtual ~BoundaryCondition();
 };
 
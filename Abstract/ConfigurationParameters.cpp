@@ -25,7 +25,11 @@ ConfigurationParameters::ConfigurationParameters(string inputFile, Solver output
         string solverServer, string solverCommand,
         string systusRBE2TranslationMode, double systusRBE2Rigidity, double systusRBELagrangian,
         string systusOptionAnalysis, string systusOutputProduct, vector<vector<int> > systusSubcases,
-        string systusOutputMatrix, int systusSizeMatrix, string systusDynamicMethod) :
+        string systusOutputMatrix, int systusSizeMatrix, string systusDynamicMethod,
+        string nastranFieldFormat, int asterMaxCpus, double asterMaxMemory, double asterMaxTime,
+        int asterModalBands, double solverTimeout, int solverMaxCpus, double solverMaxMemory,
+        string testNodes, string testDofs, string testSubcases, string testSteps,
+        int testSampleCount, string testSampling, string diagnosticsFile) :
                 inputFile(inputFile), outputSolver(outputSolver), solverVersion(solverVersion), outputFile(
                 outputFile), outputPath(outputPath), logLevel(logLevel), translationMode(
                 translationMode), resultFile(resultFile), testTolerance(tolerance), runSolver(
@@ -33,19 +37,27 @@ ConfigurationParameters::ConfigurationParameters(string inputFile, Solver output
                 systusRBE2TranslationMode(systusRBE2TranslationMode), systusRBE2Rigidity(systusRBE2Rigidity),
                 systusRBELagrangian(systusRBELagrangian), systusOptionAnalysis(systusOptionAnalysis),
                 systusOutputProduct(systusOutputProduct), systusSubcases(systusSubcases),
-                systusOutputMatrix(systusOutputMatrix), systusSizeMatrix(systusSizeMatrix), systusDynamicMethod(systusDynamicMethod)
+                systusOutputMatrix(systusOutputMatrix), systusSizeMatrix(systusSizeMatrix), systusDynamicMethod(systusDynamicMethod),
+                nastranFieldFormat(nastranFieldFormat), asterMaxCpus(asterMaxCpus),
+                asterMaxMemory(asterMaxMemory), asterMaxTime(asterMaxTime),
+                asterModalBands(asterModalBands), solverTimeout(solverTimeout),
+                solverMaxCpus(solverMaxCpus), solverMaxMemory(solverMaxMemory),
+                testNodes(testNodes), testDofs(testDofs), testSubcases(testSubcases),
+                testSteps(testSteps), testSampleCount(testSampleCount), testSampling(testSampling),
+                diagnosticsFile(diagnosticsFile)
 {
 
 }
 
 const ModelConfiguration ConfigurationParameters::getModelConfiguration() const {
     if (this->outputSolver.getSolverName() == CODE_ASTER) {
-        return ModelConfiguration(true, this->logLevel, true);
+        return ModelConfiguration(true, this->logLevel, true, true, false, true, true, true, false,
+                true, true, false, 999, false, false, true);
     } else if (this->outputSolver.getSolverName() == SYSTUS) {
-        return ModelConfiguration(false, this->logLevel, true, false, false, true, true, true, false, false, true, true, this->systusSizeMatrix, true, true);
+        return ModelConfiguration(false, this->logLevel, true, false, false, true, true, true, false, false, true, true, this->systusSizeMatrix, true, true, false);
     } else if (this->outputSolver.getSolverName() == NASTRAN) {
         return ModelConfiguration(false, this->logLevel, false, false, false, false, false, false,
-                false, false, false);
+                false, false, false, false, 999, false, false, false);
     } else {
         throw logic_error(" solver not implemented");
     }
@@ -90,7 +102,7 @@ ModelConfiguration::ModelConfiguration(bool virtualDiscrets, LogLevel logLevel,
         bool emulateLocalDisplacement, bool displayHomogeneousConstraint,
         bool emulateAdditionalMass, bool replaceCombinedLoadSets, bool removeIneffectives,
         bool partitionModel, bool replaceDirectMatrices, bool removeRedundantSpcs, bool splitDirectMatrices, int sizeDirectMatrices,
-        bool makeCellsFromDirectMatrices, bool makeCellsFromRBE) :
+        bool makeCellsFromDirectMatrices, bool makeCellsFromRBE, bool mergeIdenticalDefinitions) :
         virtualDiscrets(virtualDiscrets), logLevel(logLevel), createSkin(createSkin), emulateLocalDisplacement(
                 emulateLocalDisplacement), displayHomogeneousConstraint(
                 displayHomogeneousConstraint), emulateAdditionalMass(emulateAdditionalMass), replaceCombinedLoadSets(
@@ -98,7 +110,7 @@ ModelConfiguration::ModelConfiguration(bool virtualDiscrets, LogLevel logLevel,
                 partitionModel), replaceDirectMatrices(replaceDirectMatrices), removeRedundantSpcs(
                 removeRedundantSpcs), splitDirectMatrices(splitDirectMatrices), sizeDirectMatrices(sizeDirectMatrices),
                 makeCellsFromDirectMatrices(makeCellsFromDirectMatrices),
-                makeCellsFromRBE(makeCellsFromRBE){
+                makeCellsFromRBE(makeCellsFromRBE), mergeIdenticalDefinitions(mergeIdenticalDefinitions){
 }
 
 }
@@ -76,7 +76,8 @@ public:
             bool removeRedundantSpcs = true,
             bool splitDirectMatrices = false, int sizeDirectMatrices = 999,
             bool makeCellsFromDirectMatrices = false,
-            bool makeCellsFromRBE = false
+            bool makeCellsFromRBE = false,
+            bool mergeIdenticalDefinitions = false
             );
     virtual ~ModelConfiguration() {
     }
@@ -120,6 +121,13 @@ public:
      *  needed cells.
      */
     const bool makeCellsFromRBE;
+    /**
+     *  Merge the identical function tables and materials, so that each definition is written once.
+     *  This bool commands the use of Model::internValues() and Model::internMaterials() in
+     *  Model::finish(). Writers that modify or number the materials by ElementSet (SYSTUS), or that
+     *  must keep the input cards (NASTRAN), leave it off.
+     */
+    const bool mergeIdenticalDefinitions;
 };
 // TODO: THe Configuration Parameters should be much more generalized. With this,
 // it's a pain in the keyboard to add options!!
@@ -141,7 +149,12 @@ public:
             std::string systusOptionAnalysis="auto", std::string systusOutputProduct="systus",
             std::vector< std::vector<int> > systusSubcases = {},
             std::string systusOutputMatrix="table", int systusSizeMatrix=9,
-            std::string systusDynamicMethod="direct");
+            std::string systusDynamicMethod="direct", std::string nastranFieldFormat="small",
+            int asterMaxCpus = 0, double asterMaxMemory = 0, double asterMaxTime = 0,
+            int asterModalBands = 1, double solverTimeout = 0, int solverMaxCpus = 0,
+            double solverMaxMemory = 0, std::string testNodes = "", std::string testDofs = "",
+            std::string testSubcases = "", std::string testSteps = "", int testSampleCount = 0,
+            std::string testSampling = "stride", std::string diagnosticsFile = "");
     const ModelConfiguration getModelConfiguration() const;
     virtual ~ConfigurationParameters();
 
@@ -177,6 +190,54 @@ public:
      * Choice of Dynamic method : either a direct or a modal one
      */
     const std::string systusDynamicMethod;
+    /**
+     * Format of the Nastran bulk data cards: "small" (8 chars fields), "large" (16 chars fields)
+     * or "free" (comma separated fields).
+     */
+    const std::string nastranFieldFormat;
+    /**
+     * Upper limits of the resources planned for a Code_Aster run: number of processors,
+     * memory (MB) and time (s). 0 means no limit, but the processors are still limited to the
+     * hardware threads of the host.
+     */
+    const int asterMaxCpus;
+    const double asterMaxMemory;
+    const double asterMaxTime;
+    /**
+     * Number of frequency sub-bands of the Code_Aster modal analyses, computed in parallel:
+     * 1 for a single band, 0 for one sub-band by MPI process.
+     */
+    const int asterModalBands;
+    /**
+     * Time (s) after which a solver run is killed, 0 for no limit.
+     */
+    const double solverTimeout;
+    /**
+     * Budget shared by the solver runs of the process: processors (0 for the number of
+     * hardware threads) and memory (MB, 0 for no limit). See SolverQueue.
+     */
+    const int solverMaxCpus;
+    const double solverMaxMemory;
+    /**
+     * Selection of the results read in the test file: nodes (ids, ranges "first:last" and
+     * groups), DOFs, subcases and steps or frequencies, as comma separated lists (empty for
+     * all of them). See result::ResultFilter.
+     */
+    std::string testNodes;
+    std::string testDofs;
+    std::string testSubcases;
+    std::string testSteps;
+    /**
+     * Maximum number of values read in the test file (0 for no limit), chosen by 'stride'
+     * or at 'random' among the selected ones.
+     */
+    int testSampleCount;
+    std::string testSampling;
+    /**
+     * JSON file where all the problems found while parsing the input file are written,
+     * empty for none (only their summary is printed).
+     */
+    const std::string diagnosticsFile;
 };
 
 }
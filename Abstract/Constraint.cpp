@@ -135,15 +135,11 @@ void HomogeneousConstraint::addSlave(int slaveId) {
     this->slavePositions.insert(model.mesh->findOrReserveNode(slaveId));
 }
 
-set<int> HomogeneousConstraint::nodePositions() const {
-    set<int> result;
+NodeSet HomogeneousConstraint::nodePositions() const {
+    NodeSet result(slavePositions.begin(), slavePositions.end());
     if (this->masterPosition != UNAVAILABLE_MASTER) {
         result.insert(masterPosition);
     }
-
-    for (int slavePosition : slavePositions) {
-        result.insert(slavePosition);
-    }
     return result;
 }
 
@@ -297,14 +293,12 @@ const {
     return shared_ptr<Constraint>(new SinglePointConstraint(*this));
 }
 
-set<int> SinglePointConstraint::nodePositions() const {
-    set<int> result;
-    result.insert(_nodePositions.begin(), _nodePositions.end());
+NodeSet SinglePointConstraint::nodePositions() const {
+    NodeSet result(_nodePositions);
     if (group != nullptr) {
         if (this->group->type == Group::NODEGROUP) {
             NodeGroup* const ngroup = static_cast<NodeGroup* const >(group);
-            set<int> nodePositions = ngroup->nodePositions();
-            result.insert(nodePositions.begin(), nodePositions.end());
+            result.insert(ngroup->nodePositions());
         } else {
             throw logic_error("SPC:: getAllNodes on unknown group type");
         }
@@ -313,9 +307,7 @@ set<int> SinglePointConstraint::nodePositions() const {
 }
 
 void SinglePointConstraint::removeNode(int nodePosition) {
-    if (_nodePositions.find(nodePosition) != _nodePositions.end()) {
-        _nodePositions.erase(nodePosition);
-    }
+    _nodePositions.erase(nodePosition);
     if (group != nullptr) {
         if (group->type == Group::NODEGROUP) {
             NodeGroup* const ngroup = static_cast<NodeGroup* const >(group);
@@ -347,7 +339,7 @@ bool SinglePointConstraint::hasReferences() const {
 }
 
 bool SinglePointConstraint::ineffective() const {
-    return nodePositions().size() == 0;
+    return nodePositions().empty();
 }
 
 double SinglePointConstraint::getDoubleForDOF(const DOF& dof) const {
@@ -399,12 +391,13 @@ void LinearMultiplePointConstraint::addParticipation(int nodeId, double dx, doub
         dofCoefsByNodePosition[nodePosition] += DofCoefs(dx, dy, dz, rx, ry, rz);
 }
 
-set<int> LinearMultiplePointConstraint::nodePositions() const {
-    set<int> result;
-    for (auto it : dofCoefsByNodePosition) {
-        result.insert(it.first);
+NodeSet LinearMultiplePointConstraint::nodePositions() const {
+    vector<int> positions;
+    positions.reserve(dofCoefsByNodePosition.size());
+    for (const auto& it : dofCoefsByNodePosition) {
+        positions.push_back(it.first);
     }
-    return result;
+    return NodeSet(positions.begin(), positions.end());
 }
 
 const DOFS LinearMultiplePointConstraint::getDOFSForNode(int nodePosition) const {
@@ -481,12 +474,13 @@ vector<shared_ptr<Gap::GapParticipation>> GapTwoNodes::getGaps() const {
     return result;
 }
 
-set<int> GapTwoNodes::nodePositions() const {
-    set<int> result;
-    for (auto it : directionNodePositionByconstrainedNodePosition) {
-        result.insert(it.first);
+NodeSet GapTwoNodes::nodePositions() const {
+    vector<int> positions;
+    positions.reserve(directionNodePositionByconstrainedNodePosition.size());
+    for (const auto& it : directionNodePositionByconstrainedNodePosition) {
+        positions.push_back(it.first);
     }
-    return result;
+    return NodeSet(positions.begin(), positions.end());
 }
 
 void GapTwoNodes::removeNode(int nodePosition) {
@@ -542,12 +536,13 @@ vector<shared_ptr<Gap::GapParticipation>> GapNodeDirection::getGaps() const {
     return result;
 }
 
-set<int> GapNodeDirection::nodePositions() const {
-    set<int> result;
-    for (auto it : directionBynodePosition) {
-        result.insert(it.first);
+NodeSet GapNodeDirection::nodePositions() const {
+    vector<int> positions;
+    positions.reserve(directionBynodePosition.size());
+    for (const auto& it : directionBynodePosition) {
+        positions.push_back(it.first);
     }
-    return result;
+    return NodeSet(positions.begin(), positions.end());
 }
 
 void GapNodeDirection::removeNode(int nodePosition) {
@@ -88,7 +88,7 @@ public:
 	virtual void addSlave(int slaveId);
 	virtual int getMaster() const;
 	virtual std::set<int> getSlaves() const;
-	std::set<int> nodePositions() const override;
+	NodeSet nodePositions() const override;
 	const DOFS getDOFSForNode(int nodePosition) const override;
 	const DOFS getDOFS() const;
 	void removeNode(int nodePosition) override;
@@ -139,7 +139,7 @@ public:
 };
 
 class SinglePointConstraint: public Constraint {
-	std::set<int> _nodePositions;
+	NodeSet _nodePositions;
 	std::array<ValueOrReference, 6> spcs;
 public:
 	//GC: static initialization order is undefined. A reference is needed here to
@@ -165,7 +165,7 @@ public:
 	void setDOFS(const DOFS& dofs, const ValueOrReference& value);
 	double getDoubleForDOF(const DOF& dof) const;
 	std::shared_ptr<Value> getReferenceForDOF(const DOF& dof) const;
-	virtual std::set<int> nodePositions() const override;
+	virtual NodeSet nodePositions() const override;
 	void removeNode(int nodePosition) override;
 	const DOFS getDOFSForNode(int nodePosition) const override;
 	bool hasReferences() const;
@@ -209,7 +209,7 @@ public:
 	void addParticipation(int nodeId, double dx = 0, double dy = 0, double dz = 0, double rx = 0,
 			double ry = 0, double rz = 0);
 	DofCoefs getDoFCoefsForNode(int nodePosition) const;
-	std::set<int> nodePositions() const override;
+	NodeSet nodePositions() const override;
 	const DOFS getDOFSForNode(int nodePosition) const override;
 	void removeNode(int nodePosition) override;
 	bool ineffective() const override;
@@ -238,7 +238,7 @@ public:
 	GapTwoNodes(Model& model, int original_id = NO_ORIGINAL_ID);
 	std::shared_ptr<Constraint> clone() const override;
 	void addGapNodes(int constrainedNodeId, int directionNodeId);
-	std::set<int> nodePositions() const override;
+	NodeSet nodePositions() const override;
 	const DOFS getDOFSForNode(int nodePosition) const override;
 	std::vector<std::shared_ptr<GapParticipation>> getGaps() const override;
 	void removeNode(int nodePosition) override;
@@ -253,7 +253,7 @@ public:
 	std::shared_ptr<Constraint> clone() const override;
 	void addGapNodeDirection(int constrainedNodeId, double directionX, double directionY = 0,
 			double directionZ = 0);
-	std::set<int> nodePositions() const override;
+	NodeSet nodePositions() const override;
 	const DOFS getDOFSForNode(int nodePosition) const override;
 	std::vector<std::shared_ptr<GapParticipation>> getGaps() const override;
 	void removeNode(int nodePosition) override;
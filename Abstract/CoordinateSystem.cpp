@@ -174,6 +174,16 @@ const VectorialValue CylindricalCoordinateSystem::vectorToGlobal(
     return VectorialValue(x, y, z);
 }
 
+const VectorialValue CylindricalCoordinateSystem::vectorToGlobalAt(const VectorialValue& point,
+        const VectorialValue& local) const {
+    const VectorialValue pointUtheta = ez.cross(point - origin).normalized();
+    const VectorialValue pointUr = pointUtheta.cross(ez);
+    double x = local.x() * pointUr.x() + local.y() * pointUtheta.x() + local.z() * ez.x();
+    double y = local.x() * pointUr.y() + local.y() * pointUtheta.y() + local.z() * ez.y();
+    double z = local.x() * pointUr.z() + local.y() * pointUtheta.z() + local.z() * ez.z();
+    return VectorialValue(x, y, z);
+}
+
 const VectorialValue CylindricalCoordinateSystem::vectorToLocal(const VectorialValue& global) const {
     UNUSEDV(global);
     throw logic_error("Global To Local vector conversion not done for Cylindrical Coordinate System");
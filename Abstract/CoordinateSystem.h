@@ -89,6 +89,17 @@ class CoordinateSystem: public Identifiable<CoordinateSystem> {
      *   account, so do NOT use this to convert coordinates.
      **/
     virtual const VectorialValue vectorToGlobal(const VectorialValue&) const = 0;
+    /**
+     *  Translate a vector, expressed in the local base at point, to its global
+     *   counterpart. Unlike updateLocalBase() then vectorToGlobal(), the coordinate
+     *   system is left untouched, so it can be shared by several threads.
+     *   Point must be expressed in the reference cartesian coordinate system.
+     **/
+    virtual const VectorialValue vectorToGlobalAt(const VectorialValue& point,
+            const VectorialValue& local) const {
+        UNUSEDV(point);
+        return vectorToGlobal(local);
+    }
     /**
      *  Translate a vector, expressed in the global Coordinate system,
      *   to its local counterpart. Warning, it does not take the origin into
@@ -181,6 +192,8 @@ class CylindricalCoordinateSystem: public CoordinateSystem {
      *   account, so do NOT use this to convert coordinates.
      **/
     const VectorialValue vectorToGlobal(const VectorialValue&) const override;
+    const VectorialValue vectorToGlobalAt(const VectorialValue& point,
+            const VectorialValue& local) const override;
     const VectorialValue vectorToLocal(const VectorialValue&) const override;
 
     /**
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Diagnostics.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "Diagnostics.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace vega {
+
+using namespace std;
+
+namespace {
+
+string jsonString(const string& text) {
+	string result = "\"";
+	for (char c : text) {
+		switch (c) {
+		case '"':
+			result += "\\\"";
+			break;
+		case '\\':
+			result += "\\\\";
+			break;
+		case '\n':
+			result += "\\n";
+			break;
+		case '\t':
+			result += "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20) {
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+				result += escaped;
+			} else {
+				result += c;
+			}
+		}
+	}
+	return result + "\"";
+}
+
+const char* severityName(DiagnosticCollector::Severity severity) {
+	return severity == DiagnosticCollector::Severity::ERROR ? "error" : "warning";
+}
+
+}
+
+int DiagnosticCollector::intern(const string& text) {
+	auto it = indexByString.find(text);
+	if (it != indexByString.end()) {
+		return it->second;
+	}
+	const int index = static_cast<int>(strings.size());
+	strings.push_back(text);
+	indexByString[text] = index;
+	return index;
+}
+
+void DiagnosticCollector::add(Severity severity, const string& message, const string& fileName,
+		int lineNumber, const string& keyword) {
+	lock_guard<std::mutex> lock(mutex);
+	const auto key = make_tuple(severity, intern(keyword), intern(message));
+	auto it = kindByKey.find(key);
+	if (it == kindByKey.end()) {
+		Kind kind;
+		kind.severity = severity;
+		kind.keyword = get<1>(key);
+		kind.message = get<2>(key);
+		kind.count = 0;
+		kind.first = diagnostics.size();
+		it = kindByKey.insert(make_pair(key, static_cast<int>(kinds.size()))).first;
+		kinds.push_back(kind);
+	}
+	kinds[static_cast<size_t>(it->second)].count++;
+	diagnostics.push_back({ it->second, intern(fileName), lineNumber });
+}
+
+size_t DiagnosticCollector::size() const {
+	lock_guard<std::mutex> lock(mutex);
+	return diagnostics.size();
+}
+
+size_t DiagnosticCollector::countKinds() const {
+	lock_guard<std::mutex> lock(mutex);
+	return kinds.size();
+}
+
+size_t DiagnosticCollector::count(Severity severity) const {
+	lock_guard<std::mutex> lock(mutex);
+	size_t result = 0;
+	for (const Kind& kind : kinds) {
+		result += kind.severity == severity ? kind.count : 0;
+	}
+	return result;
+}
+
+string DiagnosticCollector::format(const Kind& kind, const string& keyword,
+		const string& message, const string& file, int lineNumber) {
+	return string(kind.severity == Severity::ERROR ? "Parsing error in " : "Parsing warning in ")
+			+ keyword + " (file " + file + " line " + to_string(lineNumber) + "): " + message;
+}
+
+void DiagnosticCollector::printSummary(ostream& out, size_t maxKinds) const {
+	lock_guard<std::mutex> lock(mutex);
+	if (diagnostics.empty()) {
+		return;
+	}
+	size_t errorCount = 0;
+	vector<size_t> order(kinds.size());
+	for (size_t i = 0; i < kinds.size(); i++) {
+		order[i] = i;
+		errorCount += kinds[i].severity == Severity::ERROR ? kinds[i].count : 0;
+	}
+	// errors first, then the most frequent kinds
+	stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+		if (kinds[a].severity != kinds[b].severity) {
+			return kinds[a].severity == Severity::ERROR;
+		}
+		return kinds[a].count > kinds[b].count;
+	});
+	out << "Parsing diagnostics: " << errorCount << " errors, "
+			<< diagnostics.size() - errorCount << " warnings, of " << kinds.size() << " kinds."
+			<< endl;
+	for (size_t i = 0; i < min(maxKinds, order.size()); i++) {
+		const Kind& kind = kinds[order[i]];
+		const Diagnostic& first = diagnostics[kind.first];
+		out << format(kind, strings[static_cast<size_t>(kind.keyword)],
+				strings[static_cast<size_t>(kind.message)],
+				strings[static_cast<size_t>(first.file)], first.lineNumber);
+		if (kind.count > 1) {
+			out << " [" << kind.count << " times]";
+		}
+		out << endl;
+	}
+	if (order.size() > maxKinds) {
+		out << "... and " << order.size() - maxKinds << " other kinds." << endl;
+	}
+}
+
+void DiagnosticCollector::writeJson(ostream& out) const {
+	lock_guard<std::mutex> lock(mutex);
+	out << "{\n  \"kinds\": [";
+	for (size_t i = 0; i < kinds.size(); i++) {
+		const Kind& kind = kinds[i];
+		out << (i == 0 ? "\n" : ",\n") << "    {\"id\": " << i << ", \"severity\": \""
+				<< severityName(kind.severity) << "\", \"keyword\": "
+				<< jsonString(strings[static_cast<size_t>(kind.keyword)]) << ", \"message\": "
+				<< jsonString(strings[static_cast<size_t>(kind.message)]) << ", \"count\": "
+				<< kind.count << "}";
+	}
+	out << "\n  ],\n  \"diagnostics\": [";
+	for (size_t i = 0; i < diagnostics.size(); i++) {
+		const Diagnostic& diagnostic = diagnostics[i];
+		out << (i == 0 ? "\n" : ",\n") << "    {\"kind\": " << diagnostic.kind << ", \"file\": "
+				<< jsonString(strings[static_cast<size_t>(diagnostic.file)]) << ", \"line\": "
+				<< diagnostic.lineNumber << "}";
+	}
+	out << "\n  ]\n}\n";
+}
+
+void DiagnosticCollector::clear() {
+	lock_guard<std::mutex> lock(mutex);
+	diagnostics.clear();
+	kinds.clear();
+	strings.clear();
+	indexByString.clear();
+	kindByKey.clear();
+}
+
+} /* namespace vega */
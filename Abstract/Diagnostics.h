@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Diagnostics.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef DIAGNOSTICS_H_
+#define DIAGNOSTICS_H_
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace vega {
+
+/**
+ * Problems found while reading an input file (unsupported cards, ignored parameters...),
+ * recorded without formatting a message for each of them: industrial decks may give hundreds
+ * of thousands of warnings.
+ *
+ * A diagnostic is a kind (severity, keyword, message), a file and a line, stored as indexes
+ * of the strings. The diagnostics of the same kind are counted together: a summary of the
+ * most frequent kinds is printed at the end of the parsing, and the whole list can be written
+ * to a JSON file.
+ */
+class DiagnosticCollector final {
+public:
+	enum class Severity : unsigned char {
+		WARNING,
+		ERROR
+	};
+	struct Diagnostic {
+		int kind;
+		int file;
+		int lineNumber;
+	};
+	struct Kind {
+		Severity severity;
+		int keyword;
+		int message;
+		std::size_t count;
+		/**
+		 * Index of the first diagnostic of this kind.
+		 */
+		std::size_t first;
+	};
+	/**
+	 * Number of kinds printed by default in the summary.
+	 */
+	static const std::size_t SUMMARY_SIZE = 20;
+private:
+	mutable std::mutex mutex;
+	std::vector<Diagnostic> diagnostics;
+	std::vector<Kind> kinds;
+	std::vector<std::string> strings;
+	std::unordered_map<std::string, int> indexByString;
+	std::map<std::tuple<Severity, int, int>, int> kindByKey;
+	int intern(const std::string& text);
+	static std::string format(const Kind& kind, const std::string& keyword,
+			const std::string& message, const std::string& file, int lineNumber);
+public:
+	void add(Severity severity, const std::string& message, const std::string& fileName,
+			int lineNumber, const std::string& keyword);
+	std::size_t size() const;
+	std::size_t countKinds() const;
+	std::size_t count(Severity severity) const;
+	/**
+	 * Prints the maxKinds most frequent kinds, with their count and their first place.
+	 */
+	void printSummary(std::ostream& out, std::size_t maxKinds = SUMMARY_SIZE) const;
+	/**
+	 * Writes the kinds and all the diagnostics, in the order they were found, as a JSON
+	 * document.
+	 */
+	void writeJson(std::ostream& out) const;
+	void clear();
+};
+
+} /* namespace vega */
+
+#endif /* DIAGNOSTICS_H_ */
@@ -9,6 +9,8 @@
  */
 
 #include "Dof.h"
+#include "Parallel.h"
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <boost/bimap/list_of.hpp>
 #include <boost/assign.hpp>
@@ -268,76 +270,345 @@ ostream &operator<<(ostream &out, const DOFS& dofs) {
 	return out;
 }
 
-DOFMatrix::DOFMatrix(bool symmetric) : symmetric(symmetric) {
+DOFBlock::DOFBlock(const double* values, uint64_t mask, bool symmetric) :
+		values(values), mask(mask), symmetric(symmetric) {
+}
 
+int DOFBlock::indexOf(const DOF dof1, const DOF dof2) const {
+	if (symmetric && dof1.position > dof2.position) {
+		return dof2.position * SIZE + dof1.position;
+	}
+	return dof1.position * SIZE + dof2.position;
 }
 
-void DOFMatrix::addComponent(const DOF dof1, const DOF dof2, const double value) {
-	if (symmetric && dof1 > dof2) {
-		componentByDofs[make_pair(dof2, dof1)] = value;
-	} else {
-		componentByDofs[make_pair(dof1, dof2)] = value;
+double DOFBlock::findComponent(const DOF dof1, const DOF dof2) const {
+	const int index = indexOf(dof1, dof2);
+	if ((mask >> index) & 1) {
+		return values[index];
 	}
+	return 0;
 }
 
-double DOFMatrix::findComponent(const DOF dof1, const DOF dof2) const {
-	if (symmetric && dof1 > dof2) {
-		auto it = componentByDofs.find(make_pair(dof2, dof1));
-		if (it != componentByDofs.end()) {
-			return it->second;
+bool DOFBlock::hasComponent(const DOF dof1, const DOF dof2) const {
+	return (mask >> indexOf(dof1, dof2)) & 1;
+}
+
+bool DOFBlock::hasTranslations() const {
+	for (int index = 0; index < SIZE * SIZE; index++) {
+		if (((mask >> index) & 1) && (index / SIZE < 3 || index % SIZE < 3)) {
+			return true;
 		}
+	}
+	return false;
+}
+
+bool DOFBlock::hasRotations() const {
+	for (int index = 0; index < SIZE * SIZE; index++) {
+		if (((mask >> index) & 1) && (index / SIZE >= 3 || index % SIZE >= 3)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool DOFBlock::isEmpty() const {
+	return mask == 0;
+}
+
+DOFBlock::iterator::iterator(const DOFBlock* block, int index) :
+		block(block), index(index) {
+	next_set_component();
+}
+
+void DOFBlock::iterator::next_set_component() {
+	while (index < SIZE * SIZE && !((block->mask >> index) & 1)) {
+		index++;
+	}
+}
+
+const pair<pair<DOF, DOF>, double> DOFBlock::iterator::operator*() const {
+	return make_pair(make_pair(DOF::findByPosition(index / SIZE), DOF::findByPosition(index % SIZE)),
+			block->values[index]);
+}
+
+DOFBlock::iterator& DOFBlock::iterator::operator++() {
+	index++;
+	next_set_component();
+	return *this;
+}
+
+DOFBlock::iterator DOFBlock::begin() const {
+	return DOFBlock::iterator(this, 0);
+}
+
+DOFBlock::iterator DOFBlock::end() const {
+	return DOFBlock::iterator(this, SIZE * SIZE);
+}
+
+DOFBlockMatrix::DOFBlockMatrix(bool symmetric) :
+		symmetric(symmetric) {
+}
+
+const DOFBlockMatrix::NodeEntry* DOFBlockMatrix::findEntry(int nodePosition) const {
+	if (nodePosition < 0 || static_cast<size_t>(nodePosition) >= entryByNodePosition.size()) {
+		return nullptr;
+	}
+	const NodeEntry& entry = entryByNodePosition[static_cast<size_t>(nodePosition)];
+	if (entry.blockByColumn.empty() && entry.rows.empty()) {
+		return nullptr;
+	}
+	return &entry;
+}
+
+DOFBlockMatrix::NodeEntry& DOFBlockMatrix::reserveEntry(int nodePosition) {
+	const size_t index = static_cast<size_t>(nodePosition);
+	if (index >= entryByNodePosition.size()) {
+		entryByNodePosition.resize(index + 1);
+	}
+	return entryByNodePosition[index];
+}
+
+size_t DOFBlockMatrix::findBlockIndex(int rowNodePosition, int colNodePosition) const {
+	const NodeEntry* entry = findEntry(rowNodePosition);
+	if (entry == nullptr) {
+		return NO_BLOCK;
+	}
+	const auto& blockByColumn = entry->blockByColumn;
+	auto it = lower_bound(blockByColumn.begin(), blockByColumn.end(),
+			make_pair(colNodePosition, size_t(0)));
+	if (it == blockByColumn.end() || it->first != colNodePosition) {
+		return NO_BLOCK;
+	}
+	return it->second;
+}
+
+void DOFBlockMatrix::addComponent(int nodePosition1, const DOF dof1, int nodePosition2,
+		const DOF dof2, const double value) {
+	int rowPosition = dof1.position;
+	int colPosition = dof2.position;
+	if (nodePosition1 > nodePosition2) {
+		swap(nodePosition1, nodePosition2);
+		swap(rowPosition, colPosition);
+	}
+	if (symmetric && nodePosition1 == nodePosition2 && rowPosition > colPosition) {
+		swap(rowPosition, colPosition);
+	}
+	// reserved first: growing the index would invalidate the row entry
+	NodeEntry& colEntry = reserveEntry(nodePosition2);
+	NodeEntry& rowEntry = reserveEntry(nodePosition1);
+	auto& blockByColumn = rowEntry.blockByColumn;
+	auto it = lower_bound(blockByColumn.begin(), blockByColumn.end(),
+			make_pair(nodePosition2, size_t(0)));
+	size_t blockIndex;
+	if (it != blockByColumn.end() && it->first == nodePosition2) {
+		blockIndex = it->second;
 	} else {
-		auto it = componentByDofs.find(make_pair(dof1, dof2));
-		if (it != componentByDofs.end()) {
-			return it->second;
+		blockIndex = masks.size();
+		blockByColumn.insert(it, make_pair(nodePosition2, blockIndex));
+		masks.push_back(0);
+		values.resize(values.size() + DOFBlock::SIZE * DOFBlock::SIZE, 0.0);
+		if (nodePosition1 != nodePosition2) {
+			colEntry.rows.push_back(nodePosition1);
 		}
 	}
-	return 0;
+	const int index = rowPosition * DOFBlock::SIZE + colPosition;
+	values[blockIndex * DOFBlock::SIZE * DOFBlock::SIZE + static_cast<size_t>(index)] = value;
+	masks[blockIndex] |= uint64_t(1) << index;
+	rowEntry.dofs += DOF::findByPosition(rowPosition);
+	colEntry.dofs += DOF::findByPosition(colPosition);
 }
 
-bool DOFMatrix::hasRotations() const {
-	bool hasRotations = false;
-	for (auto& kv : componentByDofs) {
-		DOF dof1 = kv.first.first;
-		DOF dof2 = kv.first.second;
-		if (dof1.isRotation or dof2.isRotation) {
-			hasRotations = true;
-			break;
+DOFBlock DOFBlockMatrix::findBlock(int rowNodePosition, int colNodePosition) const {
+	const size_t blockIndex = findBlockIndex(rowNodePosition, colNodePosition);
+	if (blockIndex == NO_BLOCK) {
+		return DOFBlock();
+	}
+	return DOFBlock(&values[blockIndex * DOFBlock::SIZE * DOFBlock::SIZE], masks[blockIndex],
+			symmetric && rowNodePosition == colNodePosition);
+}
+
+NodeSet DOFBlockMatrix::nodePositions() const {
+	vector<int> positions;
+	for (size_t position = 0; position < entryByNodePosition.size(); position++) {
+		if (findEntry(static_cast<int>(position)) != nullptr) {
+			positions.push_back(static_cast<int>(position));
 		}
 	}
-	return hasRotations;
+	return NodeSet(positions.begin(), positions.end());
 }
 
-bool DOFMatrix::hasTranslations() const {
-	bool hasTranslations = false;
-	for (auto& kv : componentByDofs) {
-		DOF dof1 = kv.first.first;
-		DOF dof2 = kv.first.second;
-		if (dof1.isTranslation or dof2.isTranslation) {
-			hasTranslations = true;
-			break;
+set<pair<int, int>> DOFBlockMatrix::nodePairs() const {
+	set<pair<int, int>> result;
+	for (size_t position = 0; position < entryByNodePosition.size(); position++) {
+		for (const auto& columnAndBlock : entryByNodePosition[position].blockByColumn) {
+			result.insert(make_pair(static_cast<int>(position), columnAndBlock.first));
 		}
 	}
-	return hasTranslations;
+	return result;
 }
 
-bool DOFMatrix::isDiagonal() const {
-	bool isDiagonal = true;
-	for (auto& kv : componentByDofs) {
-		if (kv.first.first != kv.first.second and !is_equal(kv.second, 0)) {
-			isDiagonal = false;
-			break;
+set<pair<int, int>> DOFBlockMatrix::findInPairs(int nodePosition) const {
+	set<pair<int, int>> result;
+	const NodeEntry* entry = findEntry(nodePosition);
+	if (entry == nullptr) {
+		return result;
+	}
+	for (const auto& columnAndBlock : entry->blockByColumn) {
+		if (columnAndBlock.first != nodePosition) {
+			result.insert(make_pair(nodePosition, columnAndBlock.first));
+		}
+	}
+	for (int row : entry->rows) {
+		result.insert(make_pair(row, nodePosition));
+	}
+	return result;
+}
+
+DOFS DOFBlockMatrix::getDOFSForNode(int nodePosition) const {
+	const NodeEntry* entry = findEntry(nodePosition);
+	if (entry == nullptr) {
+		return DOFS::NO_DOFS;
+	}
+	return entry->dofs;
+}
+
+size_t DOFBlockMatrix::countBlocks() const {
+	return masks.size();
+}
+
+void DOFBlockMatrix::clear() {
+	values.clear();
+	masks.clear();
+	entryByNodePosition.clear();
+}
+
+const size_t DOFMasks::MIN_POSITIONS_BY_WORKER;
+
+DOFMasks::DOFMasks(size_t size) :
+		masks(size, 0) {
+}
+
+void DOFMasks::resize(size_t size) {
+	densify();
+	masks.resize(size, 0);
+}
+
+DOFS DOFMasks::findSparse(int nodePosition) const {
+	auto it = lower_bound(sparseMasks.begin(), sparseMasks.end(), nodePosition,
+			[](const pair<int, uint8_t>& positionAndMask, int position) {
+				return positionAndMask.first < position;
+			});
+	if (it == sparseMasks.end() || it->first != nodePosition) {
+		return DOFS::NO_DOFS;
+	}
+	return DOFS(static_cast<char>(it->second));
+}
+
+void DOFMasks::densify() {
+	if (!sparse) {
+		return;
+	}
+	masks.assign(sparseSize, 0);
+	for (const auto& positionAndMask : sparseMasks) {
+		masks[static_cast<size_t>(positionAndMask.first)] = positionAndMask.second;
+	}
+	sparseMasks.clear();
+	sparseMasks.shrink_to_fit();
+	sparse = false;
+}
+
+void DOFMasks::compact() {
+	if (sparse) {
+		return;
+	}
+	const size_t used = static_cast<size_t>(count_if(masks.begin(), masks.end(),
+			[](uint8_t mask) {return mask != 0;}));
+	if (used * sizeof(pair<int, uint8_t>) >= masks.size()) {
+		return;
+	}
+	sparseMasks.reserve(used);
+	for (size_t position = 0; position < masks.size(); position++) {
+		if (masks[position] != 0) {
+			sparseMasks.push_back(make_pair(static_cast<int>(position), masks[position]));
 		}
 	}
-	return isDiagonal;
+	sparseSize = masks.size();
+	masks.clear();
+	masks.shrink_to_fit();
+	sparse = true;
 }
 
-bool DOFMatrix::isSymmetric() const {
-	return symmetric;
+void DOFMasks::allow(int nodePosition, const DOFS dofs) {
+	densify();
+	const size_t position = static_cast<size_t>(nodePosition);
+	if (position >= masks.size()) {
+		masks.resize(position + 1, 0);
+	}
+	masks[position] = static_cast<uint8_t>(masks[position] | static_cast<uint8_t>(dofs));
+}
+
+void DOFMasks::allowAll(const vector<NodeSet>& nodeSets,
+		const function<DOFS(size_t, int)>& dofsForNode) {
+	densify();
+	size_t requiredSize = masks.size();
+	for (const NodeSet& nodeSet : nodeSets) {
+		if (!nodeSet.empty()) {
+			requiredSize = max(requiredSize, static_cast<size_t>(*(nodeSet.end() - 1)) + 1);
+		}
+	}
+	masks.resize(requiredSize, 0);
+	// every worker owns a range of positions: the sets are sorted, so it only walks the part
+	// of each set falling into its range
+	parallelFor(masks.size(), [this, &nodeSets, &dofsForNode](size_t begin, size_t end) {
+		for (size_t i = 0; i < nodeSets.size(); i++) {
+			const NodeSet& nodeSet = nodeSets[i];
+			for (auto it = lower_bound(nodeSet.begin(), nodeSet.end(), static_cast<int>(begin));
+					it != nodeSet.end() && static_cast<size_t>(*it) < end; ++it) {
+				uint8_t& mask = masks[static_cast<size_t>(*it)];
+				mask = static_cast<uint8_t>(mask | static_cast<uint8_t>(dofsForNode(i, *it)));
+			}
+		}
+	}, MIN_POSITIONS_BY_WORKER);
+}
+
+void DOFMasks::allowAll(const DOFMasks& other) {
+	densify();
+	if (other.size() > masks.size()) {
+		masks.resize(other.size(), 0);
+	}
+	if (other.sparse) {
+		for (const auto& positionAndMask : other.sparseMasks) {
+			uint8_t& mask = masks[static_cast<size_t>(positionAndMask.first)];
+			mask = static_cast<uint8_t>(mask | positionAndMask.second);
+		}
+		return;
+	}
+	for (size_t position = 0; position < other.masks.size(); position++) {
+		masks[position] = static_cast<uint8_t>(masks[position] | other.masks[position]);
+	}
+}
+
+NodeSet DOFMasks::nodePositions() const {
+	NodeSet result;
+	if (sparse) {
+		for (const auto& positionAndMask : sparseMasks) {
+			result.insert(positionAndMask.first);
+		}
+		return result;
+	}
+	for (size_t position = 0; position < masks.size(); position++) {
+		if (masks[position] != 0) {
+			result.insert(static_cast<int>(position));
+		}
+	}
+	return result;
 }
 
-bool DOFMatrix::isEmpty() const {
-	return componentByDofs.empty();
+void DOFMasks::clear() {
+	masks.clear();
+	sparseMasks.clear();
+	sparse = false;
+	sparseSize = 0;
 }
 
 }
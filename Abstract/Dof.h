@@ -12,10 +12,15 @@
 #define DOF_H_
 
 #include <cfloat>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include "NodeSet.h"
 #include "Utility.h"
 #include <boost/bimap.hpp>
 #include <unordered_map>
 #include <set>
+#include <vector>
 
 namespace vega {
 
@@ -148,21 +153,164 @@ DOFS operator-(const DOFS lhs, const DOF& rhs);
 std::ostream &operator<<(std::ostream &out, const DOFS& dofs);
 std::ostream &operator<<(std::ostream &out, const DOFS::iterator& dofs_iter);
 
-/* Sparse matrix between two dofs (of the same node), or the same dof with itself.*/
-class DOFMatrix final {
+/**
+ * Read only view on a dense 6x6 block of a DOFBlockMatrix, valid until the next
+ * modification of the matrix. Iterating it yields the components that have been set,
+ * as ((dof1, dof2), value), row by row.
+ *
+ * Only the upper half of a symmetric block is stored: a component below the diagonal is
+ * found transposed.
+ */
+class DOFBlock final {
+public:
+	static const int SIZE = 6;
 private:
-		bool symmetric;
+	const double* values;
+	uint64_t mask;
+	bool symmetric;
+	int indexOf(const DOF dof1, const DOF dof2) const;
 public:
-		std::unordered_map<std::pair<DOF, DOF>, double,
-				boost::hash<std::pair<int, int>>>componentByDofs;
-		DOFMatrix(bool it2 = false);
-		void addComponent(const DOF dof1, const DOF dof2, const double value);
-		double findComponent(const DOF dof1, const DOF dof2) const;
-		bool hasTranslations() const;
-		bool hasRotations() const;
-		bool isDiagonal() const;
-		bool isSymmetric() const;
-		bool isEmpty() const;
+	DOFBlock(const double* values = nullptr, uint64_t mask = 0, bool symmetric = false);
+	double findComponent(const DOF dof1, const DOF dof2) const;
+	bool hasComponent(const DOF dof1, const DOF dof2) const;
+	bool hasTranslations() const;
+	bool hasRotations() const;
+	bool isEmpty() const;
+
+	class iterator: public std::iterator<std::input_iterator_tag,
+			std::pair<std::pair<DOF, DOF>, double>, ptrdiff_t> {
+	private:
+		const DOFBlock* block;
+		int index;
+		void next_set_component();
+	public:
+		iterator(const DOFBlock* block, int index);
+		bool operator==(const iterator& x) const {
+			return index == x.index;
+		}
+		bool operator!=(const iterator& x) const {
+			return !(*this == x);
+		}
+		const std::pair<std::pair<DOF, DOF>, double> operator*() const;
+		iterator& operator++();
+	};
+	iterator begin() const;
+	iterator end() const;
+};
+
+/**
+ * Sparse matrix between the DOFs of nodes, stored as dense 6x6 blocks, one for each pair
+ * of node positions (block rows and columns). Only the upper blocks (row <= column) are kept:
+ * a component below is stored transposed. The blocks are contiguous, and found through a row
+ * index: an array by node position, which also holds the DOFs used by each node. Positions
+ * without any block have an empty entry.
+ */
+class DOFBlockMatrix final {
+private:
+	struct NodeEntry {
+		// column node position and block index, sorted by column
+		std::vector<std::pair<int, size_t>> blockByColumn;
+		// node positions of the rows having a block in this column, diagonal excluded
+		std::vector<int> rows;
+		DOFS dofs;
+	};
+	bool symmetric;
+	std::vector<double> values;
+	std::vector<uint64_t> masks;
+	std::vector<NodeEntry> entryByNodePosition;
+	/**
+	 * Entry of the node, nullptr if it has no block.
+	 */
+	const NodeEntry* findEntry(int nodePosition) const;
+	/**
+	 * Entry of the node, the index grows to hold it.
+	 */
+	NodeEntry& reserveEntry(int nodePosition);
+	size_t findBlockIndex(int rowNodePosition, int colNodePosition) const;
+public:
+	static const size_t NO_BLOCK = SIZE_MAX;
+	/**
+	 * @param symmetric: if true, only the upper half of the diagonal blocks is stored.
+	 */
+	DOFBlockMatrix(bool symmetric = false);
+	void addComponent(int nodePosition1, const DOF dof1, int nodePosition2, const DOF dof2,
+			const double value);
+	/**
+	 * Returns a non-copying view on the block of a pair of nodes, empty if there is none.
+	 */
+	DOFBlock findBlock(int rowNodePosition, int colNodePosition) const;
+	NodeSet nodePositions() const;
+	std::set<std::pair<int, int>> nodePairs() const;
+	/**
+	 * Pairs of distinct nodes having a block which involves nodePosition.
+	 */
+	std::set<std::pair<int, int>> findInPairs(int nodePosition) const;
+	/**
+	 * DOFs of the node used by the components of the matrix.
+	 */
+	DOFS getDOFSForNode(int nodePosition) const;
+	size_t countBlocks() const;
+	void clear();
+};
+
+/**
+ * DOFs of every node, as one DOFS code (a bitmask) per node position in a flat array.
+ * Nodes beyond the end of the array have no DOFs.
+ *
+ * After compact(), masks set on few nodes are kept as sorted (position, mask) pairs instead:
+ * lookups are then a binary search, and any modification restores the flat array.
+ */
+class DOFMasks final {
+private:
+	std::vector<uint8_t> masks;
+	std::vector<std::pair<int, uint8_t>> sparseMasks;
+	bool sparse = false;
+	size_t sparseSize = 0;
+	DOFS findSparse(int nodePosition) const;
+	void densify();
+public:
+	/**
+	 * Minimum number of node positions handled by a thread in allowAll().
+	 */
+	static const size_t MIN_POSITIONS_BY_WORKER = 1 << 16;
+	DOFMasks(size_t size = 0);
+	size_t size() const {
+		return sparse ? sparseSize : masks.size();
+	}
+	void resize(size_t size);
+	DOFS find(int nodePosition) const {
+		if (sparse) {
+			return findSparse(nodePosition);
+		}
+		return static_cast<size_t>(nodePosition) < masks.size() ?
+				DOFS(static_cast<char>(masks[static_cast<size_t>(nodePosition)])) : DOFS::NO_DOFS;
+	}
+	/**
+	 * Adds dofs to the mask of the node, growing the array if needed.
+	 */
+	void allow(int nodePosition, const DOFS dofs);
+	/**
+	 * Adds dofsForNode(i, nodePosition) to the mask of every node of nodeSets[i]. The positions
+	 * are split into ranges, processed in parallel: dofsForNode must be thread safe.
+	 */
+	void allowAll(const std::vector<NodeSet>& nodeSets,
+			const std::function<DOFS(size_t, int)>& dofsForNode);
+	/**
+	 * Adds the masks of other to the masks of this.
+	 */
+	void allowAll(const DOFMasks& other);
+	/**
+	 * Positions of the nodes having at least one DOF.
+	 */
+	NodeSet nodePositions() const;
+	/**
+	 * Switches to the sparse storage if it takes less memory than the flat array.
+	 */
+	void compact();
+	bool isSparse() const {
+		return sparse;
+	}
+	void clear();
 };
 
 } /* namespace vega */
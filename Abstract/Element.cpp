@@ -237,6 +237,20 @@ const DOFS Continuum::getDOFSForNode(int nodePosition) const {
 	return DOFS::TRANSLATIONS;
 }
 
+namespace {
+
+/**
+ * The matrices of the discrete elements are between the DOFs of a single node (or of a pair of
+ * nodes of a segment): they are kept as the single block of this node.
+ */
+const int LOCAL_NODE = 0;
+
+DOFBlock localBlock(const DOFBlockMatrix& matrix) {
+	return matrix.findBlock(LOCAL_NODE, LOCAL_NODE);
+}
+
+}
+
 Discrete::Discrete(Model& model, ElementSet::Type type, bool symmetric, int original_id) :
 		ElementSet(model, type, nullptr, original_id), symmetric(symmetric) {
 }
@@ -252,8 +266,7 @@ const DOFS Discrete::getDOFSForNode(int nodePosition) const {
 
 DiscretePoint::DiscretePoint(Model& model, vector<double> coefficients, bool symmetric,
 		int original_id) :
-		Discrete(model, ElementSet::DISCRETE_0D, symmetric, original_id), stiffness(
-				symmetric), mass(symmetric), damping(symmetric) {
+		Discrete(model, ElementSet::DISCRETE_0D, symmetric, original_id) {
 	// LD TODO : remove this vector parameter
 	for (int i = 0; i < 6 && i < static_cast<int>(coefficients.size()); i++) {
 		this->addComponent(DOF::findByPosition(i), coefficients[i]);
@@ -263,9 +276,7 @@ DiscretePoint::DiscretePoint(Model& model, vector<double> coefficients, bool sym
 DiscretePoint::DiscretePoint(Model& model, double x, double y, double z, double rx, double ry,
 		double rz, bool symmetric,
 		int original_id) :
-		Discrete(model, ElementSet::DISCRETE_0D, symmetric, original_id), stiffness(
-				symmetric), mass(
-				symmetric), damping(symmetric) {
+		Discrete(model, ElementSet::DISCRETE_0D, symmetric, original_id) {
 	// LD TODO : remove this method
 	if (!is_equal(x, NOT_BOUNDED)) {
 		this->addComponent(DOF::DX, x);
@@ -293,7 +304,7 @@ shared_ptr<ElementSet> DiscretePoint::clone() const {
 
 void DiscretePoint::addComponent(DOF code, double value) {
 	// LD TODO : remove this ambigous method, replace with this line
-	stiffness.addComponent(code, code, value);
+	stiffness.addComponent(LOCAL_NODE, code, LOCAL_NODE, code, value);
 }
 
 vector<double> DiscretePoint::asVector(bool addRotationsIfNotPresent) {
@@ -302,59 +313,35 @@ vector<double> DiscretePoint::asVector(bool addRotationsIfNotPresent) {
 	int ncomp = (addRotationsIfNotPresent || hasRotations()) ? 6 : 3;
 	for (int i = 0; i < ncomp; i++) {
 		DOF code = DOF::findByPosition(i);
-		auto codeIter = this->stiffness.componentByDofs.find(make_pair(code, code));
-		double value;
-		if (codeIter != this->stiffness.componentByDofs.end()) {
-			value = codeIter->second;
-		} else {
-			value = 0;
-		}
-		result.push_back(value);
+		result.push_back(localBlock(stiffness).findComponent(code, code));
 	}
 	return result;
 }
 
 bool DiscretePoint::hasTranslations() const {
-	return stiffness.hasTranslations() or mass.hasTranslations() or damping.hasTranslations();
+	return localBlock(stiffness).hasTranslations() or localBlock(mass).hasTranslations()
+			or localBlock(damping).hasTranslations();
 }
 
 bool DiscretePoint::hasRotations() const {
-	return stiffness.hasRotations() or mass.hasRotations() or damping.hasRotations();
+	return localBlock(stiffness).hasRotations() or localBlock(mass).hasRotations()
+			or localBlock(damping).hasRotations();
 }
 
 double DiscretePoint::findStiffness(DOF rowdof, DOF coldof) const {
-	double result;
-	auto codeIter = stiffness.componentByDofs.find(make_pair(rowdof, coldof));
-	if (codeIter != stiffness.componentByDofs.end()) {
-		result = codeIter->second;
-	} else {
-		if (symmetric) {
-			codeIter = stiffness.componentByDofs.find(make_pair(coldof, rowdof));
-			if (codeIter != stiffness.componentByDofs.end()) {
-				result = codeIter->second;
-			} else {
-				result = 0.0;
-			}
-		} else {
-			result = 0.0;
-		}
+	const DOFBlock block = localBlock(stiffness);
+	if (!block.hasComponent(rowdof, coldof) && symmetric) {
+		return block.findComponent(coldof, rowdof);
 	}
-	return result;
+	return block.findComponent(rowdof, coldof);
 }
 
 void DiscretePoint::addStiffness(DOF rowdof, DOF coldof, double value) {
-	this->stiffness.componentByDofs[make_pair(rowdof, coldof)] = value;
+	this->stiffness.addComponent(LOCAL_NODE, rowdof, LOCAL_NODE, coldof, value);
 }
 
 DiscreteSegment::DiscreteSegment(Model& model, bool symmetric, int original_id) :
 		Discrete(model, ElementSet::DISCRETE_1D, symmetric, original_id) {
-	for (int i = 0; i < 2; i++){
-		for (int j = 0; j < 2; j++){
-			stiffness[i][j] = symmetric;
-			mass[i][j] = symmetric;
-			damping[i][j] = symmetric;
-		}
-	}
 }
 
 shared_ptr<ElementSet> DiscreteSegment::clone() const {
@@ -365,8 +352,8 @@ bool DiscreteSegment::hasTranslations() const {
 	bool hasTranslations = false;
 	for (int i = 0; i < 2; ++i) {
 		for (int j = 0; i < 2; ++i) {
-			if (stiffness[i][j].hasTranslations() or mass[i][j].hasTranslations()
-					or damping[i][j].hasTranslations()) {
+			if (localBlock(stiffness[i][j]).hasTranslations() or localBlock(mass[i][j]).hasTranslations()
+					or localBlock(damping[i][j]).hasTranslations()) {
 				hasTranslations = true;
 				break;
 			}
@@ -379,8 +366,8 @@ bool DiscreteSegment::hasRotations() const {
 	bool hasRotations = false;
 	for (int i = 0; i < 2; ++i) {
 		for (int j = 0; i < 2; ++i) {
-			if (stiffness[i][j].hasRotations() or mass[i][j].hasRotations()
-					or damping[i][j].hasRotations()) {
+			if (localBlock(stiffness[i][j]).hasRotations() or localBlock(mass[i][j]).hasRotations()
+					or localBlock(damping[i][j]).hasRotations()) {
 				hasRotations = true;
 				break;
 			}
@@ -390,30 +377,15 @@ bool DiscreteSegment::hasRotations() const {
 }
 
 double DiscreteSegment::findStiffness(int rowindex, int colindex, DOF rowdof, DOF coldof) const {
-	double result;
-	const DOFMatrix* matrix = &stiffness[rowindex][colindex];
-	auto codeIter = matrix->componentByDofs.find(make_pair(rowdof, coldof));
-	if (codeIter != matrix->componentByDofs.end()) {
-		result = codeIter->second;
-	} else {
-		if (symmetric) {
-			matrix = &stiffness[colindex][rowindex];
-			codeIter = matrix->componentByDofs.find(make_pair(coldof, rowdof));
-			if (codeIter != matrix->componentByDofs.end()) {
-				result = codeIter->second;
-			} else {
-				result = 0.0;
-			}
-		} else {
-			result = 0.0;
-		}
+	const DOFBlock block = localBlock(stiffness[rowindex][colindex]);
+	if (!block.hasComponent(rowdof, coldof) && symmetric) {
+		return localBlock(stiffness[colindex][rowindex]).findComponent(coldof, rowdof);
 	}
-	return result;
+	return block.findComponent(rowdof, coldof);
 }
 
 void DiscreteSegment::addStiffness(int rowindex, int colindex, DOF rowdof, DOF coldof, double value) {
-	DOFMatrix* matrix = &stiffness[rowindex][colindex];
-	matrix->componentByDofs[make_pair(rowdof, coldof)] = value;
+	stiffness[rowindex][colindex].addComponent(LOCAL_NODE, rowdof, LOCAL_NODE, coldof, value);
 }
 
 vector<double> DiscreteSegment::asVector(bool addRotationsIfNotPresent) {
@@ -445,55 +417,46 @@ vector<double> DiscreteSegment::asVector(bool addRotationsIfNotPresent) {
 
 StructuralSegment::StructuralSegment(Model& model, bool symmetric, int original_id) :
 				Discrete(model, ElementSet::STRUCTURAL_SEGMENT, symmetric, original_id) {
-	this->stiffness = symmetric;
-	this->mass = symmetric;
-	this->damping = symmetric;
 }
 
 bool StructuralSegment::hasTranslations() const {
-	return (stiffness.hasTranslations() or mass.hasTranslations() or damping.hasTranslations());
+	return (localBlock(stiffness).hasTranslations() or localBlock(mass).hasTranslations()
+			or localBlock(damping).hasTranslations());
 }
 
 bool StructuralSegment::hasRotations() const {
-	return (stiffness.hasRotations() or mass.hasRotations() or damping.hasRotations());
+	return (localBlock(stiffness).hasRotations() or localBlock(mass).hasRotations()
+			or localBlock(damping).hasRotations());
 }
 
 bool StructuralSegment::hasStiffness() const {
-	return !(stiffness.isEmpty());
+	return !(localBlock(stiffness).isEmpty());
 }
 
 bool StructuralSegment::hasMass() const {
-	return !(mass.isEmpty());
+	return !(localBlock(mass).isEmpty());
 }
 
 bool StructuralSegment::hasDamping() const {
-	return !(damping.isEmpty());
+	return !(localBlock(damping).isEmpty());
 }
 
 void StructuralSegment::addStiffness(DOF rowdof, DOF coldof, double value){
-	stiffness.componentByDofs[make_pair(rowdof, coldof)] = value;
+	stiffness.addComponent(LOCAL_NODE, rowdof, LOCAL_NODE, coldof, value);
 }
 void StructuralSegment::addMass(DOF rowdof, DOF coldof, double value){
-	mass.componentByDofs[make_pair(rowdof, coldof)] = value;
+	mass.addComponent(LOCAL_NODE, rowdof, LOCAL_NODE, coldof, value);
 }
 void StructuralSegment::addDamping(DOF rowdof, DOF coldof, double value){
-	damping.componentByDofs[make_pair(rowdof, coldof)] = value;
+	damping.addComponent(LOCAL_NODE, rowdof, LOCAL_NODE, coldof, value);
 }
 
 double StructuralSegment::findStiffness(DOF rowdof, DOF coldof) const{
-	double result=0.0;
-	auto itFind = stiffness.componentByDofs.find(make_pair(rowdof, coldof));
-	if (itFind != stiffness.componentByDofs.end()) {
-		result = itFind->second;
-	}else{
-		if (symmetric){
-			itFind = stiffness.componentByDofs.find(make_pair(coldof, rowdof));
-			if (itFind != stiffness.componentByDofs.end()) {
-				result = itFind->second;
-			}
-		}
+	const DOFBlock block = localBlock(stiffness);
+	if (!block.hasComponent(rowdof, coldof) && symmetric) {
+		return block.findComponent(coldof, rowdof);
 	}
-	return result;
+	return block.findComponent(rowdof, coldof);
 }
 
 std::shared_ptr<ElementSet> StructuralSegment::clone() const{
@@ -607,92 +570,55 @@ double ISectionBeam::getShearAreaFactorZ() const {
 }
 
 MatrixElement::MatrixElement(Model& model, Type type, bool symmetric, int original_id) :
-		ElementSet(model, type, modelType, original_id), symmetric(symmetric) {
+		ElementSet(model, type, modelType, original_id), symmetric(symmetric), blockMatrix(symmetric) {
 }
 
 void MatrixElement::addComponent(const int nodeid1, const DOF dof1, const int nodeid2, const DOF dof2, const double value) {
 	int nodePosition1 = model.mesh->findOrReserveNode(nodeid1);
-	int nodePosition2 = model.mesh->findOrReserveNode(nodeid2);
-	DOF myDof1 = dof1;
-	DOF myDof2 = dof2;
-
-	if (nodePosition1 > nodePosition2) {
-		int swap = nodePosition2;
-		nodePosition2 = nodePosition1;
-		nodePosition1 = swap;
-		myDof1 = dof2;
-		myDof2 = dof1;
-	}
-	auto it = submatrixByNodes.find(make_pair(nodePosition1, nodePosition2));
-	shared_ptr<DOFMatrix> subMatrix = nullptr;
-	if (it != submatrixByNodes.end()) {
-		subMatrix = it->second;
-	} else {
-		subMatrix = make_shared<DOFMatrix>(DOFMatrix(symmetric && nodeid1 == nodeid2));
-		this->submatrixByNodes[make_pair(nodePosition1, nodePosition2)] = subMatrix;
-	}
-    subMatrix->addComponent(myDof1, myDof2, value);
+	int nodePosition2 = nodeid2 == nodeid1 ? nodePosition1 : model.mesh->findOrReserveNode(nodeid2);
+	blockMatrix.addComponent(nodePosition1, dof1, nodePosition2, dof2, value);
 }
 
-void MatrixElement::clear() {
-    submatrixByNodes.clear();
+void MatrixElement::addComponentByPosition(const int nodePosition1, const DOF dof1,
+		const int nodePosition2, const DOF dof2, const double value) {
+	blockMatrix.addComponent(nodePosition1, dof1, nodePosition2, dof2, value);
 }
 
+int MatrixElement::findOrReserveNode(const int nodeId) const {
+	return model.mesh->findOrReserveNode(nodeId);
+}
 
-const shared_ptr<DOFMatrix> MatrixElement::findSubmatrix(const int nodePosition1, const int nodePosition2) const {
-	shared_ptr<DOFMatrix> result = make_shared<DOFMatrix>(DOFMatrix(symmetric));
-	auto it = submatrixByNodes.find(make_pair(nodePosition1, nodePosition2));
-	if (it != submatrixByNodes.end()) {
-		std::copy(it->second->componentByDofs.begin(), it->second->componentByDofs.end(),
-				std::inserter(result->componentByDofs, result->componentByDofs.end()));
-	}
-	return result;
+void MatrixElement::clear() {
+	blockMatrix.clear();
 }
 
-const set<int> MatrixElement::nodePositions() const {
-	set<int> result;
-	for (auto& kv : submatrixByNodes) {
-		result.insert(kv.first.first);
-		result.insert(kv.first.second);
-	}
-	return result;
+const DOFBlock MatrixElement::findSubmatrix(const int nodePosition1, const int nodePosition2) const {
+	return blockMatrix.findBlock(nodePosition1, nodePosition2);
+}
+
+const NodeSet MatrixElement::nodePositions() const {
+	return blockMatrix.nodePositions();
 }
 
 const DOFS MatrixElement::getDOFSForNode(int nodePosition) const {
-	DOFS dofs;
-	for (auto& kv : submatrixByNodes) {
-		if (kv.first.first == nodePosition or kv.first.second) {
-			if (kv.second->hasRotations()) {
-				dofs += DOFS::ROTATIONS;
-			}
-			if (kv.second->hasTranslations()) {
-				dofs += DOFS::TRANSLATIONS;
-			}
-		}
+	// whole translations or rotations, as the discrete elements written for the matrix
+	const DOFS dofs = blockMatrix.getDOFSForNode(nodePosition);
+	DOFS result;
+	if (dofs.containsAnyOf(DOFS::TRANSLATIONS)) {
+		result += DOFS::TRANSLATIONS;
+	}
+	if (dofs.containsAnyOf(DOFS::ROTATIONS)) {
+		result += DOFS::ROTATIONS;
 	}
-	return dofs;
+	return result;
 }
 
 const set<pair<int, int>> MatrixElement::nodePairs() const {
-	set<pair<int, int>> result;
-	for (auto& kv : submatrixByNodes) {
-		result.insert(make_pair(kv.first.first, kv.first.second));
-	}
-	return result;
+	return blockMatrix.nodePairs();
 }
 
 const std::set<std::pair<int, int>> MatrixElement::findInPairs(int nodePosition) const {
-	set<pair<int, int>> result;
-	for (auto& kv : submatrixByNodes) {
-		if (kv.first.first != nodePosition and kv.first.second != nodePosition) {
-			continue;
-		}
-		if (kv.first.first == kv.first.second) {
-			continue;
-		}
-		result.insert(make_pair(kv.first.first, kv.first.second));
-	}
-	return result;
+	return blockMatrix.findInPairs(nodePosition);
 }
 
 StiffnessMatrix::StiffnessMatrix(Model& model, int original_id) :
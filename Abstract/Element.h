@@ -86,7 +86,7 @@ public:
 	const ModelType getModelType() const;
 	virtual bool validate() const override;
 	virtual std::shared_ptr<ElementSet> clone() const = 0;
-	virtual const std::set<int> nodePositions() const {
+	virtual const NodeSet nodePositions() const {
 		return cellGroup->nodePositions();
 	}
 	virtual const DOFS getDOFSForNode(int nodePosition) const = 0;
@@ -284,9 +284,12 @@ public:
 
 class DiscretePoint final: public Discrete {
 private:
-	DOFMatrix stiffness;
-	DOFMatrix mass;
-	DOFMatrix damping;
+	/**
+	 * Matrices between the DOFs of the node, as the block of a single node.
+	 */
+	DOFBlockMatrix stiffness;
+	DOFBlockMatrix mass;
+	DOFBlockMatrix damping;
 public:
 	DiscretePoint(Model&, double x, double y, double z, double rx = NOT_BOUNDED, double ry =
 			NOT_BOUNDED, double rz = NOT_BOUNDED, bool symmetric = true, int original_id = NO_ORIGINAL_ID);
@@ -303,9 +306,9 @@ public:
 
 class DiscreteSegment final : public Discrete {
 private:
-	DOFMatrix stiffness[2][2];
-	DOFMatrix mass[2][2];
-	DOFMatrix damping[2][2];
+	DOFBlockMatrix stiffness[2][2];
+	DOFBlockMatrix mass[2][2];
+	DOFBlockMatrix damping[2][2];
 public:
 	DiscreteSegment(Model&, bool symmetric = true, int original_id = NO_ORIGINAL_ID);
 	bool hasTranslations() const override;
@@ -322,9 +325,9 @@ public:
  *  It may overlapped some functionnalities of DiscreteSegment.*/
 class StructuralSegment final : public Discrete {
 private:
-	DOFMatrix stiffness;
-	DOFMatrix mass;
-	DOFMatrix damping;
+	DOFBlockMatrix stiffness;
+	DOFBlockMatrix mass;
+	DOFBlockMatrix damping;
 public:
 	StructuralSegment(Model&, bool symmetric = true, int original_id = NO_ORIGINAL_ID);
 	bool hasTranslations() const override;
@@ -378,17 +381,29 @@ class NodalMass: public ElementSet {
 /* Matrix for a group nodes.*/
 class MatrixElement : public ElementSet {
 private:
-	std::map<std::pair<int, int>, shared_ptr<DOFMatrix>> submatrixByNodes;
 	bool symmetric = false;
+	DOFBlockMatrix blockMatrix;
 public:
 	MatrixElement(Model&, Type type, bool symmetric = false, int original_id = NO_ORIGINAL_ID);
 	void addComponent(const int nodeid1, const DOF dof1, const int nodeid2, const DOF dof2, const double value);
+	/**
+	 * Same as addComponent(), between nodes already found with findOrReserveNode().
+	 */
+	void addComponentByPosition(const int nodePosition1, const DOF dof1, const int nodePosition2,
+			const DOF dof2, const double value);
+	/**
+	 * Position in the mesh of a node of the matrix, reserved if it isn't defined yet.
+	 */
+	int findOrReserveNode(const int nodeId) const;
 	/**
 	 * Clear all nodes and submatrices of the Matrix.
 	 */
 	void clear();
-	const shared_ptr<DOFMatrix> findSubmatrix(const int nodePosition1, const int nodePosition2) const;
-	const std::set<int> nodePositions() const override;
+	/**
+	 * Non-copying view on the submatrix between two nodes, valid until the next addComponent().
+	 */
+	const DOFBlock findSubmatrix(const int nodePosition1, const int nodePosition2) const;
+	const NodeSet nodePositions() const override;
 	const std::set<std::pair<int, int>> nodePairs() const;
 	const std::set<std::pair<int, int>> findInPairs(int nodePosition) const;
 	const DOFS getDOFSForNode(int nodePosition) const override final;
@@ -116,8 +116,8 @@ const DOFS Gravity::getDOFSForNode(int nodePosition) const {
 	UNUSEDV(nodePosition);
 	return DOFS::NO_DOFS;
 }
-set<int> Gravity::nodePositions() const {
-	return set<int>();
+NodeSet Gravity::nodePositions() const {
+	return NodeSet();
 }
 
 const VectorialValue Gravity::getDirection() const {
@@ -163,8 +163,8 @@ const DOFS Rotation::getDOFSForNode(int nodePosition) const {
 	return DOFS::NO_DOFS;
 }
 
-set<int> Rotation::nodePositions() const {
-	return set<int>();
+NodeSet Rotation::nodePositions() const {
+	return NodeSet();
 }
 
 bool Rotation::ineffective() const {
@@ -256,8 +256,7 @@ const VectorialValue NodalForce::localToGlobal(const VectorialValue& vectorialVa
 	}
 	Node node = getNode();
 	node.buildGlobalXYZ(&model);
-	coordSystem->updateLocalBase(VectorialValue(node.x, node.y, node.z));
-	return coordSystem->vectorToGlobal(vectorialValue);
+	return coordSystem->vectorToGlobalAt(VectorialValue(node.x, node.y, node.z), vectorialValue);
 }
 
 Node NodalForce::getNode() const {
@@ -291,8 +290,8 @@ const DOFS NodalForce::getDOFSForNode(int nodePosition) const {
 	return dofs;
 }
 
-set<int> NodalForce::nodePositions() const {
-	return set<int>({node_position});
+NodeSet NodalForce::nodePositions() const {
+	return NodeSet({node_position});
 }
 
 shared_ptr<Loading> NodalForce::clone() const {
@@ -372,7 +371,7 @@ ElementLoading::ElementLoading(const Model& model, Loading::Type type, int origi
 		Loading(model, type, Loading::ELEMENT, original_id, coordinateSystemId), CellContainer(model.mesh) {
 }
 
-set<int> ElementLoading::nodePositions() const {
+NodeSet ElementLoading::nodePositions() const {
 	return CellContainer::nodePositions();
 }
 
@@ -426,9 +425,9 @@ bool ElementLoading::appliedToGeometry() {
 }
 
 ForceSurface::ForceSurface(const Model& model, const VectorialValue& force,
-		const VectorialValue& moment, const int original_id) :
-		ElementLoading(model, Loading::FORCE_SURFACE, original_id,
-				CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID), force(force), moment(moment) {
+		const VectorialValue& moment, const int original_id, int coordinateSystemId) :
+		ElementLoading(model, Loading::FORCE_SURFACE, original_id, coordinateSystemId), force(
+				force), moment(moment) {
 }
 
 const VectorialValue ForceSurface::getForce() const {
@@ -441,8 +440,7 @@ const VectorialValue ForceSurface::getMoment() const {
 
 const DOFS ForceSurface::getDOFSForNode(int nodePosition) const {
 	DOFS dofs(DOFS::NO_DOFS);
-	set<int> nodes = nodePositions();
-	if (nodes.find(nodePosition) != nodes.end()) {
+	if (nodePositions().contains(nodePosition)) {
 		if (!is_zero(force.x()))
 			dofs = dofs + DOF::DX;
 		if (!is_zero(force.y()))
@@ -477,10 +475,12 @@ bool ForceSurface::validate() const {
 }
 
 PressionFaceTwoNodes::PressionFaceTwoNodes(const Model& model, int nodeId1, int nodeId2,
-		const VectorialValue& force, const VectorialValue& moment, const int original_id) :
-		ForceSurface(model, force, moment, original_id), nodePosition1(
+		const VectorialValue& force, const VectorialValue& moment, const int original_id,
+		int coordinateSystemId) :
+		ForceSurface(model, force, moment, original_id, coordinateSystemId), nodePosition1(
 				model.mesh->findOrReserveNode(nodeId1)), nodePosition2(
-				model.mesh->findOrReserveNode(nodeId2)) {
+				nodeId2 == Node::UNAVAILABLE_NODE ?
+						Node::UNAVAILABLE_NODE : model.mesh->findOrReserveNode(nodeId2)) {
 }
 
 vector<int> PressionFaceTwoNodes::getApplicationFace() const {
@@ -489,8 +489,11 @@ vector<int> PressionFaceTwoNodes::getApplicationFace() const {
 		throw logic_error("More than one cell specified for a PressionFaceTwoNodes");
 	}
 	Node node1 = model.mesh->findNode(nodePosition1);
-	Node node2 = model.mesh->findNode(nodePosition2);
-	vector<int> nodeIds = cells[0].faceids_from_two_nodes(node1.id, node2.id);
+	int nodeId2 = Node::UNAVAILABLE_NODE;
+	if (nodePosition2 != Node::UNAVAILABLE_NODE) {
+		nodeId2 = model.mesh->findNode(nodePosition2).id;
+	}
+	vector<int> nodeIds = cells[0].faceids_from_two_nodes(node1.id, nodeId2);
 	return nodeIds;
 }
 
@@ -502,8 +505,7 @@ ForceLine::ForceLine(const Model& model, const VectorialValue& force, const Vect
 
 const DOFS ForceLine::getDOFSForNode(int nodePosition) const {
 	DOFS dofs(DOFS::NO_DOFS);
-	set<int> nodes = nodePositions();
-	if (nodes.find(nodePosition) != nodes.end()) {
+	if (nodePositions().contains(nodePosition)) {
 		if (!is_zero(force.x()))
 			dofs = dofs + DOF::DX;
 		if (!is_zero(force.y()))
@@ -548,8 +550,7 @@ NormalPressionFace::NormalPressionFace(const Model& model, double intensity, con
 
 const DOFS NormalPressionFace::getDOFSForNode(int nodePosition) const {
 	DOFS dofs(DOFS::NO_DOFS);
-	set<int> nodes = nodePositions();
-	if (nodes.find(nodePosition) != nodes.end()) {
+	if (nodePositions().contains(nodePosition)) {
 		dofs += DOFS::ALL_DOFS;
 	}
 	return dofs;
@@ -608,8 +609,8 @@ const ValuePlaceHolder DynamicExcitation::getFunctionTablePPlaceHolder() const {
     return ValuePlaceHolder(model, functionTableP.type, functionTableP.original_id, Value::FREQ);
 }
 
-set<int> DynamicExcitation::nodePositions() const {
-    return set<int>();
+NodeSet DynamicExcitation::nodePositions() const {
+    return NodeSet();
 }
 
 const DOFS DynamicExcitation::getDOFSForNode(int nodePosition) const {
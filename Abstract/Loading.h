@@ -120,7 +120,7 @@ private:
 	Gravity(const Model&, double acceleration, const VectorialValue& direction,
 			const int original_id = NO_ORIGINAL_ID);
 	const DOFS getDOFSForNode(int nodePosition) const override;
-	std::set<int> nodePositions() const override;
+	NodeSet nodePositions() const override;
 	std::shared_ptr<Loading> clone() const override;
 	void scale(double factor) override;
 	bool ineffective() const override;
@@ -144,7 +144,7 @@ protected:
 	 */
 	virtual const VectorialValue getCenter() const = 0;
 	const DOFS getDOFSForNode(int nodePosition) const override;
-	std::set<int> nodePositions() const override;
+	NodeSet nodePositions() const override;
 	bool ineffective() const override;
 };
 
@@ -200,7 +200,7 @@ public:
 	virtual const VectorialValue getForce() const;
 	virtual const VectorialValue getMoment() const;
 	const DOFS getDOFSForNode(int nodePosition) const override;
-	std::set<int> nodePositions() const override;
+	NodeSet nodePositions() const override;
 	std::shared_ptr<Loading> clone() const override;
 	void scale(double factor) override;
 	bool ineffective() const override;
@@ -251,7 +251,7 @@ private:
 	 * Return true if all cells are of the dimension passed as parameter.
 	 */
 	bool cellDimensionGreatherThan(SpaceDimension dimension);
-	std::set<int> nodePositions() const override final;
+	NodeSet nodePositions() const override final;
 	virtual SpaceDimension getLoadingDimension() const = 0;
 	//implement a function that tell if this force is applied to a
 	//geometrical element or to a Poutre.
@@ -269,7 +269,8 @@ protected:
 	VectorialValue moment;
 	public:
 	ForceSurface(const Model&, const VectorialValue& force, const VectorialValue& moment,
-			const int original_id = NO_ORIGINAL_ID);
+			const int original_id = NO_ORIGINAL_ID,
+			int coordinateSystemId = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID);
 	const VectorialValue getForce() const;
 	const VectorialValue getMoment() const;
 	const DOFS getDOFSForNode(int nodePosition) const override;
@@ -295,7 +296,8 @@ public:
 	const int nodePosition2;
 
 	PressionFaceTwoNodes(const Model&, int nodeId1, int nodeId2, const VectorialValue& force,
-			const VectorialValue& moment, const int original_id = NO_ORIGINAL_ID);
+			const VectorialValue& moment, const int original_id = NO_ORIGINAL_ID,
+			int coordinateSystemId = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID);
 	vector<int> getApplicationFace() const;
 	virtual std::shared_ptr<Loading> clone() const override;
 };
@@ -359,7 +361,7 @@ public:
     std::shared_ptr<LoadSet> getLoadSet() const;
     const ValuePlaceHolder getFunctionTableBPlaceHolder() const;
     const ValuePlaceHolder getFunctionTablePPlaceHolder() const;
-    std::set<int> nodePositions() const override;
+    NodeSet nodePositions() const override;
     const DOFS getDOFSForNode(int nodePosition) const override;
     std::shared_ptr<Loading> clone() const override;
     bool validate() const override;
@@ -67,6 +67,17 @@ void Material::addNature(const Nature &nature) {
 	nature_by_type[nature.type] = nature.clone();
 }
 
+vector<double> Material::getPayload() const {
+	vector<double> payload;
+	for (const auto& natureByType : nature_by_type) {
+		const vector<double> naturePayload = natureByType.second->getPayload();
+		payload.push_back(natureByType.first);
+		payload.push_back(static_cast<double>(naturePayload.size()));
+		payload.insert(payload.end(), naturePayload.begin(), naturePayload.end());
+	}
+	return payload;
+}
+
 const shared_ptr<Nature> Material::findNature(const Nature::NatureType natureType) const {
 	shared_ptr<Nature> nature;
 	auto it = nature_by_type.find(natureType);
@@ -118,6 +129,10 @@ shared_ptr<Nature> ElasticNature::clone() const {
 	return shared_ptr<Nature>(new ElasticNature(*this));
 }
 
+vector<double> ElasticNature::getPayload() const {
+	return {e, nu, g, rho, alpha, tref, ge};
+}
+
 ElasticNature::~ElasticNature() {
 
 }
@@ -185,6 +200,11 @@ shared_ptr<Nature> BilinearElasticNature::clone() const {
 	return shared_ptr<Nature>(new BilinearElasticNature(*this));
 }
 
+vector<double> BilinearElasticNature::getPayload() const {
+	return {elastic_limit, secondary_slope, yield_function_von_mises ? 1.0 : 0.0,
+			hardening_rule_isotropic ? 1.0 : 0.0};
+}
+
 BilinearElasticNature::~BilinearElasticNature() {
 
 }
@@ -203,6 +223,16 @@ shared_ptr<Nature> NonLinearElasticNature::clone() const {
 	return shared_ptr<Nature>(new NonLinearElasticNature(*this));
 }
 
+vector<double> NonLinearElasticNature::getPayload() const {
+	shared_ptr<FunctionTable> stressStrainFunction = getStressStrainFunction();
+	if (stressStrainFunction) {
+		return stressStrainFunction->getPayload();
+	}
+	// The function is not defined: the nature is only like those referencing the same one.
+	return {UNAVAILABLE_DOUBLE, static_cast<double>(stress_strain_function_ref.original_id),
+			static_cast<double>(stress_strain_function_ref.id)};
+}
+
 NonLinearElasticNature::~NonLinearElasticNature() {
 
 }
@@ -227,6 +257,10 @@ shared_ptr<Nature> RigidNature::clone() const {
     return shared_ptr<Nature>(new RigidNature(*this));
 }
 
+vector<double> RigidNature::getPayload() const {
+    return {rigidity, lagrangian};
+}
+
 RigidNature::~RigidNature() {
 }
 
@@ -58,6 +58,11 @@ public:
     const NatureType type;
     Nature(const Model&, NatureType);
     virtual std::shared_ptr<Nature> clone() const = 0;
+    /**
+     * Parameters of the nature, as given in the input: two natures of the same type with
+     * equal payloads are interchangeable.
+     */
+    virtual std::vector<double> getPayload() const = 0;
     virtual ~Nature();
 };
 
@@ -96,6 +101,7 @@ public:
     double getTref() const;
 
     virtual std::shared_ptr<Nature> clone() const;
+    virtual std::vector<double> getPayload() const override;
     virtual ~ElasticNature();
 
 };
@@ -109,6 +115,7 @@ public:
     BilinearElasticNature(const Model&, const double elastic_limit, const double secondary_slope);
     BilinearElasticNature(const Model&);
     virtual std::shared_ptr<Nature> clone() const;
+    virtual std::vector<double> getPayload() const override;
     virtual ~BilinearElasticNature();
 };
 
@@ -119,6 +126,7 @@ public:
     NonLinearElasticNature(const Model&, const int stress_strain_function_id);
     std::shared_ptr<FunctionTable> getStressStrainFunction() const;
     virtual std::shared_ptr<Nature> clone() const;
+    virtual std::vector<double> getPayload() const override;
     virtual ~NonLinearElasticNature();
 
 };
@@ -140,6 +148,7 @@ public:
     void setLagrangian(double lagrangian);
 
     virtual std::shared_ptr<Nature> clone() const;
+    virtual std::vector<double> getPayload() const override;
     virtual ~RigidNature();
 
 };
@@ -166,6 +175,11 @@ public:
     const std::shared_ptr<Nature> findNature(Nature::NatureType) const;
     virtual bool validate() const override;
     virtual std::shared_ptr<Material> clone() const;
+    /**
+     * Types and payloads of all the natures of the material: materials with equal payloads
+     * can be merged.
+     */
+    std::vector<double> getPayload() const;
     /**
      * Get all the cells assigned to a specific material. This inspects
      * both the elementSets with a material assigned and the materials assigned
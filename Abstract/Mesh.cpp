@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <algorithm>
+#include <bitset>
 #include <cstddef>
 #include <utility>
 #include <iostream>
@@ -113,6 +114,14 @@ int Mesh::countNodes() const {
 	return static_cast<int>(nodes.nodeDatas.size());
 }
 
+long Mesh::countDOFS() const {
+	long dofCount = 0;
+	for (const NodeData& nodeData : nodes.nodeDatas) {
+		dofCount += static_cast<long>(bitset<8>(static_cast<unsigned char>(nodeData.dofs)).count());
+	}
+	return dofCount;
+}
+
 const Node Mesh::findNode(const int nodePosition, const bool buildGlobalXYZ, const Model* model) const {
 	if (nodePosition == Node::UNAVAILABLE_NODE) {
 		throw invalid_argument(
@@ -165,6 +174,14 @@ void Mesh::allowDOFS(int nodePosition, const DOFS allowed) {
 			| allowed);
 }
 
+void Mesh::allowDOFS(const DOFMasks& allowed) {
+	const size_t size = min(allowed.size(), nodes.nodeDatas.size());
+	for (size_t position = 0; position < size; position++) {
+		NodeData& nodeData = nodes.nodeDatas[position];
+		nodeData.dofs = static_cast<char>(nodeData.dofs | allowed.find(static_cast<int>(position)));
+	}
+}
+
 bool NodeStorage::validate() const {
 	bool validNodes = true;
 	for (size_t i = 0; i < nodeDatas.size(); ++i) {
@@ -320,6 +337,12 @@ int Mesh::updateCell(int id, const CellType &cellType, const std::vector<int> &n
         cellData.csPos = cpos;
         }
     cells.cellDatas.push_back(cellData);
+    // the groups containing the cell now reference other nodes
+    for (const auto& nameAndGroup : groupByName) {
+        if (nameAndGroup.second->type == Group::CELLGROUP) {
+            static_cast<CellGroup*>(nameAndGroup.second)->nodePositionsCached = false;
+        }
+    }
 
     return cellPosition;
 }
@@ -347,6 +370,17 @@ const Cell Mesh::findCell(int cellPosition) const {
 	return cell;
 }
 
+void Mesh::appendCellNodePositions(int cellPosition, vector<int>& nodePositions) const {
+	if (cellPosition == Cell::UNAVAILABLE_CELL) {
+		throw logic_error("Unavailable cell requested.");
+	}
+	const CellData& cellData = cells.cellDatas[cellPosition];
+	const CellType* type = CellType::findByCode(cellData.typeCode);
+	const deque<int>& globalNodePositions = *(cells.nodepositionsByCelltype.find(*type)->second);
+	const int start = cellData.cellTypePosition * static_cast<int>(type->numNodes);
+	nodePositions.insert(nodePositions.end(), globalNodePositions.begin() + start,
+			globalNodePositions.begin() + start + type->numNodes);
+}
 
 void Mesh::createFamilies(med_idt fid, const char meshname[MED_NAME_SIZE + 1],
 		vector<Family>& families) {
@@ -708,6 +742,13 @@ int Mesh::countCells(const CellType& type) const {
 	return (int) positions.size();
 }
 
+const CellData& Mesh::findCellData(int cellPosition) const {
+	if (cellPosition == Cell::UNAVAILABLE_CELL) {
+		throw logic_error("Unavailable cell requested.");
+	}
+	return cells.cellDatas[cellPosition];
+}
+
 bool Mesh::hasCell(int cellId) const {
 	auto positionIterator =
 			cells.cellpositionById.find(cellId);
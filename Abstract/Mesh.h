@@ -153,7 +153,15 @@ public:
 	        int cpPos = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID,
 	        int cdPos = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID);
 	int countNodes() const;
+	/**
+	 * Number of DOFs allowed on the nodes, after Model::finish().
+	 */
+	long countDOFS() const;
 	void allowDOFS(int nodePosition, const DOFS allowed);
+	/**
+	 * Adds the DOFs of each mask to the node at the same position.
+	 */
+	void allowDOFS(const DOFMasks& allowed);
 	/**
 	 * Find a node from its Vega position.
 	 * If buildGlobalXYZ is true, we compute the position (x,y,z) of the Node in
@@ -192,6 +200,14 @@ public:
             bool virtualCell = false, const int cpos=CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID, int elementId = Cell::UNAVAILABLE_CELL);
     int findCellPosition(int cellId) const;
 	const Cell findCell(int cellPosition) const;
+	/**
+	 * Appends the node positions of a cell, without building the Cell.
+	 */
+	void appendCellNodePositions(int cellPosition, std::vector<int>& nodePositions) const;
+	/**
+	 * Type and position among the cells of that type of a cell, without building the Cell.
+	 */
+	const CellData& findCellData(int cellPosition) const;
 	bool hasCell(int cellId) const;
 
 	/**
@@ -11,8 +11,10 @@
 #include "MeshComponents.h"
 #include "Mesh.h"
 #include "Model.h"
+#include "Parallel.h"
 #include <string>
 #include <initializer_list>
+#include <numeric>
 #include <boost/lexical_cast.hpp>
 #include <boost/assign.hpp>
 #if defined VDEBUG && defined __GNUC__
@@ -171,25 +173,26 @@ void NodeGroup::addNode(int nodeId) {
 	_nodePositions.insert(nodePosition);
 }
 
+void NodeGroup::addNodeIds(const vector<int>& nodeIds) {
+	vector<int> positions;
+	positions.reserve(nodeIds.size());
+	for (int nodeId : nodeIds) {
+		positions.push_back(this->mesh->findOrReserveNode(nodeId));
+	}
+	_nodePositions.insert(positions.begin(), positions.end());
+}
+
 void NodeGroup::addNodeByPosition(int nodePosition) {
 	_nodePositions.insert(nodePosition);
 }
 
 void NodeGroup::removeNodeByPosition(int nodePosition) {
-	if (_nodePositions.find(nodePosition) == _nodePositions.end()) {
+	if (_nodePositions.erase(nodePosition) == 0) {
 		throw logic_error("Node position not present : " + to_string(nodePosition));
 	}
-	for (auto it = _nodePositions.begin(); it != _nodePositions.end();) {
-		if (*it == nodePosition) {
-			_nodePositions.erase(it);
-			return;
-		} else {
-			it++;
-		}
-	}
 }
 
-const std::set<int> NodeGroup::nodePositions() const {
+const NodeSet& NodeGroup::nodePositions() const {
 	return _nodePositions;
 }
 
@@ -212,6 +215,7 @@ CellGroup::CellGroup(Mesh* mesh, const string& name, int groupId, const string&
 
 void CellGroup::addCell(int cellId) {
 	this->cellIds.insert(cellId);
+	nodePositionsCached = false;
 	if (this->mesh->logLevel >= LogLevel::TRACE) {
 		cout << "Group MA :" << this->getName() << ", Added: " << cellId << endl;
 	}
@@ -234,14 +238,18 @@ vector<int> CellGroup::cellPositions() {
 	return result;
 }
 
-const set<int> CellGroup::nodePositions() const {
-	set<int> result;
-	for (int cellId : cellIds) {
-		int position = mesh->findCellPosition(cellId);
-		Cell cell = mesh->findCell(position);
-		result.insert(cell.nodePositions.begin(), cell.nodePositions.end());
+const NodeSet& CellGroup::nodePositions() const {
+	lock_guard<mutex> lock(nodePositionsMutex);
+	if (!nodePositionsCached) {
+		vector<int> positions;
+		for (int cellId : cellIds) {
+			mesh->appendCellNodePositions(mesh->findCellPosition(cellId), positions);
+		}
+		cachedNodePositions.clear();
+		cachedNodePositions.insert(positions.begin(), positions.end());
+		nodePositionsCached = true;
 	}
-	return result;
+	return cachedNodePositions;
 }
 
 CellGroup::~CellGroup() {
@@ -366,6 +374,8 @@ const unordered_map<CellType::Code, vector<vector<int>>, hash<int> > Cell::FACE_
 		init_faceByCelltype();
 
 // http://www.code-aster.org/outils/med/html/connectivites.html
+// The corners of a face come first, followed by its middle nodes (in the MED order of the
+// TRI6, QUAD8 or QUAD9 cell built on that face).
 unordered_map<CellType::Code, vector<vector<int>>, hash<int> > Cell::init_faceByCelltype() {
 	vector<vector<int> > hexa8list = list_of<vector<int>>( //
 			list_of(1)(2)(3)(4)) //
@@ -374,15 +384,65 @@ unordered_map<CellType::Code, vector<vector<int>>, hash<int> > Cell::init_faceBy
 			(list_of(2)(3)(7)(6)) //
 			(list_of(3)(7)(8)(4)) //
 			(list_of(1)(4)(8)(5)); //
+	vector<vector<int> > hexa20list = list_of<vector<int>>( //
+			list_of(1)(2)(3)(4)(9)(10)(11)(12)) //
+			(list_of(5)(6)(7)(8)(13)(14)(15)(16)) //
+			(list_of(1)(2)(6)(5)(9)(18)(13)(17)) //
+			(list_of(2)(3)(7)(6)(10)(19)(14)(18)) //
+			(list_of(3)(7)(8)(4)(19)(15)(20)(11)) //
+			(list_of(1)(4)(8)(5)(12)(20)(16)(17)); //
+	vector<vector<int> > hexa27list = list_of<vector<int>>( //
+			list_of(1)(2)(3)(4)(9)(10)(11)(12)(21)) //
+			(list_of(5)(6)(7)(8)(13)(14)(15)(16)(26)) //
+			(list_of(1)(2)(6)(5)(9)(18)(13)(17)(22)) //
+			(list_of(2)(3)(7)(6)(10)(19)(14)(18)(23)) //
+			(list_of(3)(7)(8)(4)(19)(15)(20)(11)(24)) //
+			(list_of(1)(4)(8)(5)(12)(20)(16)(17)(25)); //
+	vector<vector<int> > penta6list = list_of<vector<int>>( //
+			list_of(1)(2)(3)) //
+			(list_of(4)(5)(6)) //
+			(list_of(1)(2)(5)(4)) //
+			(list_of(2)(3)(6)(5)) //
+			(list_of(1)(4)(6)(3)); //
+	vector<vector<int> > penta15list = list_of<vector<int>>( //
+			list_of(1)(2)(3)(7)(8)(9)) //
+			(list_of(4)(5)(6)(10)(11)(12)) //
+			(list_of(1)(2)(5)(4)(7)(14)(10)(13)) //
+			(list_of(2)(3)(6)(5)(8)(15)(11)(14)) //
+			(list_of(1)(4)(6)(3)(13)(12)(15)(9)); //
+	vector<vector<int> > pyra5list = list_of<vector<int>>( //
+			list_of(1)(2)(3)(4)) //
+			(list_of(1)(2)(5)) //
+			(list_of(2)(3)(5)) //
+			(list_of(3)(4)(5)) //
+			(list_of(4)(1)(5)); //
+	vector<vector<int> > pyra13list = list_of<vector<int>>( //
+			list_of(1)(2)(3)(4)(6)(7)(8)(9)) //
+			(list_of(1)(2)(5)(6)(11)(10)) //
+			(list_of(2)(3)(5)(7)(12)(11)) //
+			(list_of(3)(4)(5)(8)(13)(12)) //
+			(list_of(4)(1)(5)(9)(10)(13)); //
 	vector<vector<int> > tetra4list = list_of<vector<int>>( //
 			list_of(1)(2)(3)) //
 			(list_of(1)(4)(2)) //
 			(list_of(1)(4)(3)) //
 			(list_of(2)(3)(4)); //
+	vector<vector<int> > tetra10list = list_of<vector<int>>( //
+			list_of(1)(2)(3)(5)(6)(7)) //
+			(list_of(1)(4)(2)(8)(9)(5)) //
+			(list_of(1)(4)(3)(8)(10)(7)) //
+			(list_of(2)(3)(4)(6)(10)(9)); //
 
 	unordered_map<CellType::Code, vector<vector<int>>, hash<int> > result =
-			boost::assign::map_list_of(CellType::HEXA8.code, hexa8list) //Hexa8
-			(CellType::TETRA4.code, tetra4list); //Tetra4 end
+			boost::assign::map_list_of(CellType::HEXA8.code, hexa8list) //
+			(CellType::HEXA20.code, hexa20list) //
+			(CellType::HEXA27.code, hexa27list) //
+			(CellType::PENTA6.code, penta6list) //
+			(CellType::PENTA15.code, penta15list) //
+			(CellType::PYRA5.code, pyra5list) //
+			(CellType::PYRA13.code, pyra13list) //
+			(CellType::TETRA4.code, tetra4list) //
+			(CellType::TETRA10.code, tetra10list); //Tetra10 end
 	return result;
 }
 
@@ -416,39 +476,58 @@ int Cell::findNodeIdPosition(int node_id2) const {
 }
 
 vector<int> Cell::faceids_from_two_nodes(int nodeId1, int nodeId2) const {
-	int node1connectivityPos = findNodeIdPosition(nodeId1);
-	int node2connectivityPos = findNodeIdPosition(nodeId2);
-
+	const int node1Num = findNodeIdPosition(nodeId1) + 1;
 	if (type.dimension == SpaceDimension::DIMENSION_2D) {
 		return vector<int>(nodeIds.begin(), nodeIds.end());
 	}
-	vector<int> nodePositions;
+	auto facesIt = FACE_BY_CELLTYPE.find(type.code);
+	if (facesIt == FACE_BY_CELLTYPE.end()) {
+		throw logic_error("FaceidfromtwoNodes not implemented for " + type.description);
+	}
+	const bool hasNode2 = nodeId2 != Node::UNAVAILABLE_NODE;
+	const int node2Num = hasNode2 ? findNodeIdPosition(nodeId2) + 1 : 0;
 	//node2 is on the opposite face
-	if (type.code == CellType::TETRA4.code) { //|| cellType == CellType::TETRA10
-		vector<vector<int> > faceids = FACE_BY_CELLTYPE.find(CellType::TETRA4.code)->second;
-		for (vector<int> faceid : faceids) {
-			//0 based
-			if (find(faceid.begin(), faceid.end(), node2connectivityPos + 1) == faceid.end()) {
-				nodePositions.assign(faceid.begin(), faceid.end());
-			}
+	const bool node2Opposite = type.code == CellType::TETRA4.code
+			|| type.code == CellType::TETRA10.code;
+	const vector<int>* faceFound = nullptr;
+	for (const vector<int>& face : facesIt->second) {
+		// only the corners identify a face, the middle nodes follow them
+		const size_t numCorners = (face.size() == 3 || face.size() == 6) ? 3 : 4;
+		const auto cornersEnd = face.begin() + static_cast<long>(numCorners);
+		const auto node1It = find(face.begin(), cornersEnd, node1Num);
+		if (node1It == cornersEnd) {
+			continue;
 		}
-	} else if (type.code == CellType::HEXA8.code) {
-		vector<vector<int> > faceids = FACE_BY_CELLTYPE.find(CellType::HEXA8.code)->second;
-		for (vector<int> faceid : faceids) {
-			//0 based
-			if (find(faceid.begin(), faceid.end(), node2connectivityPos + 1) != faceid.end()
-					&& find(faceid.begin(), faceid.end(), node1connectivityPos + 1)
-							!= faceid.end()) {
-				nodePositions.assign(faceid.begin(), faceid.end());
-				break;
-			}
+		bool matches;
+		if (node2Opposite) {
+			matches = find(face.begin(), cornersEnd, node2Num) == cornersEnd;
+		} else if (!hasNode2) {
+			matches = numCorners == 3;
+		} else if (numCorners == 4) {
+			// node2 is diagonally opposite to node1 on a quadrangular face
+			matches = face[static_cast<size_t>(node1It - face.begin() + 2) % 4] == node2Num;
+		} else {
+			matches = find(face.begin(), cornersEnd, node2Num) != cornersEnd;
+		}
+		if (!matches) {
+			continue;
+		}
+		if (faceFound != nullptr) {
+			// e.g. a corner of a pyramid, or an edge between two of its triangular faces
+			throw logic_error(
+					"Several faces of cell " + to_string(id) + " match nodes " + to_string(nodeId1)
+							+ " and " + to_string(nodeId2));
 		}
-	} else {
-		throw logic_error("FaceidfromtwoNodes not implemented");
+		faceFound = &face;
+	}
+	if (faceFound == nullptr) {
+		throw logic_error(
+				"No face of cell " + to_string(id) + " matches nodes " + to_string(nodeId1) + " and "
+						+ to_string(nodeId2));
 	}
 	vector<int> faceConnectivity;
-	faceConnectivity.reserve(nodePositions.size());
-	for (int nodeNum : nodePositions) {
+	faceConnectivity.reserve(faceFound->size());
+	for (int nodeNum : *faceFound) {
 		faceConnectivity.push_back(nodeIds[nodeNum - 1]);
 	}
 	return faceConnectivity;
@@ -597,10 +676,17 @@ vector<int> CellContainer::getCellIds(bool all) const {
 	return cells;
 }
 
-set<int> CellContainer::nodePositions() const {
-	set<int> result;
-	for (Cell cell : getCells(true)) {
-		result.insert(cell.nodePositions.begin(), cell.nodePositions.end());
+NodeSet CellContainer::nodePositions() const {
+	vector<int> positions;
+	for (int cellId : cellIds) {
+		mesh->appendCellNodePositions(mesh->findCellPosition(cellId), positions);
+	}
+	NodeSet result(positions.begin(), positions.end());
+	for (const string& groupName : groupNames) {
+		CellGroup* group = static_cast<CellGroup *>(mesh->findGroup(groupName));
+		if (group != nullptr) {
+			result.insert(group->nodePositions());
+		}
 	}
 	return result;
 }
@@ -647,49 +733,172 @@ bool CellContainer::hasCellGroups() const {
 	return groupNames.size() > 0;
 }
 
-NodeGroup2Families::NodeGroup2Families(int nnodes, const vector<NodeGroup*> nodeGroups) {
-	int currentFamilyId = 0;
-	unordered_map<int, int> newFamilyByOldfamily;
-	unordered_map<int, Family> familyByFamilyId;
-	if (nnodes > 0 && nodeGroups.size() > 0) {
-		this->nodes.resize(nnodes, 0);
-		for (NodeGroup * nodeGroup : nodeGroups) {
-			newFamilyByOldfamily.clear();
-			for (int nodePosition : nodeGroup->nodePositions()) {
-				int oldFamily = nodes[nodePosition];
-				auto newFamilyPair = newFamilyByOldfamily.find(oldFamily);
-				int newFamilyId;
-				if (newFamilyPair == newFamilyByOldfamily.end()) {
-					//family not found, create one
-					currentFamilyId++;
-					Family fam;
-					auto oldFamilyPair = familyByFamilyId.find(oldFamily);
-					if (oldFamilyPair != familyByFamilyId.end()) {
-						Family& oldFamily = oldFamilyPair->second;
-						fam.groups.insert(fam.groups.begin(), oldFamily.groups.begin(),
-								oldFamily.groups.end());
-						fam.name = oldFamily.name + "_" + nodeGroup->getName();
-						if (fam.name.length() >= MED_LNAME_SIZE) {
-							fam.name = string("Family") + lexical_cast<string>(currentFamilyId);
-						}
-					} else {
-						fam.name = nodeGroup->getName();
-					}
-					newFamilyId = fam.num = currentFamilyId;
-					fam.groups.push_back(nodeGroup);
-					newFamilyByOldfamily.insert(make_pair(oldFamily, currentFamilyId));
-					familyByFamilyId.insert(make_pair(currentFamilyId, fam));
-				} else {
-					newFamilyId = newFamilyPair->second;
+namespace {
+
+typedef pair<vector<int>::const_iterator, vector<int>::const_iterator> ItemRange;
+
+/**
+ * Minimum number of items (nodes or cells) whose signatures are computed by one worker.
+ */
+const size_t MIN_ITEMS_BY_WORKER = 1 << 16;
+
+/**
+ * Signature of an item: the indices, in increasing order, of the groups it belongs to.
+ */
+struct Signature final {
+	const int* begin;
+	const int* end;
+	size_t hash;
+	bool operator==(const Signature& other) const {
+		return end - begin == other.end - other.begin && equal(begin, end, other.begin);
+	}
+};
+
+struct SignatureHash final {
+	size_t operator()(const Signature& signature) const {
+		return signature.hash;
+	}
+};
+
+/**
+ * Signatures of the items of [begin, end), stored one after the other.
+ */
+struct SignatureChunk final {
+	size_t begin;
+	vector<size_t> offsets;
+	vector<int> groups;
+	vector<size_t> hashes;
+	Signature signature(size_t item) const {
+		const size_t i = item - begin;
+		return {groups.data() + offsets[i], groups.data() + offsets[i + 1], hashes[i]};
+	}
+};
+
+/**
+ * Splits the count items into families: the items that belong to the same groups.
+ *
+ * itemsByGroup gives, for each group, its items in increasing order. The signatures of the
+ * items are computed in parallel, each worker handling a range of items, then hashed into
+ * families: the cost is linear in the number of items and of memberships, and only
+ * logarithmic in the number of groups.
+ *
+ * @return the family number of each item, from 1, or 0 for the items in no group. The families
+ * are numbered in the lexicographic order of their signatures, which are returned in signatures.
+ */
+vector<int> computeSignatures(size_t count, const vector<ItemRange>& itemsByGroup,
+		vector<vector<int>>& signatures) {
+	const size_t chunkCount = max(min(countWorkers(), count / MIN_ITEMS_BY_WORKER), size_t(1));
+	const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+	vector<SignatureChunk> chunks(chunkCount);
+	parallelFor(chunkCount, [&](size_t beginChunk, size_t endChunk) {
+		for (size_t c = beginChunk; c < endChunk; c++) {
+			SignatureChunk& chunk = chunks[c];
+			chunk.begin = min(c * chunkSize, count);
+			const size_t end = min(chunk.begin + chunkSize, count);
+			const int first = static_cast<int>(chunk.begin);
+			const int last = static_cast<int>(end);
+			vector<ItemRange> ranges;
+			ranges.reserve(itemsByGroup.size());
+			chunk.offsets.assign(end - chunk.begin + 1, 0);
+			for (const ItemRange& items : itemsByGroup) {
+				const auto rangeBegin = lower_bound(items.first, items.second, first);
+				ranges.push_back(ItemRange(rangeBegin, lower_bound(rangeBegin, items.second, last)));
+				for (auto it = ranges.back().first; it != ranges.back().second; ++it) {
+					chunk.offsets[static_cast<size_t>(*it - first) + 1]++;
+				}
+			}
+			partial_sum(chunk.offsets.begin(), chunk.offsets.end(), chunk.offsets.begin());
+			chunk.groups.resize(chunk.offsets.back());
+			vector<size_t> filled(chunk.offsets.begin(), chunk.offsets.end() - 1);
+			for (size_t group = 0; group < ranges.size(); group++) {
+				for (auto it = ranges[group].first; it != ranges[group].second; ++it) {
+					chunk.groups[filled[static_cast<size_t>(*it - first)]++] = static_cast<int>(group);
 				}
-				nodes[nodePosition] = newFamilyId;
 			}
+			chunk.hashes.resize(end - chunk.begin);
+			for (size_t i = 0; i < chunk.hashes.size(); i++) {
+				chunk.hashes[i] = boost::hash_range(chunk.groups.begin() + static_cast<ptrdiff_t>(chunk.offsets[i]),
+						chunk.groups.begin() + static_cast<ptrdiff_t>(chunk.offsets[i + 1]));
+			}
+		}
+	});
+
+	vector<int> families(count, 0);
+	unordered_map<Signature, int, SignatureHash> familyBySignature;
+	vector<Signature> distinctSignatures;
+	for (const SignatureChunk& chunk : chunks) {
+		for (size_t item = chunk.begin; item < chunk.begin + chunk.hashes.size(); item++) {
+			const Signature signature = chunk.signature(item);
+			if (signature.begin == signature.end) {
+				continue;
+			}
+			auto inserted = familyBySignature.insert(
+					make_pair(signature, static_cast<int>(distinctSignatures.size()) + 1));
+			if (inserted.second) {
+				distinctSignatures.push_back(signature);
+			}
+			families[item] = inserted.first->second;
+		}
+	}
+
+	vector<size_t> order(distinctSignatures.size());
+	iota(order.begin(), order.end(), 0);
+	sort(order.begin(), order.end(), [&distinctSignatures](size_t left, size_t right) {
+		return lexicographical_compare(distinctSignatures[left].begin, distinctSignatures[left].end,
+				distinctSignatures[right].begin, distinctSignatures[right].end);
+	});
+	vector<int> familyByFirstAppearance(distinctSignatures.size() + 1, 0);
+	signatures.clear();
+	signatures.reserve(order.size());
+	for (size_t i = 0; i < order.size(); i++) {
+		familyByFirstAppearance[order[i] + 1] = static_cast<int>(i) + 1;
+		signatures.push_back(vector<int>(distinctSignatures[order[i]].begin, distinctSignatures[order[i]].end));
+	}
+	parallelFor(count, [&families, &familyByFirstAppearance](size_t begin, size_t end) {
+		for (size_t item = begin; item < end; item++) {
+			families[item] = familyByFirstAppearance[static_cast<size_t>(families[item])];
+		}
+	}, MIN_ITEMS_BY_WORKER);
+	return families;
+}
+
+/**
+ * Family of the groups of a signature, named after them, or after its number if their names
+ * joined are too long for MED.
+ */
+template<typename G>
+Family makeFamily(const vector<int>& signature, const vector<G*>& groups, int num,
+		const string& prefix) {
+	Family family;
+	family.num = num;
+	for (int group : signature) {
+		family.groups.push_back(groups[static_cast<size_t>(group)]);
+		if (!family.name.empty()) {
+			family.name += "_";
 		}
+		family.name += groups[static_cast<size_t>(group)]->getName();
 	}
-	set<int> familiesInUse(nodes.begin(), nodes.end());
-	for (int fam_id : familiesInUse) {
-		if (fam_id != 0) {
-			families.push_back(familyByFamilyId[fam_id]);
+	if (family.name.length() >= MED_LNAME_SIZE) {
+		family.name = prefix + lexical_cast<string>(abs(num));
+	}
+	return family;
+}
+
+} /* namespace */
+
+NodeGroup2Families::NodeGroup2Families(int nnodes, const vector<NodeGroup*> nodeGroups) {
+	if (nnodes > 0 && nodeGroups.size() > 0) {
+		vector<ItemRange> nodesByGroup;
+		nodesByGroup.reserve(nodeGroups.size());
+		for (NodeGroup * nodeGroup : nodeGroups) {
+			const NodeSet& nodePositions = nodeGroup->nodePositions();
+			nodesByGroup.push_back(ItemRange(nodePositions.begin(), nodePositions.end()));
+		}
+		vector<vector<int>> signatures;
+		this->nodes = computeSignatures(static_cast<size_t>(nnodes), nodesByGroup, signatures);
+		for (size_t i = 0; i < signatures.size(); i++) {
+			const int num = static_cast<int>(i) + 1;
+			families.push_back(makeFamily(signatures[i], nodeGroups, num, "Family"));
 		}
 	}
 }
@@ -705,59 +914,49 @@ vector<int>& NodeGroup2Families::getFamilyOnNodes() {
 CellGroup2Families::CellGroup2Families(
 		const Mesh* mesh, unordered_map<CellType::Code, int, hash<int>> cellCountByType,
 		const vector<CellGroup *>& cellGroups) : mesh(mesh) {
-	int currentFamilyId = 0;
-	unordered_map<int, int> newFamilyByOldfamily;
-	unordered_map<int, Family> familyByFamilyId;
-	for (auto cellCountByTypePair : cellCountByType) {
-		shared_ptr<vector<int>> cells(new vector<int>());
-		cells->resize(cellCountByTypePair.second, 0);
-		cellFamiliesByType[cellCountByTypePair.first] = cells;
-	}
-
-	for (CellGroup * cellGroup : cellGroups) {
-		newFamilyByOldfamily.clear();
-		for (auto cellPosition : cellGroup->cellPositions()) {
-			const Cell& cell = mesh->findCell(cellPosition);
-			shared_ptr<vector<int>> currentCellFamilies = cellFamiliesByType[cell.type.code];
-			int oldFamily = currentCellFamilies->at(cell.cellTypePosition);
-			auto newFamilyPair = newFamilyByOldfamily.find(oldFamily);
-			int newFamilyId;
-			if (newFamilyPair == newFamilyByOldfamily.end()) {
-				//family not found, create one
-				currentFamilyId--;
-				Family fam;
-				auto oldFamilyPair = familyByFamilyId.find(oldFamily);
-				if (oldFamilyPair != familyByFamilyId.end()) {
-					Family& oldFamily = oldFamilyPair->second;
-					fam.groups.insert(fam.groups.begin(), oldFamily.groups.begin(),
-							oldFamily.groups.end());
-					fam.name = oldFamily.name + "_" + cellGroup->getName();
-					if (fam.name.length() >= MED_LNAME_SIZE) {
-						fam.name = string("CELLFamily") + lexical_cast<string>(-currentFamilyId);
-					}
-				} else {
-					fam.name = cellGroup->getName();
-				}
-				newFamilyId = fam.num = currentFamilyId;
-				fam.groups.push_back(cellGroup);
-				newFamilyByOldfamily[oldFamily] = currentFamilyId;
-				familyByFamilyId[currentFamilyId] = fam;
-			} else {
-				newFamilyId = newFamilyPair->second;
+	// The cells are numbered type after type, in the order of their position in the type.
+	map<CellType::Code, size_t> offsetByType;
+	size_t cellCount = 0;
+	for (const auto& cellCountByTypePair : cellCountByType) {
+		offsetByType[cellCountByTypePair.first] = 0;
+	}
+	for (auto& offsetByTypePair : offsetByType) {
+		offsetByTypePair.second = cellCount;
+		cellCount += static_cast<size_t>(cellCountByType[offsetByTypePair.first]);
+	}
+	const map<CellType::Code, size_t>& offsets = offsetByType;
+	vector<vector<int>> cellsByGroup(cellGroups.size());
+	parallelFor(cellGroups.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			vector<int>& cells = cellsByGroup[i];
+			cells.reserve(cellGroups[i]->cellIds.size());
+			for (int cellPosition : cellGroups[i]->cellPositions()) {
+				const CellData& cellData = mesh->findCellData(cellPosition);
+				cells.push_back(static_cast<int>(offsets.at(cellData.typeCode))
+						+ cellData.cellTypePosition);
 			}
-			currentCellFamilies->at(cell.cellTypePosition) = newFamilyId;
+			sort(cells.begin(), cells.end());
 		}
+	});
+	vector<ItemRange> cellRangesByGroup;
+	cellRangesByGroup.reserve(cellsByGroup.size());
+	for (const vector<int>& cells : cellsByGroup) {
+		cellRangesByGroup.push_back(ItemRange(cells.begin(), cells.end()));
 	}
-
-	set<int> familiesInUse;
-	for (auto cellFamilyAndTypePair : cellFamiliesByType) {
-		familiesInUse.insert(cellFamilyAndTypePair.second->begin(),
-				cellFamilyAndTypePair.second->end());
-	}
-	for (int fam_id : familiesInUse) {
-		if (fam_id != 0) {
-			families.push_back(familyByFamilyId[fam_id]);
+	vector<vector<int>> signatures;
+	const vector<int> cellFamilies = computeSignatures(cellCount, cellRangesByGroup, signatures);
+	for (const auto& offsetByTypePair : offsetByType) {
+		const auto begin = cellFamilies.begin() + static_cast<ptrdiff_t>(offsetByTypePair.second);
+		shared_ptr<vector<int>> cells(new vector<int>(begin,
+				begin + cellCountByType[offsetByTypePair.first]));
+		for (int& family : *cells) {
+			family = -family;
 		}
+		cellFamiliesByType[offsetByTypePair.first] = cells;
+	}
+	for (size_t i = signatures.size(); i > 0; i--) {
+		const int num = -static_cast<int>(i);
+		families.push_back(makeFamily(signatures[i - 1], cellGroups, num, "CELLFamily"));
 	}
 }
 
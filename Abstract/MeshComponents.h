@@ -26,12 +26,14 @@
 
 #include "CoordinateSystem.h"
 #include "Dof.h"
+#include "NodeSet.h"
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
 #include <stdexcept>
 #include <iterator>
+#include <mutex>
 #ifdef __GNUC__
 // Avoid tons of warnings with root code
 #pragma GCC system_header
@@ -228,7 +230,7 @@ public:
     std::string comment; ///< A comment string, usually use to retain the command which created the group.
     const std::string getName() const;
     const std::string getComment() const;
-    virtual const std::set<int> nodePositions() const = 0;
+    virtual const NodeSet& nodePositions() const = 0;
     virtual ~Group();
 };
 
@@ -239,7 +241,7 @@ private:
     /**
      * Positions of the nodes participating to the group
      */
-    std::set<int> _nodePositions;
+    NodeSet _nodePositions;
 public:
     /**
      * Add a node using its numerical id. If the node hasn't been yet defined it reserve a
@@ -251,14 +253,15 @@ public:
      */
     template<typename iterator>
     void addNodes(iterator begin, iterator end) {
-        while (begin != end) {
-            addNode(*begin);
-            begin++;
-        }
+        addNodeIds(std::vector<int>(begin, end));
     }
+    /**
+     * Add nodes using their numerical ids, sorting the group only once.
+     */
+    void addNodeIds(const std::vector<int>& nodeIds);
     void addNodeByPosition(int nodePosition);
     void removeNodeByPosition(int nodePosition);
-    const std::set<int> nodePositions() const override;
+    const NodeSet& nodePositions() const override;
     const std::set<int> getNodeIds() const;
 };
 
@@ -342,10 +345,13 @@ public:
      * @param node1: grid point connected to a corner of the face.
      * Required data for solid elements only.
      * @param node2: grid point connected to a corner diagonally
-     * opposite to nodePosition1 on the same face of a CHEXA or CPENTA element.
-     * Required data for quadrilateral faces of CHEXA and CPENTA
+     * opposite to nodePosition1 on the same face of a CHEXA, CPENTA or CPYRAM element.
+     * Required data for quadrilateral faces of CHEXA, CPENTA and CPYRAM
      * elements only. nodePosition2 must be omitted for a triangular surface on a
-     * CPENTA element.
+     * CPENTA or CPYRAM element. As a corner of a CPYRAM belongs to several triangular
+     * faces, node2 is there a second corner of the triangular face, on its base edge.
+     *
+     * Throws a logic_error if the nodes match no face, or several ones.
      *
      * node2 : CTETRA grid point located at the corner;
      * this grid point may not reside on the face being loaded. This is
@@ -371,12 +377,19 @@ class CellGroup final: public Group {
 private:
     friend Mesh;
     CellGroup(Mesh* mesh, const std::string & name, int id = NO_ORIGINAL_ID, const std::string & comment = "");
+    /**
+     * Nodes of the cells, computed on the first call to nodePositions() and
+     * reset when a cell is added. The mutex lets the writers read them concurrently.
+     */
+    mutable NodeSet cachedNodePositions;
+    mutable bool nodePositionsCached = false;
+    mutable std::mutex nodePositionsMutex;
 public:
     std::unordered_set<int> cellIds;
     void addCell(int cellId);
     std::vector<Cell> getCells();
     std::vector<int> cellPositions();
-    const std::set<int> nodePositions() const override;
+    const NodeSet& nodePositions() const override;
     virtual ~CellGroup();
 };
 
@@ -481,7 +494,7 @@ public:
      */
     std::vector<int> getCellIds(bool all = false) const;
 
-    std::set<int> nodePositions() const;
+    NodeSet nodePositions() const;
 
     bool containsCells(CellType cellType, bool all = false);
     /**
@@ -9,9 +9,13 @@
  */
 
 #include "Model.h"
+#include "Parallel.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <fstream>
 #include <boost/lexical_cast.hpp>
 #include <boost/assign.hpp>
@@ -252,7 +256,14 @@ std::shared_ptr<Objective> Model::getObjective(int id) const {
 }
 
 std::shared_ptr<Value> Model::getValue(int id) const {
-    return values.get(id);
+    shared_ptr<Value> value = values.get(id);
+    if (!value) {
+        auto it = internedValuesById.find(id);
+        if (it != internedValuesById.end()) {
+            value = it->second;
+        }
+    }
+    return value;
 }
 
 std::shared_ptr<CoordinateSystem> Model::getCoordinateSystem(int id) const {
@@ -275,24 +286,54 @@ int Model::addOrFindOrientation(const OrientationCoordinateSystem & ocs){
 
 	int posOrientation = findOrientation(ocs);
 	if (posOrientation==0){
-		this->add(ocs);
-		posOrientation = coordinateSystemStorage->findPositionById(ocs.getId());
+		posOrientation = addOrientation(ocs);
+	}
+	return posOrientation;
+}
+
+int Model::addOrFindOrientation(int nO, int nX, int nV){
+	int posOrientation = findOrientation(nO, nX, nV, VectorialValue(0, 0, 0));
+	if (posOrientation==0){
+		posOrientation = addOrientation(OrientationCoordinateSystem(*this, nO, nX, nV));
+	}
+	return posOrientation;
+}
+
+int Model::addOrFindOrientation(int nO, int nX, const VectorialValue& v){
+	int posOrientation = findOrientation(nO, nX, Node::UNAVAILABLE_NODE, v.normalized());
+	if (posOrientation==0){
+		posOrientation = addOrientation(OrientationCoordinateSystem(*this, nO, nX, v));
 	}
 	return posOrientation;
 }
 
+int Model::addOrientation(const OrientationCoordinateSystem & ocs){
+	this->add(ocs);
+	const int posOrientation = coordinateSystemStorage->findPositionById(ocs.getId());
+	orientationsByNodes[make_pair(make_pair(ocs.getNodeO(), ocs.getNodeX()), ocs.getNodeV())].push_back(
+			make_pair(posOrientation, ocs.getV()));
+	return posOrientation;
+}
+
 int Model::findOrientation(const OrientationCoordinateSystem & ocs) const{
-	int posOrientation=0;
-	for (shared_ptr<CoordinateSystem> coordinateSystem : coordinateSystems) {
-		if (coordinateSystem->type==CoordinateSystem::Type::ORIENTATION){
-			std::shared_ptr<OrientationCoordinateSystem> mocs = std::static_pointer_cast<OrientationCoordinateSystem>(coordinateSystem);
-			if (ocs == *mocs){
-				posOrientation = coordinateSystemStorage->findPositionById(mocs->getId());
-				break;
-			}
+	return findOrientation(ocs.getNodeO(), ocs.getNodeX(), ocs.getNodeV(), ocs.getV());
+}
+
+int Model::findOrientation(int nodeO, int nodeX, int nodeV, const VectorialValue& v) const{
+	auto it = orientationsByNodes.find(make_pair(make_pair(nodeO, nodeX), nodeV));
+	if (it == orientationsByNodes.end()) {
+		return 0;
+	}
+	if (nodeV != Node::UNAVAILABLE_NODE) {
+		return it->second.front().first;
+	}
+	// same comparison as OrientationCoordinateSystem::operator==
+	for (const auto& positionAndV : it->second) {
+		if (is_equal((v - positionAndV.second).norm(), 0)) {
+			return positionAndV.first;
 		}
 	}
-	return posOrientation;
+	return 0;
 }
 
 std::shared_ptr<vega::CoordinateSystem> Model::getCoordinateSystemByPosition(const int pos) const{
@@ -408,7 +449,14 @@ const shared_ptr<Objective> Model::find(const Reference<Objective> reference) co
 
 template<>
 const shared_ptr<Value> Model::find(const Reference<Value> reference) const {
-    return values.find(reference);
+    shared_ptr<Value> value = values.find(reference);
+    if (!value) {
+        auto it = internedValues.find(reference);
+        if (it != internedValues.end()) {
+            value = it->second;
+        }
+    }
+    return value;
 }
 
 template<>
@@ -791,6 +839,26 @@ const vector<shared_ptr<Beam>> Model::getBeams() const {
 
 
 void Model::generateSkin() {
+    // skin cells already generated, by sorted face node ids: a face loaded several times gets a single cell
+    unordered_map<vector<int>, int, boost::hash<vector<int>>> skinCellIdByFace;
+    // all the skin cells, modeled by a single continuum
+    CellGroup* skinGroup = nullptr;
+    // load sets of each loading: the face forces merged together must be applied by the same ones
+    unordered_map<const Loading*, vector<int>> loadSetIdsByLoading;
+    for (const auto& loadSet : loadSets) {
+        for (const auto& loading : getLoadingsByLoadSet(loadSet->getReference())) {
+            loadSetIdsByLoading[loading.get()].push_back(loadSet->getId());
+        }
+    }
+    // the face forces of the same load sets, coordinate system and values are merged into a
+    // single loading, applied to a group of their skin cells. A face loaded twice goes into
+    // another group, not to lose the second force.
+    struct SkinLoading {
+        shared_ptr<ForceSurface> forceSurface;
+        CellGroup* group;
+    };
+    map<tuple<vector<int>, Reference<CoordinateSystem>, vector<double>>, vector<SkinLoading>> skinLoadingsByKey;
+    unordered_set<Reference<Loading>> mergedLoadings;
     for (Container<Loading>::iterator it = loadings.begin(); it != loadings.end(); it++) {
         shared_ptr<Loading> loadingPtr = *it;
         if (loadingPtr->applicationType == Loading::ELEMENT) {
@@ -803,19 +871,45 @@ void Model::generateSkin() {
                             loadingPtr);
                     vector<int> faceIds = forceSurface->getApplicationFace();
                     if (faceIds.size() > 0) {
-                        vega::Cell cell = generateSkinCell(faceIds, SpaceDimension::DIMENSION_2D);
-                        // LD : Workaround for MED name problems, adding single cell groups
-                        CellGroup* mappl = this->mesh->createCellGroup(
-                                "C" + boost::lexical_cast<string>(cell.id));
-                        mappl->addCell(cell.id);
-                        forceSurface->clear();
-                        forceSurface->add(*mappl);
-                        // LD : Workaround for Aster problem : MODELISA6_96
-                        //  les 1 mailles imprimées ci-dessus n'appartiennent pas au modèle et pourtant elles ont été affectées dans le mot-clé facteur : !
-                        //   ! FORCE_FACE
-                        Continuum continuum(*this, &ModelType::TRIDIMENSIONAL_SI);
-                        continuum.assignCellGroup(mappl);
-                        this->add(continuum);
+                        vector<int> faceKey(faceIds);
+                        sort(faceKey.begin(), faceKey.end());
+                        auto skinCellIt = skinCellIdByFace.find(faceKey);
+                        int cellId;
+                        if (skinCellIt == skinCellIdByFace.end()) {
+                            cellId = generateSkinCell(faceIds, SpaceDimension::DIMENSION_2D).id;
+                            skinCellIdByFace[faceKey] = cellId;
+                            if (skinGroup == nullptr) {
+                                skinGroup = mesh->createCellGroup("VSkin", CellGroup::NO_ORIGINAL_ID, "Skin");
+                            }
+                            skinGroup->addCell(cellId);
+                        } else {
+                            cellId = skinCellIt->second;
+                        }
+                        vector<int> loadSetIds = loadSetIdsByLoading[loadingPtr.get()];
+                        sort(loadSetIds.begin(), loadSetIds.end());
+                        const VectorialValue force = forceSurface->getForce();
+                        const VectorialValue moment = forceSurface->getMoment();
+                        vector<SkinLoading>& skinLoadings = skinLoadingsByKey[make_tuple(loadSetIds,
+                                forceSurface->coordinateSystem_reference,
+                                vector<double>({ force.x(), force.y(), force.z(), moment.x(),
+                                        moment.y(), moment.z() }))];
+                        auto skinLoadingIt = find_if(skinLoadings.begin(), skinLoadings.end(),
+                                [cellId](const SkinLoading& skinLoading) {
+                                    return skinLoading.group->cellIds.find(cellId)
+                                            == skinLoading.group->cellIds.end();
+                                });
+                        if (skinLoadingIt == skinLoadings.end()) {
+                            // LD : Workaround for MED name problems, adding a group named after the loading
+                            CellGroup* group = this->mesh->createCellGroup(
+                                    "SKIN" + boost::lexical_cast<string>(forceSurface->getId()));
+                            forceSurface->clear();
+                            forceSurface->add(*group);
+                            skinLoadings.push_back({ forceSurface, group });
+                            skinLoadingIt = skinLoadings.end() - 1;
+                        } else {
+                            mergedLoadings.insert(Reference<Loading>(*forceSurface));
+                        }
+                        skinLoadingIt->group->addCell(cellId);
                     }
                 }
                     break;
@@ -825,7 +919,41 @@ void Model::generateSkin() {
             }
         }
     }
+    removeLoadings(mergedLoadings);
+    if (skinGroup != nullptr) {
+        // LD : Workaround for Aster problem : MODELISA6_96
+        //  les 1 mailles imprimées ci-dessus n'appartiennent pas au modèle et pourtant elles ont été affectées dans le mot-clé facteur : !
+        //   ! FORCE_FACE
+        Continuum continuum(*this, &ModelType::TRIDIMENSIONAL_SI);
+        continuum.assignCellGroup(skinGroup);
+        this->add(continuum);
+    }
+}
 
+void Model::removeLoadings(const unordered_set<Reference<Loading>>& loadingReferences) {
+    if (loadingReferences.empty()) {
+        return;
+    }
+    auto removed = [&loadingReferences](const shared_ptr<Reference<Loading>>& reference) {
+        return loadingReferences.find(*reference) != loadingReferences.end();
+    };
+    for (auto& loadSetIdAndReferences : loadingReferences_by_loadSet_ids) {
+        auto& references = loadSetIdAndReferences.second;
+        for (auto it = references.begin(); it != references.end();) {
+            it = removed(*it) ? references.erase(it) : next(it);
+        }
+    }
+    for (auto& typeAndMap : loadingReferences_by_loadSet_original_ids_by_loadSet_type) {
+        for (auto& originalIdAndReferences : typeAndMap.second) {
+            auto& references = originalIdAndReferences.second;
+            for (auto it = references.begin(); it != references.end();) {
+                it = removed(*it) ? references.erase(it) : next(it);
+            }
+        }
+    }
+    for (const auto& loadingReference : loadingReferences) {
+        loadings.erase(loadingReference);
+    }
 }
 
 Cell Model::generateSkinCell(const vector<int>& faceIds, const SpaceDimension& dimension) {
@@ -897,7 +1025,7 @@ void Model::emulateLocalDisplacementConstraint() {
             }
             delete linearMultiplePointConstraint;
         }
-        if (constraint->nodePositions().size() == 0)
+        if (constraint->nodePositions().empty())
             remove(constraint->getReference());
     }
 }
@@ -1018,6 +1146,80 @@ void Model::generateMaterialAssignments() {
     }
 }
 
+void Model::internValues() {
+    unordered_map<vector<double>, shared_ptr<Value>, boost::hash<vector<double>>> tableByPayload;
+    vector<pair<shared_ptr<Value>, shared_ptr<Value>>> duplicates;
+    for (shared_ptr<Value> value : values) {
+        shared_ptr<FunctionTable> functionTable = dynamic_pointer_cast<FunctionTable>(value);
+        if (functionTable == nullptr) {
+            continue;
+        }
+        auto inserted = tableByPayload.insert(make_pair(functionTable->getPayload(), value));
+        if (!inserted.second) {
+            duplicates.push_back(make_pair(value, inserted.first->second));
+        }
+    }
+    for (const auto& duplicate : duplicates) {
+        const Value& value = *duplicate.first;
+        if (configuration.logLevel >= LogLevel::DEBUG) {
+            cout << "Replacing " << value << " by identical " << *duplicate.second << endl;
+        }
+        values.erase(value.getReference());
+        internedValues[Reference<Value>(value.type, Reference<Value>::NO_ID, value.getId())] =
+                duplicate.second;
+        internedValuesById[value.getId()] = duplicate.second;
+        if (value.isOriginal()) {
+            internedValues[Reference<Value>(value.type, value.getOriginalId())] = duplicate.second;
+        }
+    }
+}
+
+void Model::internMaterials() {
+    unordered_map<vector<double>, shared_ptr<Material>, boost::hash<vector<double>>> materialByPayload;
+    map<int, shared_ptr<Material>> representativeById;
+    for (shared_ptr<Material> material : materials) {
+        const vector<double> payload = material->getPayload();
+        if (payload.empty()) {
+            // no nature: invalid, left to validate()
+            continue;
+        }
+        auto inserted = materialByPayload.insert(make_pair(payload, material));
+        if (!inserted.second) {
+            representativeById[material->getId()] = inserted.first->second;
+        }
+    }
+    if (representativeById.empty()) {
+        return;
+    }
+    for (shared_ptr<ElementSet> elementSet : elementSets) {
+        if (elementSet->material) {
+            auto it = representativeById.find(elementSet->material->getId());
+            if (it != representativeById.end()) {
+                elementSet->assignMaterial(it->second);
+            }
+        }
+    }
+    if (virtualMaterial) {
+        auto it = representativeById.find(virtualMaterial->getId());
+        if (it != representativeById.end()) {
+            virtualMaterial = it->second;
+        }
+    }
+    for (const auto& duplicate : representativeById) {
+        auto it = material_assignment_by_material_id.find(duplicate.first);
+        if (it != material_assignment_by_material_id.end()) {
+            const CellContainer assignment = it->second;
+            material_assignment_by_material_id.erase(it);
+            assignMaterial(duplicate.second->getId(), assignment);
+        }
+        shared_ptr<Material> material = materials.get(duplicate.first);
+        if (configuration.logLevel >= LogLevel::DEBUG) {
+            cout << "Replacing " << *material << " by identical " << *duplicate.second << endl;
+        }
+        materials.erase(material->getReference());
+    }
+}
+
 void Model::removeIneffectives() {
     // remove ineffective loadings from the model
     vector<shared_ptr<Loading>> loadingsToRemove;
@@ -1108,26 +1310,35 @@ void Model::replaceCombinedLoadSets() {
 
 void Model::removeAssertionsMissingDOFS()
 {
-    vector<shared_ptr<Objective> > objectivesToRemove;
+    vector<shared_ptr<Analysis>> allAnalyses;
     for (auto& analysis : analyses) {
-        for(auto& assertion : analysis->getAssertions()) {
-            for(int nodePosition: assertion->nodePositions()) {
-                DOFS assertionDOFS = assertion->getDOFSForNode(nodePosition);
-                if (assertionDOFS.size() >= 1) {
-                    Node node = mesh->findNode(nodePosition);
-                    DOFS availableDOFS = node.dofs + analysis->findBoundaryDOFS(nodePosition);
-                    if (!availableDOFS.containsAll(assertionDOFS)) {
-                        objectivesToRemove.push_back(assertion);
+        allAnalyses.push_back(analysis);
+    }
+    vector<vector<shared_ptr<Objective>>> objectivesToRemoveByAnalysis(allAnalyses.size());
+    parallelFor(allAnalyses.size(), [this, &allAnalyses, &objectivesToRemoveByAnalysis](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const shared_ptr<Analysis>& analysis = allAnalyses[i];
+            for(auto& assertion : analysis->getAssertions()) {
+                for(int nodePosition: assertion->nodePositions()) {
+                    DOFS assertionDOFS = assertion->getDOFSForNode(nodePosition);
+                    if (assertionDOFS.size() >= 1) {
+                        Node node = mesh->findNode(nodePosition);
+                        DOFS availableDOFS = node.dofs + analysis->findBoundaryDOFS(nodePosition);
+                        if (!availableDOFS.containsAll(assertionDOFS)) {
+                            objectivesToRemoveByAnalysis[i].push_back(assertion);
+                        }
                     }
                 }
             }
         }
-    }
-    for (auto objective : objectivesToRemove) {
-        if (configuration.logLevel >= LogLevel::TRACE)
-            cout << "Removed ineffective " << *objective << endl;
+    });
+    for (const auto& objectivesToRemove : objectivesToRemoveByAnalysis) {
+        for (auto objective : objectivesToRemove) {
+            if (configuration.logLevel >= LogLevel::TRACE)
+                cout << "Removed ineffective " << *objective << endl;
 
-        remove(Reference<Objective>(*objective));
+            remove(Reference<Objective>(*objective));
+        }
     }
 }
 
@@ -1187,9 +1398,9 @@ void Model::replaceDirectMatrices()
                 int nodePosition = pair.first;
                 Node node = mesh->findNode(nodePosition);
                 DOFS requiredDofs = requiredDofsByNode.find(nodePosition)->second;
-                shared_ptr<DOFMatrix> submatrix = matrix->findSubmatrix(nodePosition, nodePosition);
+                const DOFBlock submatrix = matrix->findSubmatrix(nodePosition, nodePosition);
                 DiscretePoint discrete(*this, {});
-                for (auto& kv : submatrix->componentByDofs) {
+                for (const auto& kv : submatrix) {
                     double value = kv.second;
                     const vega::DOF dof1 = kv.first.first;
                     const vega::DOF dof2 = kv.first.second;
@@ -1265,9 +1476,9 @@ void Model::replaceDirectMatrices()
                         } else {
                             colNodePosition = colNode.position;
                         }
-                        shared_ptr<DOFMatrix> submatrix = matrix->findSubmatrix(rowNodePosition,
+                        const DOFBlock submatrix = matrix->findSubmatrix(rowNodePosition,
                                 colNodePosition);
-                        for (auto& kv : submatrix->componentByDofs) {
+                        for (const auto& kv : submatrix) {
                             // We are disassembling the matrix, so we must divide the value by the segments
                             double value = kv.second / static_cast<int>(matrix->findInPairs(pair.first).size());
                             const DOF rowDof = kv.first.first;
@@ -1296,6 +1507,22 @@ void Model::replaceDirectMatrices()
         }
         elementSetsToRemove.push_back(elementSetM);
     }
+    // the DOFs required by the loadings and the nodes of the constraints do not depend on
+    // the node: they are computed once
+    DOFS requiredByLoadings;
+    if (!addedDofsByNode.empty()) {
+        for (const auto loading : loadings) {
+            for (int nodePosition : loading->nodePositions()) {
+                requiredByLoadings += loading->getDOFSForNode(nodePosition);
+            }
+        }
+    }
+    vector<pair<shared_ptr<Constraint>, NodeSet>> constraintsWithNodes;
+    if (!addedDofsByNode.empty()) {
+        for (const auto constraint : constraints) {
+            constraintsWithNodes.push_back(make_pair(constraint, constraint->nodePositions()));
+        }
+    }
     for (auto& kv : addedDofsByNode) {
         int nodePosition = kv.first;
         Node node = this->mesh->findNode(nodePosition);
@@ -1316,17 +1543,12 @@ void Model::replaceDirectMatrices()
             owned = it2->second;
         }
 
-        for (const auto loading : loadings) {
-            for (int nodePosition : loading->nodePositions()) {
-                required += loading->getDOFSForNode(nodePosition);
-            }
-        }
-        for (const auto constraint : constraints) {
-            set<int> constraintNodes = constraint->nodePositions();
-            if (constraintNodes.find(nodePosition) == constraintNodes.end()) {
+        required += requiredByLoadings;
+        for (const auto& constraintAndNodes : constraintsWithNodes) {
+            if (!constraintAndNodes.second.contains(nodePosition)) {
                 continue;
             }
-            required += constraint->getDOFSForNode(nodePosition);
+            required += constraintAndNodes.first->getDOFSForNode(nodePosition);
         }
         DOFS extra = added - owned - required;
         if (extra != DOFS::NO_DOFS) {
@@ -1348,51 +1570,110 @@ void Model::replaceDirectMatrices()
     }
 }
 
-void Model::removeRedundantSpcs()
-{
-    for (auto analysis : this->analyses) {
-        std::unordered_map<std::pair<int, DOF>, double, boost::hash<std::pair<int, int> > > spcvalueByNodeAndDof;
-        for (const auto& constraintSet : analysis->getConstraintSets()) {
-            const set<shared_ptr<Constraint> > spcs = constraintSet->getConstraintsByType(
-                    Constraint::SPC);
-            if (spcs.size() == 0) {
-                continue;
+namespace {
+
+/**
+ * Values imposed by SPCs, in flat arrays with one slot by (node, DOF). Only the nodes given
+ * to the constructor have slots: they are found by their rank in the NodeSet.
+ */
+class SpcValues final {
+private:
+    const NodeSet nodePositions;
+    vector<double> values;
+    vector<uint8_t> imposedDofs;
+public:
+    explicit SpcValues(const NodeSet& nodePositions) :
+            nodePositions(nodePositions), values(nodePositions.size() * 6, 0.0), imposedDofs(
+                    nodePositions.size(), 0) {
+    }
+    /**
+     * Records the value imposed on the DOF of the node, if it is the first one.
+     * @return false if the DOF had no value yet, else true and the previous value.
+     */
+    bool record(int nodePosition, const DOF& dof, double value, double& previousValue) {
+        const size_t rank = static_cast<size_t>(nodePositions.find(nodePosition) - nodePositions.begin());
+        const uint8_t dofMask = static_cast<uint8_t>(1 << dof.position);
+        double& slot = values[rank * 6 + static_cast<size_t>(dof.position)];
+        if ((imposedDofs[rank] & dofMask) != 0) {
+            previousValue = slot;
+            return true;
+        }
+        imposedDofs[rank] = static_cast<uint8_t>(imposedDofs[rank] | dofMask);
+        slot = value;
+        return false;
+    }
+};
+
+} /* namespace */
+
+bool Model::removeRedundantSpcs(Analysis& analysis, bool dryRun) {
+    vector<shared_ptr<SinglePointConstraint>> spcs;
+    NodeSet spcNodePositions;
+    for (const auto& constraintSet : analysis.getConstraintSets()) {
+        for (shared_ptr<Constraint> constraint : constraintSet->getConstraintsByType(Constraint::SPC)) {
+            spcs.push_back(static_pointer_cast<SinglePointConstraint>(constraint));
+            spcNodePositions.insert(spcs.back()->nodePositions());
+        }
+    }
+    SpcValues spcValues(spcNodePositions);
+    bool hasRedundantSpcs = false;
+    for (const auto& spc : spcs) {
+        for (int nodePosition : spc->nodePositions()) {
+            DOFS dofsToRemove;
+            DOFS blockedDofs = spc->getDOFSForNode(nodePosition);
+            for (const DOF dof : blockedDofs) {
+                double spcValue = spc->getDoubleForDOF(dof);
+                double previousValue;
+                if (!spcValues.record(nodePosition, dof, spcValue, previousValue)) {
+                    continue;
+                }
+                if (!is_equal(spcValue, previousValue)) {
+                    Node node = this->mesh->findNode(nodePosition);
+                    throw logic_error(
+                            "In analysis : " + to_str(analysis) + ", spc : " + to_str(*spc)
+                                    + " value : " + to_string(spcValue)
+                                    + " different by other spc value : "
+                                    + to_string(previousValue) + " on same node id : "
+                                    + to_string(node.id) + " and dof : " + dof.label);
+                }
+                dofsToRemove = dofsToRemove + dof;
             }
-            for (shared_ptr<Constraint> constraint : spcs) {
-                shared_ptr<SinglePointConstraint> spc = static_pointer_cast<SinglePointConstraint>(
-                        constraint);
-                for (int nodePosition : spc->nodePositions()) {
-                    DOFS dofsToRemove;
-                    DOFS blockedDofs = spc->getDOFSForNode(nodePosition);
-                    for (const DOF dof : blockedDofs) {
-                        pair<int, DOF> key = make_pair(nodePosition, dof);
-                        double spcValue = spc->getDoubleForDOF(dof);
-                        auto entry = spcvalueByNodeAndDof.find(key);
-                        if (entry == spcvalueByNodeAndDof.end()) {
-                            spcvalueByNodeAndDof[key] = spcValue;
-                        } else if (!is_equal(spcValue, entry->second)) {
-                            Node node = this->mesh->findNode(nodePosition);
-                            throw logic_error(
-                                    "In analysis : " + to_str(*analysis) + ", spc : " + to_str(*spc)
-                                            + " value : " + to_string(spcValue)
-                                            + " different by other spc value : "
-                                            + to_string(entry->second) + " on same node id : "
-                                            + to_string(node.id) + " and dof : " + dof.label);
-                        } else {
-                            dofsToRemove = dofsToRemove + dof;
-                        }
-                    }
-                    if (dofsToRemove.size() >= 1) {
-                        analysis->removeSPCNodeDofs(*spc, nodePosition, dofsToRemove);
-                        if (configuration.logLevel >= LogLevel::DEBUG) {
-                            cout << "Removed redundant node position : " << nodePosition
-                                    << " from spc : " << *spc << " for analysis : " << *analysis << endl;
-                        }
-                    }
+            if (dofsToRemove.size() >= 1) {
+                hasRedundantSpcs = true;
+                if (dryRun) {
+                    continue;
+                }
+                analysis.removeSPCNodeDofs(*spc, nodePosition, dofsToRemove);
+                if (configuration.logLevel >= LogLevel::DEBUG) {
+                    cout << "Removed redundant node position : " << nodePosition
+                            << " from spc : " << *spc << " for analysis : " << analysis << endl;
                 }
             }
         }
     }
+    return hasRedundantSpcs;
+}
+
+void Model::removeRedundantSpcs()
+{
+    vector<shared_ptr<Analysis>> allAnalyses;
+    for (auto analysis : this->analyses) {
+        allAnalyses.push_back(analysis);
+    }
+    // The analyses are first checked in parallel: removing the redundant SPCs of an analysis
+    // changes the constraint sets of the others, but not the values imposed on their DOFs, so
+    // an analysis without redundant SPCs keeps none.
+    vector<char> hasRedundantSpcs(allAnalyses.size(), 0);
+    parallelFor(allAnalyses.size(), [this, &allAnalyses, &hasRedundantSpcs](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            hasRedundantSpcs[i] = removeRedundantSpcs(*allAnalyses[i], true) ? 1 : 0;
+        }
+    });
+    for (size_t i = 0; i < allAnalyses.size(); i++) {
+        if (hasRedundantSpcs[i] != 0) {
+            removeRedundantSpcs(*allAnalyses[i], false);
+        }
+    }
 }
 
 
@@ -1488,8 +1769,8 @@ void Model::splitDirectMatrices(const unsigned int sizeMax){
 
             // We copy the values
             shared_ptr<MatrixElement> nM = static_pointer_cast<MatrixElement>(newElementSet);
-            shared_ptr<DOFMatrix> dM = matrix->findSubmatrix(np.first, np.second);
-            for (const auto dof: dM->componentByDofs){
+            const DOFBlock dM = matrix->findSubmatrix(np.first, np.second);
+            for (const auto dof: dM){
                 nM->addComponent(nodeIdOfElement[np.first], dof.first.first, nodeIdOfElement[np.second], dof.first.second, dof.second);
             }
 
@@ -1795,6 +2076,50 @@ void Model::makeCellsFromRBE(){
 }
 
 
+void Model::addBoundaryDOFS() {
+    vector<shared_ptr<Analysis>> allAnalyses;
+    vector<vector<shared_ptr<BoundaryCondition>>> boundaryConditionsByAnalysis;
+    unordered_map<const BoundaryCondition*, size_t> analysisCountByBoundaryCondition;
+    for (shared_ptr<Analysis> analysis : analyses) {
+        allAnalyses.push_back(analysis);
+        boundaryConditionsByAnalysis.push_back(analysis->getBoundaryConditions());
+        unordered_set<const BoundaryCondition*> counted;
+        for (const auto& boundaryCondition : boundaryConditionsByAnalysis.back()) {
+            if (counted.insert(boundaryCondition.get()).second) {
+                analysisCountByBoundaryCondition[boundaryCondition.get()]++;
+            }
+        }
+    }
+    auto isCommon = [&analysisCountByBoundaryCondition, &allAnalyses](
+            const shared_ptr<BoundaryCondition>& boundaryCondition) {
+        return analysisCountByBoundaryCondition[boundaryCondition.get()] == allAnalyses.size();
+    };
+    vector<shared_ptr<BoundaryCondition>> commonBoundaryConditions;
+    vector<NodeSet> commonNodeSets;
+    if (!allAnalyses.empty()) {
+        for (const auto& boundaryCondition : boundaryConditionsByAnalysis.front()) {
+            if (isCommon(boundaryCondition)) {
+                commonBoundaryConditions.push_back(boundaryCondition);
+                commonNodeSets.push_back(boundaryCondition->nodePositions());
+            }
+        }
+    }
+    commonBoundaryDOFS.clear();
+    commonBoundaryDOFS.resize(static_cast<size_t>(mesh->countNodes()));
+    commonBoundaryDOFS.allowAll(commonNodeSets, [&commonBoundaryConditions](size_t i, int nodePosition) {
+        return commonBoundaryConditions[i]->getDOFSForNode(nodePosition);
+    });
+    for (size_t i = 0; i < allAnalyses.size(); i++) {
+        vector<shared_ptr<BoundaryCondition>> specificBoundaryConditions;
+        for (const auto& boundaryCondition : boundaryConditionsByAnalysis[i]) {
+            if (!isCommon(boundaryCondition)) {
+                specificBoundaryConditions.push_back(boundaryCondition);
+            }
+        }
+        allAnalyses[i]->addBoundaryDOFS(specificBoundaryConditions);
+    }
+}
+
 void Model::finish() {
     if (finished) {
         return;
@@ -1805,19 +2130,18 @@ void Model::finish() {
         coordinateSystem->build();
     }
 
+    vector<shared_ptr<ElementSet>> allElementSets;
+    vector<NodeSet> elementSetNodes;
     for (shared_ptr<ElementSet> elementSet : elementSets) {
-        for (int nodePosition : elementSet->nodePositions()) {
-            mesh->allowDOFS(nodePosition,elementSet->getDOFSForNode(nodePosition));
-        }
-    }
-    for (shared_ptr<Analysis> analysis : analyses) {
-        for (const auto& boundaryCondition : analysis->getBoundaryConditions()) {
-            for(int nodePosition: boundaryCondition->nodePositions()) {
-                analysis->addBoundaryDOFS(nodePosition,
-                        boundaryCondition->getDOFSForNode(nodePosition));
-            }
-        }
+        allElementSets.push_back(elementSet);
+        elementSetNodes.push_back(elementSet->nodePositions());
     }
+    DOFMasks allowedDOFS(static_cast<size_t>(mesh->countNodes()));
+    allowedDOFS.allowAll(elementSetNodes, [&allElementSets](size_t i, int nodePosition) {
+        return allElementSets[i]->getDOFSForNode(nodePosition);
+    });
+    mesh->allowDOFS(allowedDOFS);
+    addBoundaryDOFS();
 
     removeAssertionsMissingDOFS();
 
@@ -1868,6 +2192,11 @@ void Model::finish() {
         makeCellsFromRBE();
     }
 
+    if (this->configuration.mergeIdenticalDefinitions) {
+        internValues();
+        internMaterials();
+    }
+
     assignElementsToCells();
     generateMaterialAssignments();
     addDefaultAnalysis();
@@ -23,6 +23,7 @@
 #include "Objective.h"
 #include "Reference.h"
 #include <string>
+#include <unordered_set>
 
 namespace vega {
 
@@ -50,7 +51,33 @@ private:
      * @see ConfigurationParameters.partitionModel
      */
     void generateMaterialAssignments();
+    /**
+     * Function tables removed by internValues(), by the references they could be found with,
+     * and the identical table that replaces each of them.
+     */
+    std::map<Reference<Value>, std::shared_ptr<Value>> internedValues;
+    /**
+     * The same replacements, by the Vega id of the removed table.
+     */
+    std::map<int, std::shared_ptr<Value>> internedValuesById;
+    /**
+     * Keep a single function table for each payload: the duplicates are removed from the model,
+     * the references to them now find the first identical table.
+     * @see FunctionTable::getPayload()
+     */
+    void internValues();
+    /**
+     * Keep a single material for each payload: the ElementSets and the cells assigned to a
+     * duplicate are assigned to the first identical material, and the duplicate is removed.
+     * Must run after internValues(), to merge materials using identical tables.
+     * @see Material::getPayload()
+     */
+    void internMaterials();
     Cell generateSkinCell(const vector<int>& faceIds, const SpaceDimension& dimension);
+    /**
+     * Removes the loadings from the model and from their load sets, in a single pass.
+     */
+    void removeLoadings(const std::unordered_set<Reference<Loading>>& loadingReferences);
     void removeIneffectives();
     void replaceCombinedLoadSets();
     /**
@@ -59,9 +86,21 @@ private:
      */
     void assignElementsToCells();
     void removeAssertionsMissingDOFS();
+    /**
+     * Computes the DOFs used by the boundary conditions: the ones shared by every analysis
+     * go into commonBoundaryDOFS, each analysis only keeps the DOFs of its own ones.
+     */
+    void addBoundaryDOFS();
     void addDefaultAnalysis();
     void replaceDirectMatrices();
     void removeRedundantSpcs();
+    /**
+     * Removes from the SPCs of the analysis the DOFs already imposed, with the same value, by
+     * another SPC. Throws if two SPCs impose different values on the same DOF.
+     * @param dryRun: if true, only checks the SPCs and leaves them untouched.
+     * @return true if there are redundant SPCs.
+     */
+    bool removeRedundantSpcs(Analysis& analysis, bool dryRun);
     /**
      * Split all direct matrices whose sizes is greater than sizeMax into smaller matrices.
      * All data is kept, just divided into various elements.
@@ -100,6 +139,11 @@ public:
     };
     const LoadSet commonLoadSet;
     const ConstraintSet commonConstraintSet;
+    /**
+     * DOFs used on each node by the boundary conditions common to all the analyses.
+     * @see Analysis::findBoundaryDOFS
+     */
+    DOFMasks commonBoundaryDOFS;
 
 private:
     std::unordered_map<LoadSet::Type, map<int, set<std::shared_ptr<Reference<Loading>>> > ,hash<int>>
@@ -167,6 +211,14 @@ private:
                     };
                 };
         std::unordered_map<int,CellContainer> material_assignment_by_material_id;
+        /**
+         * Positions and orientation vectors of the Orientation Coordinate Systems, by their
+         * (O, X, V) node ids: only the systems sharing these nodes need to be compared.
+         */
+        std::unordered_map<std::pair<std::pair<int, int>, int>, std::vector<std::pair<int, VectorialValue>>,
+                boost::hash<std::pair<std::pair<int, int>, int>>> orientationsByNodes;
+        int findOrientation(int nodeO, int nodeX, int nodeV, const VectorialValue& v) const;
+        int addOrientation(const OrientationCoordinateSystem& ocs);
     public:
         Container<Analysis> analyses;
         Container<Objective> objectives;
@@ -228,6 +280,16 @@ private:
          * Return the Position of the Orientation Coordinate System.
          */
         int addOrFindOrientation(const OrientationCoordinateSystem & ocs);
+        /**
+         * Add or Find the Orientation Coordinate System of a beam from nO to nX, oriented by node nV.
+         * The system is only built if not found.
+         */
+        int addOrFindOrientation(int nO, int nX, int nV);
+        /**
+         * Add or Find the Orientation Coordinate System of a beam from nO to nX, oriented by vector v.
+         * The system is only built if not found.
+         */
+        int addOrFindOrientation(int nO, int nX, const VectorialValue& v);
         /**
          * Find an Orientation Coordinate System in the model, by checking its axis.
          * Return 0 if nothing has been found.
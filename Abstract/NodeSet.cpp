@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * NodeSet.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "NodeSet.h"
+#include <iterator>
+
+namespace vega {
+
+using namespace std;
+
+NodeSet::NodeSet(initializer_list<int> positions) {
+	insert(positions.begin(), positions.end());
+}
+
+NodeSet::const_iterator NodeSet::find(int position) const {
+	auto it = lower_bound(positions.begin(), positions.end(), position);
+	return (it != positions.end() && *it == position) ? it : positions.end();
+}
+
+bool NodeSet::contains(int position) const {
+	return binary_search(positions.begin(), positions.end(), position);
+}
+
+void NodeSet::reserve(size_t capacity) {
+	positions.reserve(capacity);
+}
+
+bool NodeSet::insert(int position) {
+	if (positions.empty() || positions.back() < position) {
+		positions.push_back(position);
+		return true;
+	}
+	auto it = lower_bound(positions.begin(), positions.end(), position);
+	if (*it == position) {
+		return false;
+	}
+	positions.insert(it, position);
+	return true;
+}
+
+void NodeSet::insert(const NodeSet& other) {
+	if (other.positions.empty()) {
+		return;
+	}
+	if (positions.empty() || positions.back() < other.positions.front()) {
+		positions.insert(positions.end(), other.positions.begin(), other.positions.end());
+		return;
+	}
+	vector<int> merged;
+	merged.reserve(positions.size() + other.positions.size());
+	set_union(positions.begin(), positions.end(), other.positions.begin(), other.positions.end(),
+			back_inserter(merged));
+	positions.swap(merged);
+}
+
+size_t NodeSet::erase(int position) {
+	auto it = lower_bound(positions.begin(), positions.end(), position);
+	if (it == positions.end() || *it != position) {
+		return 0;
+	}
+	positions.erase(it);
+	return 1;
+}
+
+void NodeSet::clear() {
+	positions.clear();
+}
+
+void NodeSet::normalizeFrom(size_t previousSize) {
+	const auto middle = positions.begin() + static_cast<ptrdiff_t>(previousSize);
+	if (!is_sorted(middle, positions.end())) {
+		sort(middle, positions.end());
+	}
+	if (middle != positions.begin() && middle != positions.end() && *middle < *(middle - 1)) {
+		inplace_merge(positions.begin(), middle, positions.end());
+	}
+	positions.erase(unique(positions.begin(), positions.end()), positions.end());
+}
+
+} /* namespace vega */
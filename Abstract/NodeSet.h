@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * NodeSet.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef NODESET_H_
+#define NODESET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace vega {
+
+/**
+ * Set of node positions, stored as a sorted vector without duplicates. Iteration is in
+ * increasing order, as with a std::set<int>, but the positions are contiguous in memory:
+ * copying, merging and walking a set of a million nodes costs a few megabytes and no
+ * allocation per node.
+ *
+ * Inserting positions in increasing order is an append. Inserting a whole range at once
+ * (insert(begin, end)) sorts only once: prefer it to repeated insertions in random order.
+ */
+class NodeSet final {
+private:
+	std::vector<int> positions;
+public:
+	typedef std::vector<int>::const_iterator const_iterator;
+	typedef const_iterator iterator;
+	typedef int value_type;
+
+	NodeSet() = default;
+	NodeSet(std::initializer_list<int> positions);
+	template<typename InputIterator>
+	NodeSet(InputIterator begin, InputIterator end) {
+		insert(begin, end);
+	}
+
+	const_iterator begin() const {
+		return positions.begin();
+	}
+	const_iterator end() const {
+		return positions.end();
+	}
+	std::size_t size() const {
+		return positions.size();
+	}
+	bool empty() const {
+		return positions.empty();
+	}
+	/**
+	 * @return an iterator on the position, or end() if it is not in the set.
+	 */
+	const_iterator find(int position) const;
+	bool contains(int position) const;
+	std::size_t count(int position) const {
+		return contains(position) ? 1 : 0;
+	}
+
+	void reserve(std::size_t capacity);
+	/**
+	 * @return true if the position has been added, false if it was already present.
+	 */
+	bool insert(int position);
+	template<typename InputIterator>
+	void insert(InputIterator begin, InputIterator end) {
+		const std::size_t previousSize = positions.size();
+		positions.insert(positions.end(), begin, end);
+		normalizeFrom(previousSize);
+	}
+	void insert(const NodeSet& other);
+	/**
+	 * @return the number of positions removed (0 or 1).
+	 */
+	std::size_t erase(int position);
+	void clear();
+
+	bool operator==(const NodeSet& other) const {
+		return positions == other.positions;
+	}
+	bool operator!=(const NodeSet& other) const {
+		return positions != other.positions;
+	}
+private:
+	/**
+	 * Sorts the positions appended after the first previousSize ones, merges them with the
+	 * (already sorted) beginning and removes the duplicates.
+	 */
+	void normalizeFrom(std::size_t previousSize);
+};
+
+} /* namespace vega */
+
+#endif /* NODESET_H_ */
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * NumberFormat.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "NumberFormat.h"
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace vega {
+
+using namespace std;
+
+namespace {
+
+const double POWERS_OF_TEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+		1e13, 1e14, 1e15, 1e16, 1e17 };
+
+/**
+ * Exact comparison, without triggering -Wfloat-equal: used to check round trips.
+ */
+inline bool sameDouble(double x, double y) {
+	return !(x < y) && !(x > y);
+}
+
+size_t copyChars(const char* chars, char* buffer) {
+	const size_t size = strlen(chars);
+	memcpy(buffer, chars, size);
+	return size;
+}
+
+/**
+ * printf writes the radix of the current C locale: always use a dot.
+ */
+void normalizeRadix(char* buffer, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		const char c = buffer[i];
+		if ((c < '0' || c > '9') && c != '-' && c != '+' && c != 'e') {
+			buffer[i] = '.';
+		}
+	}
+}
+
+size_t formatUnsigned(unsigned long long value, char* buffer) {
+	char digits[NUMBER_MAX_CHARS];
+	size_t size = 0;
+	do {
+		digits[size++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	for (size_t i = 0; i < size; i++) {
+		buffer[i] = digits[size - 1 - i];
+	}
+	return size;
+}
+
+/**
+ * Fast path for values having at most 15 significant digits in fixed notation, which is the
+ * representation "%.15g" chooses for magnitudes between 1e-4 and 1e15. Returns 0 if the
+ * value has no such representation.
+ */
+size_t formatFixed(double value, char* buffer) {
+	const double magnitude = abs(value);
+	if (magnitude < 1e-4 || magnitude >= 1e15) {
+		return 0;
+	}
+	for (int decimals = 0; decimals < 18; decimals++) {
+		const double scaled = magnitude * POWERS_OF_TEN[decimals];
+		if (scaled >= 1e15) {
+			return 0;
+		}
+		const double rounded = floor(scaled + 0.5);
+		if (!sameDouble(rounded / POWERS_OF_TEN[decimals], magnitude)) {
+			continue;
+		}
+		char digits[NUMBER_MAX_CHARS];
+		const size_t numDigits = formatUnsigned(static_cast<unsigned long long>(rounded), digits);
+		const size_t numDecimals = static_cast<size_t>(decimals);
+		size_t size = 0;
+		if (value < 0) {
+			buffer[size++] = '-';
+		}
+		if (numDigits <= numDecimals) {
+			buffer[size++] = '0';
+			buffer[size++] = '.';
+			for (size_t i = numDigits; i < numDecimals; i++) {
+				buffer[size++] = '0';
+			}
+			memcpy(buffer + size, digits, numDigits);
+			size += numDigits;
+		} else {
+			const size_t integerDigits = numDigits - numDecimals;
+			memcpy(buffer + size, digits, integerDigits);
+			size += integerDigits;
+			if (numDecimals > 0) {
+				buffer[size++] = '.';
+				memcpy(buffer + size, digits + integerDigits, numDecimals);
+				size += numDecimals;
+			}
+		}
+		return size;
+	}
+	return 0;
+}
+
+size_t formatGeneral(double value, int precision, char* buffer) {
+	const int size = snprintf(buffer, NUMBER_MAX_CHARS, "%.*g", precision, value);
+	return static_cast<size_t>(size);
+}
+
+/**
+ * Converts a "%g" number into Nastran real syntax: mandatory decimal point, no leading zero
+ * before the point and compact exponent without the 'e' and the exponent leading zeros.
+ */
+size_t nastranize(const char* chars, size_t size, char* buffer) {
+	size_t in = 0;
+	size_t out = 0;
+	if (chars[in] == '-') {
+		buffer[out++] = chars[in++];
+	}
+	if (in + 1 < size && chars[in] == '0' && chars[in + 1] == '.') {
+		in++;
+	}
+	bool hasPoint = false;
+	while (in < size && chars[in] != 'e') {
+		hasPoint = hasPoint || chars[in] == '.';
+		buffer[out++] = chars[in++];
+	}
+	if (!hasPoint) {
+		buffer[out++] = '.';
+	}
+	if (in < size) {
+		// skip 'e', keep the exponent sign, drop the exponent leading zeros
+		in++;
+		buffer[out++] = chars[in++];
+		while (in + 1 < size && chars[in] == '0') {
+			in++;
+		}
+		while (in < size) {
+			buffer[out++] = chars[in++];
+		}
+	}
+	return out;
+}
+
+} /* namespace */
+
+size_t formatInteger(long long value, char* buffer) {
+	if (value >= 0) {
+		return formatUnsigned(static_cast<unsigned long long>(value), buffer);
+	}
+	buffer[0] = '-';
+	// negation done on the unsigned type to handle LLONG_MIN
+	return 1 + formatUnsigned(0ULL - static_cast<unsigned long long>(value), buffer + 1);
+}
+
+size_t formatDouble(double value, char* buffer) {
+	switch (fpclassify(value)) {
+	case FP_NAN:
+		return copyChars("nan", buffer);
+	case FP_INFINITE:
+		return copyChars(value < 0 ? "-inf" : "inf", buffer);
+	case FP_ZERO:
+		return copyChars(signbit(value) ? "-0" : "0", buffer);
+	default:
+		break;
+	}
+	size_t size = formatFixed(value, buffer);
+	if (size > 0) {
+		return size;
+	}
+	for (int precision = DBL_DIG; precision < 17; precision++) {
+		size = formatGeneral(value, precision, buffer);
+		if (sameDouble(strtod(buffer, nullptr), value)) {
+			normalizeRadix(buffer, size);
+			return size;
+		}
+	}
+	size = formatGeneral(value, 17, buffer);
+	normalizeRadix(buffer, size);
+	return size;
+}
+
+size_t formatNastranDouble(double value, size_t width, char* buffer) {
+	char chars[NUMBER_MAX_CHARS];
+	size_t size = formatDouble(value, chars);
+	if (!isfinite(value)) {
+		if (size > width) {
+			throw invalid_argument("Non finite value does not fit in a Nastran field");
+		}
+		memcpy(buffer, chars, size);
+		return size;
+	}
+	char nastranChars[NUMBER_MAX_CHARS];
+	size_t nastranSize = nastranize(chars, size, nastranChars);
+	// a field can't hold more significant digits than chars, nor a double more than 17
+	int precision = static_cast<int>(min(width, static_cast<size_t>(DBL_DIG + 2)));
+	while (nastranSize > width && precision > 1) {
+		precision--;
+		size = formatGeneral(value, precision, chars);
+		normalizeRadix(chars, size);
+		nastranSize = nastranize(chars, size, nastranChars);
+	}
+	if (nastranSize > width) {
+		throw invalid_argument("Value does not fit in a Nastran field of width " + to_string(width));
+	}
+	memcpy(buffer, nastranChars, nastranSize);
+	return nastranSize;
+}
+
+FastNumberPut::FastNumberPut(size_t refs) :
+		num_put<char>(refs) {
+}
+
+FastNumberPut::iter_type FastNumberPut::pad(iter_type out, ios_base& str, char_type fill,
+		const char* chars, size_t size) const {
+	const streamsize width = str.width(0);
+	if (width <= static_cast<streamsize>(size)) {
+		return copy(chars, chars + size, out);
+	}
+	const size_t padding = static_cast<size_t>(width) - size;
+	const ios_base::fmtflags adjust = str.flags() & ios_base::adjustfield;
+	if (adjust == ios_base::left) {
+		out = copy(chars, chars + size, out);
+		return fill_n(out, padding, fill);
+	}
+	if (adjust == ios_base::internal && size > 0 && (chars[0] == '-' || chars[0] == '+')) {
+		*out++ = chars[0];
+		out = fill_n(out, padding, fill);
+		return copy(chars + 1, chars + size, out);
+	}
+	out = fill_n(out, padding, fill);
+	return copy(chars, chars + size, out);
+}
+
+FastNumberPut::iter_type FastNumberPut::do_put(iter_type out, ios_base& str, char_type fill,
+		long value) const {
+	return do_put(out, str, fill, static_cast<long long>(value));
+}
+
+FastNumberPut::iter_type FastNumberPut::do_put(iter_type out, ios_base& str, char_type fill,
+		unsigned long value) const {
+	if (value > static_cast<unsigned long>(LLONG_MAX)) {
+		return num_put<char>::do_put(out, str, fill, value);
+	}
+	return do_put(out, str, fill, static_cast<long long>(value));
+}
+
+FastNumberPut::iter_type FastNumberPut::do_put(iter_type out, ios_base& str, char_type fill,
+		long long value) const {
+	const ios_base::fmtflags flags = str.flags();
+	const ios_base::fmtflags base = flags & ios_base::basefield;
+	if ((base != ios_base::dec && base != 0) || (flags & ios_base::showpos)) {
+		return num_put<char>::do_put(out, str, fill, value);
+	}
+	char chars[NUMBER_MAX_CHARS];
+	const size_t size = formatInteger(value, chars);
+	return pad(out, str, fill, chars, size);
+}
+
+FastNumberPut::iter_type FastNumberPut::do_put(iter_type out, ios_base& str, char_type fill,
+		double value) const {
+	const ios_base::fmtflags flags = str.flags();
+	if ((flags & (ios_base::floatfield | ios_base::showpos | ios_base::showpoint | ios_base::uppercase))
+			|| str.precision() < DBL_DIG) {
+		return num_put<char>::do_put(out, str, fill, value);
+	}
+	char chars[NUMBER_MAX_CHARS];
+	const size_t size = formatDouble(value, chars);
+	return pad(out, str, fill, chars, size);
+}
+
+void useFastNumberFormat(ios& stream) {
+	static const locale fastNumberLocale(locale::classic(), new FastNumberPut());
+	stream.imbue(fastNumberLocale);
+}
+
+BufferedOfstream::BufferedOfstream(size_t bufferSize) :
+		buffer(bufferSize) {
+	rdbuf()->pubsetbuf(buffer.data(), static_cast<streamsize>(buffer.size()));
+	useFastNumberFormat(*this);
+}
+
+BufferedOfstream::~BufferedOfstream() {
+	if (is_open()) {
+		close();
+	}
+}
+
+} /* namespace vega */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * NumberFormat.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef NUMBERFORMAT_H_
+#define NUMBERFORMAT_H_
+
+#include <cstddef>
+#include <fstream>
+#include <locale>
+#include <ostream>
+#include <vector>
+
+namespace vega {
+
+/**
+ * Size of a char buffer large enough to hold any number written by the format functions below.
+ */
+const std::size_t NUMBER_MAX_CHARS = 32;
+
+/**
+ * Writes the shortest decimal representation of value that reads back to exactly the same double.
+ * The output follows the "%g" conventions ("2", "0.1", "1.5e-07") and always uses '.' as radix,
+ * whatever the current C locale. No terminating null is written.
+ *
+ * @return the number of chars written into buffer (at most NUMBER_MAX_CHARS).
+ */
+std::size_t formatDouble(double value, char* buffer);
+
+/**
+ * Writes the decimal representation of value (no terminating null).
+ * @return the number of chars written into buffer.
+ */
+std::size_t formatInteger(long long value, char* buffer);
+
+/**
+ * Writes value as a Nastran real field of at most width chars: a decimal point is always present,
+ * the exponent is written in the compact Nastran form ("1.5-7") and as many significant digits
+ * as fit in the field are kept. The result is not padded. With a width of NUMBER_MAX_CHARS, the
+ * value is never rounded: it is read back exactly.
+ *
+ * @return the number of chars written into buffer (at most width).
+ */
+std::size_t formatNastranDouble(double value, std::size_t width, char* buffer);
+
+/**
+ * num_put facet routing the stream insertion of numbers through the format functions above.
+ * Doubles are written in shortest round-trip form when the stream asks for full precision
+ * (precision >= DBL_DIG, default float field): every other combination of flags is delegated
+ * to std::num_put.
+ */
+class FastNumberPut: public std::num_put<char> {
+public:
+	explicit FastNumberPut(std::size_t refs = 0);
+protected:
+	iter_type do_put(iter_type out, std::ios_base& str, char_type fill, long value) const override;
+	iter_type do_put(iter_type out, std::ios_base& str, char_type fill, unsigned long value) const override;
+	iter_type do_put(iter_type out, std::ios_base& str, char_type fill, long long value) const override;
+	iter_type do_put(iter_type out, std::ios_base& str, char_type fill, double value) const override;
+private:
+	iter_type pad(iter_type out, std::ios_base& str, char_type fill, const char* chars, std::size_t size) const;
+};
+
+/**
+ * Imbues the stream with a "C" locale using FastNumberPut.
+ */
+void useFastNumberFormat(std::ios& stream);
+
+/**
+ * Output file stream writing through a large user buffer and formatting numbers
+ * with FastNumberPut. Used by the writers for the solver input files.
+ */
+class BufferedOfstream: public std::ofstream {
+private:
+	std::vector<char> buffer;
+public:
+	static const std::size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+	explicit BufferedOfstream(std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+	BufferedOfstream(const BufferedOfstream&) = delete;
+	BufferedOfstream& operator=(const BufferedOfstream&) = delete;
+	// the buffer must outlive the file: close it before the members are destroyed
+	~BufferedOfstream();
+};
+
+} /* namespace vega */
+
+#endif /* NUMBERFORMAT_H_ */
@@ -61,10 +61,8 @@ const DOFS NodalAssertion::getDOFSForNode(int nodePosition) const {
     UNUSEDV(nodePosition);
     return dof;
 }
-set<int> NodalAssertion::nodePositions() const {
-    set<int> result;
-    result.insert(nodePosition);
-    return result;
+NodeSet NodalAssertion::nodePositions() const {
+    return NodeSet({nodePosition});
 }
 
 NodalDisplacementAssertion::NodalDisplacementAssertion(const Model& model, double tolerance,
@@ -101,8 +99,8 @@ const DOFS FrequencyAssertion::getDOFSForNode(int nodePosition) const {
     UNUSEDV(nodePosition);
     return DOFS::NO_DOFS;
 }
-set<int> FrequencyAssertion::nodePositions() const {
-    return set<int>();
+NodeSet FrequencyAssertion::nodePositions() const {
+    return NodeSet();
 }
 
 shared_ptr<Objective> FrequencyAssertion::clone() const {
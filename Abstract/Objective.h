@@ -77,7 +77,7 @@ protected:
 public:
     const double tolerance;
     virtual const DOFS getDOFSForNode(int nodePosition) const = 0;
-    virtual std::set<int> nodePositions() const = 0;
+    virtual NodeSet nodePositions() const = 0;
     bool isAssertion() const override {
         return true;
     }
@@ -93,7 +93,7 @@ public:
     const int nodePosition;
     const DOF dof;
     const DOFS getDOFSForNode(int nodePosition) const override final;
-    std::set<int> nodePositions() const override final;
+    NodeSet nodePositions() const override final;
     ~NodalAssertion() {
     }
 };
@@ -135,7 +135,7 @@ public:
             NO_ORIGINAL_ID);
     std::shared_ptr<Objective> clone() const;
     const DOFS getDOFSForNode(int nodePosition) const override final;
-    std::set<int> nodePositions() const override final;
+    NodeSet nodePositions() const override final;
     ~FrequencyAssertion() {
     }
     ;
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Parallel.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "Parallel.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace vega {
+
+using namespace std;
+
+size_t countWorkers() {
+	return max(static_cast<size_t>(thread::hardware_concurrency()), size_t(1));
+}
+
+void parallelFor(size_t count, const function<void(size_t, size_t)>& job, size_t minChunk) {
+	minChunk = max(minChunk, size_t(1));
+	const size_t chunks = min(countWorkers(), count / minChunk);
+	if (chunks < 2) {
+		if (count > 0) {
+			job(0, count);
+		}
+		return;
+	}
+	vector<exception_ptr> errors(chunks);
+	vector<thread> threads;
+	threads.reserve(chunks - 1);
+	const size_t chunkSize = (count + chunks - 1) / chunks;
+	auto runChunk = [&job, &errors, count, chunkSize](size_t chunk) {
+		try {
+			const size_t begin = chunk * chunkSize;
+			if (begin < count) {
+				job(begin, min(begin + chunkSize, count));
+			}
+		} catch (...) {
+			errors[chunk] = current_exception();
+		}
+	};
+	for (size_t chunk = 1; chunk < chunks; chunk++) {
+		threads.emplace_back(runChunk, chunk);
+	}
+	runChunk(0);
+	for (thread& worker : threads) {
+		worker.join();
+	}
+	for (const exception_ptr& error : errors) {
+		if (error) {
+			rethrow_exception(error);
+		}
+	}
+}
+
+} /* namespace vega */
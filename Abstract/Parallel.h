@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Parallel.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace vega {
+
+/**
+ * Number of threads used by parallelFor: the number of hardware threads, at least 1.
+ */
+std::size_t countWorkers();
+
+/**
+ * Splits [0, count) into contiguous ranges of at least minChunk items and calls job(begin, end)
+ * on each of them, concurrently. The ranges are disjoint: a job may write to the items of its
+ * range without locking. Runs in the calling thread when count < 2 * minChunk or when a
+ * single worker is available.
+ *
+ * If some jobs throw, parallelFor waits for all of them then rethrows the first exception.
+ */
+void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& job,
+		std::size_t minChunk = 1);
+
+} /* namespace vega */
+
+#endif /* PARALLEL_H_ */
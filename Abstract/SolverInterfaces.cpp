@@ -26,6 +26,8 @@
 #include "ConfigurationParameters.h"
 #include <boost/lexical_cast.hpp>
 #include <boost/filesystem.hpp>
+#include <sstream>
+#include <stdexcept>
 #include <stdio.h>
 #if defined VDEBUG && defined __GNUC__
 #include <execinfo.h>
@@ -181,12 +183,15 @@ void Tokenizer::handleParsingError(const string& message) {
     case ConfigurationParameters::MODE_STRICT:
         throw ParsingException(message, fileName, lineNumber, currentKeyword);
     case ConfigurationParameters::MESH_AT_LEAST:
-        //model->onlyMesh = true;
-        cerr << ParsingMessageException(message, fileName, lineNumber, currentKeyword) << endl;
-        throw std::string("skipCommand");
-        break;
     case ConfigurationParameters::BEST_EFFORT:
-        cerr << ParsingMessageException(message, fileName, lineNumber, currentKeyword) << endl;
+        //model->onlyMesh = true;
+        if (diagnostics == nullptr || logLevel >= LogLevel::DEBUG) {
+            cerr << ParsingMessageException(message, fileName, lineNumber, currentKeyword) << endl;
+        }
+        if (diagnostics != nullptr) {
+            diagnostics->add(DiagnosticCollector::Severity::ERROR, message, fileName, lineNumber,
+                    currentKeyword);
+        }
         throw std::string("skipCommand");
         break;
     default:
@@ -196,7 +201,13 @@ void Tokenizer::handleParsingError(const string& message) {
 }
 
 void Tokenizer::handleParsingWarning(const string& message) {
-    cerr << ParsingMessageWarning(message, fileName, lineNumber, currentKeyword);
+    if (diagnostics == nullptr || logLevel >= LogLevel::DEBUG) {
+        cerr << ParsingMessageWarning(message, fileName, lineNumber, currentKeyword) << endl;
+    }
+    if (diagnostics != nullptr) {
+        diagnostics->add(DiagnosticCollector::Severity::WARNING, message, fileName, lineNumber,
+                currentKeyword);
+    }
 }
 
 
@@ -213,11 +224,13 @@ void Parser::handleParsingError(const string& message, Tokenizer& tok,
         throw ParsingException(message, tok.fileName, tok.lineNumber, tok.currentKeyword);
     case ConfigurationParameters::MESH_AT_LEAST:
         model->onlyMesh = true;
-        cerr << ParsingMessageException(message, tok.fileName, tok.lineNumber, tok.currentKeyword) << endl;
-        throw std::string("skipCommand");
-        break;
+        // fall through
     case ConfigurationParameters::BEST_EFFORT:
-        cerr << ParsingMessageException(message, tok.fileName, tok.lineNumber, tok.currentKeyword) << endl;
+        if (tok.logLevel >= LogLevel::DEBUG) {
+            cerr << ParsingMessageException(message, tok.fileName, tok.lineNumber, tok.currentKeyword) << endl;
+        }
+        diagnostics.add(DiagnosticCollector::Severity::ERROR, message, tok.fileName,
+                tok.lineNumber, tok.currentKeyword);
         throw std::string("skipCommand");
         break;
     default:
@@ -229,7 +242,11 @@ void Parser::handleParsingError(const string& message, Tokenizer& tok,
 void Parser::handleParsingWarning(const string& message, Tokenizer& tok,
         shared_ptr<Model> model) {
     UNUSEDV(model);
-    cerr << ParsingMessageWarning(message, tok.fileName, tok.lineNumber, tok.currentKeyword) << endl;
+    if (tok.logLevel >= LogLevel::DEBUG) {
+        cerr << ParsingMessageWarning(message, tok.fileName, tok.lineNumber, tok.currentKeyword) << endl;
+    }
+    diagnostics.add(DiagnosticCollector::Severity::WARNING, message, tok.fileName,
+            tok.lineNumber, tok.currentKeyword);
 }
 
 
@@ -287,27 +304,96 @@ void Runner::deletePreviousResultFiles(string currentModel, const vector<string>
     }
 }
 
-Runner::ExitCode Runner::convertExecResult(int exitCode) const {
-    if (exitCode == 0) {
-        return OK;
+vector<string> Runner::splitCommand(const string& command) const {
+    vector<string> arguments;
+    string argument;
+    bool inArgument = false;
+    char quote = '\0';
+    for (size_t i = 0; i < command.size(); i++) {
+        const char c = command[i];
+        if (quote == '\'') {
+            // nothing is escaped between single quotes
+            if (c == '\'') {
+                quote = '\0';
+            } else {
+                argument += c;
+            }
+        } else if (c == '\\' && i + 1 < command.size()
+                && (quote == '\0' || string("\"\\$`").find(command[i + 1]) != string::npos)) {
+            argument += command[++i];
+            inArgument = true;
+        } else if (quote == '"') {
+            if (c == '"') {
+                quote = '\0';
+            } else {
+                argument += c;
+            }
+        } else if (c == '\'' || c == '"') {
+            quote = c;
+            inArgument = true;
+        } else if (isspace(static_cast<unsigned char>(c))) {
+            if (inArgument) {
+                arguments.push_back(argument);
+                argument.clear();
+                inArgument = false;
+            }
+        } else {
+            argument += c;
+            inArgument = true;
+        }
     }
-    ExitCode result = SOLVER_EXIT_NOT_ZERO;
-#ifdef __GNUC__
-    //bash exit codes http://tldp.org/LDP/abs/html/exitcodes.html
-    //int lowByte = 0x00FF & exitCode;
-    int highByte = (exitCode && 0xFF00) >> 8;
-    if (highByte == 127) {
-        result = SOLVER_NOT_FOUND;
-    } else if (highByte > 128 && highByte <= 165) {
-        result = SOLVER_KILLED;
-    } else if (exitCode == -1) {
-        result = SOLVER_NOT_FOUND;
+    if (quote != '\0') {
+        throw invalid_argument("Unterminated quote in the solver command: " + command);
     }
-#else
+    if (inArgument) {
+        arguments.push_back(argument);
+    }
+    return arguments;
+}
 
-#endif
+SolverJobResult Runner::runJob(const ConfigurationParameters& configuration, SolverJob job) const {
+    if (job.timeout <= 0) {
+        job.timeout = configuration.solverTimeout;
+    }
+    if (configuration.logLevel >= LogLevel::DEBUG) {
+        cout << "About to launch";
+        for (const string& argument : job.arguments) {
+            cout << " " << argument;
+        }
+        cout << " in " << job.workingDirectory << endl;
+    }
+    SolverQueue& queue = SolverQueue::getInstance();
+    queue.setBudget(configuration.solverMaxCpus, configuration.solverMaxMemory);
+    const SolverJobResult result = queue.submit(job).get();
+    for (const LogMatch& match : result.matches) {
+        cerr << "Found " << match.pattern << ": line " << match.lineNumber << " file: "
+                << match.file << endl;
+    }
+    if (!result.started) {
+        cerr << "Command " << job.arguments[0] << " can't be launched." << endl;
+    } else if (result.timedOut) {
+        cerr << "Command " << job.arguments[0] << " killed after " << job.timeout << " s." << endl;
+    } else if (result.exitCode != 0) {
+        cerr << "Command " << job.arguments[0] << (result.signaled ? " signal:" : " exit code:")
+                << result.exitCode << endl;
+    } else if (configuration.logLevel >= LogLevel::DEBUG) {
+        cout << "Command " << job.arguments[0] << " ended in " << result.elapsed << " s." << endl;
+    }
     return result;
 }
 
+Runner::ExitCode Runner::convertJobResult(const SolverJobResult& result) const {
+    if (!result.started) {
+        return SOLVER_NOT_FOUND;
+    }
+    if (result.timedOut || result.signaled) {
+        return SOLVER_KILLED;
+    }
+    if (result.exitCode != 0) {
+        return SOLVER_EXIT_NOT_ZERO;
+    }
+    return OK;
+}
+
 }
 
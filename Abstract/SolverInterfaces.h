@@ -17,6 +17,8 @@
 #include <vector>
 #include <istream>
 #include "ConfigurationParameters.h"
+#include "SolverProcess.h"
+#include "Diagnostics.h"
 #include <string>
 
 namespace vega {
@@ -64,6 +66,7 @@ protected:
 	vega::ConfigurationParameters::TranslationMode translationMode;
 	int lineNumber;
 	std::string currentKeyword; /**< Current Keyword: only used for printout and error managment. **/
+	DiagnosticCollector* diagnostics = nullptr; /**< Collector of the problems, printed one by one if null. **/
 
 public:
 	virtual ~Tokenizer() {
@@ -74,11 +77,12 @@ public:
 	inline int getLineNumber() const {return lineNumber;};
 	inline std::string getCurrentKeyword() const {return currentKeyword;};
 	void setCurrentKeyword(std::string cK) {currentKeyword=cK;};
+	void setDiagnostics(DiagnosticCollector* collector) {diagnostics=collector;};
 
     /**
      * Generic handler for parsing exceptions.
      * Throw a ParsingException in strict mode, which shuts the program, and a string otherwise, which
-     * should skip the problematic command.
+     * should skip the problematic command. The error is then recorded in the diagnostics, if any.
      */
 	void handleParsingError(const std::string& message);
 
@@ -99,6 +103,10 @@ class Parser {
 
 protected:
 	Parser();
+	/**
+	 * Problems found by the last parse() in best effort modes.
+	 */
+	DiagnosticCollector diagnostics;
 public:
 	ConfigurationParameters::TranslationMode translationMode;
 	/**
@@ -107,13 +115,16 @@ public:
 	 * configuration: a set of configuration parameters usually specified on the command line
 	 */
 	virtual std::shared_ptr<Model> parse(const ConfigurationParameters& configuration) = 0;
+	virtual DiagnosticCollector& getDiagnostics() {
+		return diagnostics;
+	}
 	virtual ~Parser() {
 	}
 
     /**
      * Generic handler for parsing exceptions.
      * Throw a ParsingException in strict mode, which shuts the program, and a string otherwise, which
-     * should skip the problematic command.
+     * should skip the problematic command. The error is then recorded in the diagnostics.
      */
 	void handleParsingError(const std::string& message, Tokenizer& tok, std::shared_ptr<Model> model);
 
@@ -200,7 +211,19 @@ protected:
 	void deletePreviousResultFiles(std::string currentModel,
 			const std::vector<std::string> extensions);
 	std::string stripExtension(const std::string& currentModel) const;
-	ExitCode convertExecResult(int exitCode) const;
+	/**
+	 * Splits a solver command given on the command line ("as_run --option") into the
+	 * arguments of a SolverJob, as a shell does: single and double quotes group the words
+	 * and a backslash escapes the next character ("/opt/my solver/as_run" or my\ solver).
+	 * Throws invalid_argument if a quote is not closed.
+	 */
+	std::vector<std::string> splitCommand(const std::string& command) const;
+	/**
+	 * Runs a job on the SolverQueue shared by all the runners, with the budget and the timeout
+	 * of the configuration, then prints the lines that matched its patterns.
+	 */
+	SolverJobResult runJob(const ConfigurationParameters& configuration, SolverJob job) const;
+	ExitCode convertJobResult(const SolverJobResult& result) const;
 };
 
 /**
@@ -214,7 +237,17 @@ class ResultReader {
 
 public:
 	/**
-	 * Reads the results of an analysis from a file.
+	 * Reads the values of the result file that don't depend on the model (node ids, subcases,
+	 * steps...) and keeps them until add_assertions() is called. It doesn't use the model,
+	 * so it can run in another thread while the model is parsed.
+	 *
+	 * The default implementation does nothing: the file is read by add_assertions().
+	 */
+	virtual void read(const ConfigurationParameters&) {
+	}
+	/**
+	 * Reads the results of an analysis from a file, or takes the values kept by read(), and
+	 * adds them to the model.
 	 *
 	 * configuration: a set of configuration parameters usually specified on the command line
 	 */
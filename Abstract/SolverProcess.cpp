@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * SolverProcess.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "SolverProcess.h"
+#include "Parallel.h"
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#ifdef __unix__
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace vega {
+
+using namespace std;
+
+namespace {
+
+/**
+ * Milliseconds between two checks of the timeout while the solver is silent.
+ */
+const int POLL_INTERVAL = 100;
+/**
+ * Seconds given to a solver to stop after SIGTERM, before SIGKILL.
+ */
+const double KILL_GRACE_TIME = 2.0;
+
+/**
+ * Output stream of a solver: copied to its log file and scanned line by line.
+ */
+class StreamScanner final {
+private:
+	const vector<LogPattern>& patterns;
+	const string file;
+	vector<LogMatch>& matches;
+	ofstream log;
+	string pending;
+	int lineNumber = 0;
+	void scan(string line) {
+		lineNumber++;
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		for (const LogPattern& pattern : patterns) {
+			if (pattern.matches(line)) {
+				LogMatch match;
+				match.pattern = pattern.text;
+				match.file = file;
+				match.lineNumber = lineNumber;
+				match.line = line;
+				matches.push_back(match);
+			}
+		}
+	}
+public:
+	StreamScanner(const vector<LogPattern>& patterns, const string& file,
+			vector<LogMatch>& matches) :
+			patterns(patterns), file(file), matches(matches) {
+		if (!file.empty()) {
+			log.open(file, ios::out | ios::trunc | ios::binary);
+			if (!log.is_open()) {
+				throw ios::failure("Can't open file " + file + " for writing.");
+			}
+		}
+	}
+	void append(const char* data, size_t size) {
+		if (log.is_open()) {
+			log.write(data, static_cast<streamsize>(size));
+		}
+		pending.append(data, size);
+		size_t begin = 0;
+		size_t end;
+		while ((end = pending.find('\n', begin)) != string::npos) {
+			scan(pending.substr(begin, end - begin));
+			begin = end + 1;
+		}
+		pending.erase(0, begin);
+	}
+	void finish() {
+		if (!pending.empty()) {
+			scan(pending);
+			pending.clear();
+		}
+		if (log.is_open()) {
+			log.close();
+		}
+	}
+};
+
+#ifdef __unix__
+
+/**
+ * Serializes the creation of the pipes and the fork: a process forked by another thread would
+ * otherwise inherit the pipes before they are marked close-on-exec, and keep them open.
+ */
+mutex forkMutex;
+
+void closeOnExec(int fd) {
+	fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+void closePipe(int fds[2]) {
+	for (int i = 0; i < 2; i++) {
+		if (fds[i] >= 0) {
+			close(fds[i]);
+			fds[i] = -1;
+		}
+	}
+}
+
+#endif
+
+}
+
+bool LogPattern::matches(const string& line) const {
+	return line.find(text) != string::npos && (unless.empty() || line.find(unless) == string::npos);
+}
+
+#ifdef __unix__
+
+SolverJobResult runSolverJob(const SolverJob& job) {
+	if (job.arguments.empty()) {
+		throw invalid_argument("No solver command.");
+	}
+	SolverJobResult result;
+	StreamScanner stdoutScanner(job.patterns, job.stdoutFile, result.matches);
+	StreamScanner stderrScanner(job.patterns, job.stderrFile, result.matches);
+
+	vector<char*> argv;
+	for (const string& argument : job.arguments) {
+		argv.push_back(const_cast<char*>(argument.c_str()));
+	}
+	argv.push_back(nullptr);
+
+	int stdoutPipe[2] = { -1, -1 };
+	int stderrPipe[2] = { -1, -1 };
+	// written by the child only if exec fails, closed by exec otherwise
+	int execPipe[2] = { -1, -1 };
+	const auto start = chrono::steady_clock::now();
+	pid_t pid;
+	{
+		lock_guard<mutex> lock(forkMutex);
+		if (pipe(stdoutPipe) != 0 || pipe(stderrPipe) != 0 || pipe(execPipe) != 0) {
+			closePipe(stdoutPipe);
+			closePipe(stderrPipe);
+			closePipe(execPipe);
+			throw runtime_error("Can't create the pipes of the solver process.");
+		}
+		for (int* fds : { stdoutPipe, stderrPipe, execPipe }) {
+			closeOnExec(fds[0]);
+			closeOnExec(fds[1]);
+		}
+		pid = fork();
+		if (pid == 0) {
+			// child: only async-signal-safe calls until exec
+			setpgid(0, 0);
+			if (chdir(job.workingDirectory.c_str()) == 0 && dup2(stdoutPipe[1], STDOUT_FILENO) >= 0
+					&& dup2(stderrPipe[1], STDERR_FILENO) >= 0) {
+				execvp(argv[0], argv.data());
+			}
+			const int error = errno;
+			if (write(execPipe[1], &error, sizeof(error)) < 0) {
+				// nothing else can be reported: the parent sees the exit code 127
+			}
+			_exit(127);
+		}
+	}
+	close(stdoutPipe[1]);
+	close(stderrPipe[1]);
+	close(execPipe[1]);
+	if (pid < 0) {
+		close(stdoutPipe[0]);
+		close(stderrPipe[0]);
+		close(execPipe[0]);
+		throw runtime_error("Can't fork the solver process.");
+	}
+	// also set by the child, but the parent may kill the group before the child runs
+	setpgid(pid, pid);
+
+	int execError = 0;
+	ssize_t execRead;
+	do {
+		execRead = read(execPipe[0], &execError, sizeof(execError));
+	} while (execRead < 0 && errno == EINTR);
+	close(execPipe[0]);
+	result.started = execRead == 0;
+
+	auto secondsSinceStart = [&start]() {
+		return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	};
+	double killTime = -1;
+	auto checkTimeout = [&]() {
+		if (job.timeout <= 0 || !result.started) {
+			return;
+		}
+		const double elapsed = secondsSinceStart();
+		if (!result.timedOut && elapsed > job.timeout) {
+			result.timedOut = true;
+			killTime = elapsed;
+			kill(-pid, SIGTERM);
+		} else if (result.timedOut && killTime >= 0 && elapsed > killTime + KILL_GRACE_TIME) {
+			kill(-pid, SIGKILL);
+			killTime = -1;
+		}
+	};
+
+	int fds[2] = { stdoutPipe[0], stderrPipe[0] };
+	StreamScanner* scanners[2] = { &stdoutScanner, &stderrScanner };
+	char buffer[65536];
+	while (fds[0] >= 0 || fds[1] >= 0) {
+		pollfd pollFds[2];
+		int pollIndexes[2];
+		nfds_t pollCount = 0;
+		for (int i = 0; i < 2; i++) {
+			if (fds[i] >= 0) {
+				pollFds[pollCount].fd = fds[i];
+				pollFds[pollCount].events = POLLIN;
+				pollFds[pollCount].revents = 0;
+				pollIndexes[pollCount] = i;
+				pollCount++;
+			}
+		}
+		const int ready = poll(pollFds, pollCount, POLL_INTERVAL);
+		if (ready < 0 && errno != EINTR) {
+			break;
+		}
+		for (nfds_t p = 0; ready > 0 && p < pollCount; p++) {
+			if (pollFds[p].revents == 0) {
+				continue;
+			}
+			const int i = pollIndexes[p];
+			const ssize_t count = read(fds[i], buffer, sizeof(buffer));
+			if (count > 0) {
+				scanners[i]->append(buffer, static_cast<size_t>(count));
+			} else if (count == 0 || errno != EINTR) {
+				close(fds[i]);
+				fds[i] = -1;
+			}
+		}
+		checkTimeout();
+		if (result.timedOut && killTime < 0 && secondsSinceStart() > job.timeout + 2 * KILL_GRACE_TIME) {
+			// a process left the group and keeps the pipes open: stop reading them
+			break;
+		}
+	}
+	for (int i = 0; i < 2; i++) {
+		if (fds[i] >= 0) {
+			close(fds[i]);
+		}
+	}
+	stdoutScanner.finish();
+	stderrScanner.finish();
+
+	// the solver may have closed its outputs before exiting
+	int status = 0;
+	pid_t waited;
+	while ((waited = waitpid(pid, &status, WNOHANG)) == 0 || (waited < 0 && errno == EINTR)) {
+		checkTimeout();
+		this_thread::sleep_for(chrono::milliseconds(POLL_INTERVAL));
+	}
+	result.elapsed = secondsSinceStart();
+	if (waited > 0) {
+		if (WIFSIGNALED(status)) {
+			result.signaled = true;
+			result.exitCode = WTERMSIG(status);
+		} else if (WIFEXITED(status)) {
+			result.exitCode = WEXITSTATUS(status);
+		}
+	}
+	return result;
+}
+
+#else
+
+SolverJobResult runSolverJob(const SolverJob&) {
+	throw logic_error("Solver processes are only implemented on Unix.");
+}
+
+#endif
+
+SolverQueue::SolverQueue(int maxCpus, double maxMemory) :
+		maxCpus(maxCpus > 0 ? maxCpus : static_cast<int>(countWorkers())), maxMemory(maxMemory) {
+}
+
+void SolverQueue::setBudget(int maxCpus, double maxMemory) {
+	lock_guard<std::mutex> lock(queueMutex);
+	this->maxCpus = maxCpus > 0 ? maxCpus : static_cast<int>(countWorkers());
+	this->maxMemory = maxMemory;
+	released.notify_all();
+}
+
+void SolverQueue::acquire(const SolverJob& job, unsigned long ticket) {
+	unique_lock<std::mutex> lock(queueMutex);
+	released.wait(lock, [this, &job, ticket]() {
+		if (ticket != startedCount) {
+			return false;
+		}
+		return runningCount == 0 || (usedCpus + job.cpus <= maxCpus
+				&& (maxMemory <= 0 || usedMemory + job.memory <= maxMemory));
+	});
+	startedCount++;
+	runningCount++;
+	usedCpus += job.cpus;
+	usedMemory += job.memory;
+	// the next job may fit too
+	released.notify_all();
+}
+
+void SolverQueue::release(const SolverJob& job) {
+	lock_guard<std::mutex> lock(queueMutex);
+	runningCount--;
+	usedCpus -= job.cpus;
+	usedMemory -= job.memory;
+	released.notify_all();
+}
+
+future<SolverJobResult> SolverQueue::submit(const SolverJob& job) {
+	unsigned long ticket;
+	{
+		lock_guard<std::mutex> lock(queueMutex);
+		ticket = submittedCount++;
+	}
+	return async(launch::async, [this, job, ticket]() {
+		acquire(job, ticket);
+		SolverJobResult result;
+		try {
+			result = runSolverJob(job);
+		} catch (...) {
+			release(job);
+			throw;
+		}
+		release(job);
+		return result;
+	});
+}
+
+SolverQueue& SolverQueue::getInstance() {
+	static SolverQueue queue;
+	return queue;
+}
+
+} /* namespace vega */
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * SolverProcess.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef SOLVERPROCESS_H_
+#define SOLVERPROCESS_H_
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace vega {
+
+/**
+ * Text searched in the output of a solver, line by line: a line matches if it contains text
+ * and does not contain unless (when not empty), e.g. "ERROR" unless "NO ERROR".
+ */
+struct LogPattern final {
+	std::string text;
+	std::string unless;
+	bool matches(const std::string& line) const;
+};
+
+/**
+ * A line of the output of a solver matching a LogPattern.
+ */
+struct LogMatch final {
+	std::string pattern;
+	/**
+	 * Log file of the stream (stdout or stderr) and number of the line in it, from 1.
+	 */
+	std::string file;
+	int lineNumber = 0;
+	std::string line;
+};
+
+/**
+ * A solver run: the command and its arguments, executed directly (without a shell) in the
+ * working directory.
+ */
+struct SolverJob final {
+	std::vector<std::string> arguments;
+	std::string workingDirectory = ".";
+	/**
+	 * Files receiving the standard output and error of the solver, relative to the current
+	 * directory of vega (not to the working directory). Discarded if empty.
+	 */
+	std::string stdoutFile;
+	std::string stderrFile;
+	/**
+	 * Patterns searched in both streams while the solver runs.
+	 */
+	std::vector<LogPattern> patterns;
+	/**
+	 * Seconds after which the solver (and the processes it started) is killed, 0 for no limit.
+	 */
+	double timeout = 0;
+	/**
+	 * Processors and memory (MB) used by the run, reserved on the SolverQueue budget.
+	 */
+	int cpus = 1;
+	double memory = 0;
+};
+
+struct SolverJobResult final {
+	/**
+	 * False if the command could not be executed (not found, not executable).
+	 */
+	bool started = false;
+	bool timedOut = false;
+	/**
+	 * Exit code of the solver, or the signal number that terminated it if signaled.
+	 */
+	int exitCode = 0;
+	bool signaled = false;
+	std::vector<LogMatch> matches;
+	double elapsed = 0; /**< s */
+};
+
+/**
+ * Runs a solver and waits for it. The outputs are copied to the log files and scanned as they
+ * arrive, so nothing has to be read again afterwards.
+ */
+SolverJobResult runSolverJob(const SolverJob& job);
+
+/**
+ * Runs solver jobs concurrently, in their order of submission, while the processors and the
+ * memory they reserve fit in a budget. A job larger than the whole budget runs alone.
+ */
+class SolverQueue final {
+private:
+	std::mutex queueMutex;
+	std::condition_variable released;
+	int maxCpus;
+	double maxMemory;
+	int usedCpus = 0;
+	double usedMemory = 0;
+	int runningCount = 0;
+	unsigned long submittedCount = 0;
+	unsigned long startedCount = 0;
+	void acquire(const SolverJob& job, unsigned long ticket);
+	void release(const SolverJob& job);
+public:
+	/**
+	 * maxCpus: 0 for the number of hardware threads. maxMemory (MB): 0 for no limit.
+	 */
+	SolverQueue(int maxCpus = 0, double maxMemory = 0);
+	SolverQueue(const SolverQueue&) = delete;
+	SolverQueue& operator=(const SolverQueue&) = delete;
+	void setBudget(int maxCpus, double maxMemory);
+	/**
+	 * Queues a job. The queue must outlive the returned future.
+	 */
+	std::future<SolverJobResult> submit(const SolverJob& job);
+	/**
+	 * The queue shared by all the runners of the process.
+	 */
+	static SolverQueue& getInstance();
+};
+
+} /* namespace vega */
+
+#endif /* SOLVERPROCESS_H_ */
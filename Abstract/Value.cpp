@@ -23,6 +23,9 @@
 
 #include "Value.h"
 #include "Model.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 using namespace std;
 
@@ -75,6 +78,15 @@ StepRange::StepRange(const Model& model, double start, double step, int count, i
     end = start + step * count;
 }
 
+vector<double> StepRange::getValues() const {
+    vector<double> values;
+    values.reserve(static_cast<size_t>(count) + 1);
+    for (int i = 0; i <= count; i++) {
+        values.push_back(start + step * i);
+    }
+    return values;
+}
+
 shared_ptr<Value> StepRange::clone() const {
     return shared_ptr<Value>(new StepRange(*this));
 }
@@ -103,7 +115,141 @@ FunctionTable::FunctionTable(const Model& model, Interpolation parameter, Interp
 }
 
 void FunctionTable::setXY(const double X, const double Y) {
+    if (parameter == LOGARITHMIC && X <= 0) {
+        throw invalid_argument("Abscissa " + to_string(X) + " not positive in logarithmic " + to_str(*this));
+    }
+    if (value == LOGARITHMIC && Y <= 0) {
+        throw invalid_argument("Ordinate " + to_string(Y) + " not positive in logarithmic " + to_str(*this));
+    }
     valuesXY.push_back(pair<double, double>(X, Y));
+    interpolationX.push_back(toInterpolationX(X));
+    interpolationY.push_back(value == LOGARITHMIC ? log(Y) : Y);
+    const size_t size = interpolationX.size();
+    if (size >= 2) {
+        const double dx = interpolationX[size - 1] - interpolationX[size - 2];
+        slopes.push_back(is_zero(dx) ? 0.0 : (interpolationY[size - 1] - interpolationY[size - 2]) / dx);
+    }
+}
+
+double FunctionTable::toInterpolationX(double x) const {
+    if (parameter != LOGARITHMIC) {
+        return x;
+    }
+    if (x <= 0) {
+        throw invalid_argument("Abscissa " + to_string(x) + " not positive for logarithmic " + to_str(*this));
+    }
+    return log(x);
+}
+
+double FunctionTable::fromInterpolationY(double y) const {
+    return value == LOGARITHMIC ? exp(y) : y;
+}
+
+double FunctionTable::interpolate(size_t index, double x, double interpolatedX) const {
+    const size_t last = valuesXY.size() - 1;
+    if (x < valuesXY[0].first) {
+        if (left == NONE) {
+            throw out_of_range("Abscissa " + to_string(x) + " before the start of " + to_str(*this));
+        }
+        if (left == CONSTANT || last == 0) {
+            return interpolationY[0];
+        }
+    } else if (x > valuesXY[last].first) {
+        if (right == NONE) {
+            throw out_of_range("Abscissa " + to_string(x) + " after the end of " + to_str(*this));
+        }
+        if (right == CONSTANT || last == 0) {
+            return interpolationY[last];
+        }
+    } else if (parameter == NONE || value == NONE) {
+        for (size_t i = index; i <= min(index + 1, last); i++) {
+            if (is_equal(x, valuesXY[i].first)) {
+                return interpolationY[i];
+            }
+        }
+        throw out_of_range("Abscissa " + to_string(x) + " not in " + to_str(*this));
+    } else if (parameter == CONSTANT || value == CONSTANT || last == 0) {
+        return interpolationY[index];
+    }
+    return interpolationY[index] + (interpolatedX - interpolationX[index]) * slopes[index];
+}
+
+double FunctionTable::evaluate(double x) const {
+    if (valuesXY.empty()) {
+        throw out_of_range("Evaluation of the empty " + to_str(*this));
+    }
+    // index of the segment: the last abscissa <= x, and at most the start of the last segment
+    const auto it = upper_bound(valuesXY.begin(), valuesXY.end(), x,
+            [](double abscissa, const pair<double, double>& xy) {return abscissa < xy.first;});
+    size_t index = static_cast<size_t>(max(it - valuesXY.begin() - 1, ptrdiff_t(0)));
+    index = min(index, slopes.empty() ? size_t(0) : slopes.size() - 1);
+    return fromInterpolationY(interpolate(index, x, toInterpolationX(x)));
+}
+
+vector<double> FunctionTable::evaluate(const vector<double>& sortedX) const {
+    if (!is_sorted(sortedX.begin(), sortedX.end())) {
+        throw invalid_argument("Abscissae not sorted for evaluation of " + to_str(*this));
+    }
+    vector<double> result(sortedX.size());
+    if (sortedX.empty()) {
+        return result;
+    }
+    if (valuesXY.empty()) {
+        throw out_of_range("Evaluation of the empty " + to_str(*this));
+    }
+    vector<double> transformedX(sortedX);
+    if (parameter == LOGARITHMIC) {
+        // the abscissae are sorted: checking the first one checks them all
+        toInterpolationX(sortedX[0]);
+        for (double& x : transformedX) {
+            x = log(x);
+        }
+    }
+    const bool linear = !slopes.empty() && parameter != NONE && value != NONE
+            && parameter != CONSTANT && value != CONSTANT;
+    const size_t lastSegment = slopes.empty() ? 0 : slopes.size() - 1;
+    size_t j = 0;
+    for (size_t index = 0; index <= lastSegment && j < sortedX.size(); index++) {
+        // the points of this segment, and the ones before the table for the first one, after
+        // the table for the last one
+        size_t runEnd = j;
+        while (runEnd < sortedX.size()
+                && (index == lastSegment || sortedX[runEnd] < valuesXY[index + 1].first)) {
+            runEnd++;
+        }
+        size_t runBegin = j;
+        while (runBegin < runEnd && sortedX[runBegin] < valuesXY[index].first) {
+            result[runBegin] = interpolate(index, sortedX[runBegin], transformedX[runBegin]);
+            runBegin++;
+        }
+        size_t insideEnd = runEnd;
+        while (insideEnd > runBegin && sortedX[insideEnd - 1] > valuesXY[valuesXY.size() - 1].first) {
+            insideEnd--;
+            result[insideEnd] = interpolate(index, sortedX[insideEnd], transformedX[insideEnd]);
+        }
+        if (linear) {
+            // one affine function for the whole run of the segment
+            const double x0 = interpolationX[index];
+            const double y0 = interpolationY[index];
+            const double slope = slopes[index];
+            const double* xs = transformedX.data();
+            double* ys = result.data();
+            for (size_t k = runBegin; k < insideEnd; k++) {
+                ys[k] = y0 + (xs[k] - x0) * slope;
+            }
+        } else {
+            for (size_t k = runBegin; k < insideEnd; k++) {
+                result[k] = interpolate(index, sortedX[k], transformedX[k]);
+            }
+        }
+        j = runEnd;
+    }
+    if (value == LOGARITHMIC) {
+        for (double& y : result) {
+            y = exp(y);
+        }
+    }
+    return result;
 }
 
 const vector<pair<double, double>>::const_iterator FunctionTable::getBeginValuesXY() const {
@@ -114,6 +260,18 @@ const vector<pair<double, double>>::const_iterator FunctionTable::getEndValuesXY
     return valuesXY.end();
 }
 
+vector<double> FunctionTable::getPayload() const {
+    vector<double> payload = {static_cast<double>(parameter), static_cast<double>(value),
+            static_cast<double>(left), static_cast<double>(right), static_cast<double>(paraX),
+            static_cast<double>(paraY)};
+    payload.reserve(payload.size() + 2 * valuesXY.size());
+    for (const auto& xy : valuesXY) {
+        payload.push_back(xy.first);
+        payload.push_back(xy.second);
+    }
+    return payload;
+}
+
 shared_ptr<Value> FunctionTable::clone() const {
     return shared_ptr<Value>(new FunctionTable(*this));
 }
@@ -27,6 +27,7 @@
 #include "Object.h"
 
 #include <climits>
+#include <cstddef>
 #include <map>
 #include <vector>
 #include <memory>
@@ -133,9 +134,17 @@ public:
             NO_ORIGINAL_ID);
     StepRange(const Model& model, double start, double step, int count, int original_id =
             NO_ORIGINAL_ID);
+    /**
+     * The count + 1 values of the range, from start to end.
+     */
+    std::vector<double> getValues() const;
     std::shared_ptr<Value> clone() const;
 };
 
+/**
+ * Frequencies spread around the modes (FREQ4): unlike a StepRange, their values can't be
+ * listed, the modes being only known once computed by the solver.
+ */
 class SpreadRange: public ValueRange {
 public:
     const double start;
@@ -158,6 +167,21 @@ protected:
 class FunctionTable: public Function {
 protected:
     std::vector<std::pair<double, double> > valuesXY;
+private:
+    /**
+     * Abscissae and ordinates transformed by the interpolation (log for LOGARITHMIC),
+     * and slope of each segment between them, kept up to date by setXY().
+     */
+    std::vector<double> interpolationX;
+    std::vector<double> interpolationY;
+    std::vector<double> slopes;
+    double toInterpolationX(double x) const;
+    double fromInterpolationY(double y) const;
+    /**
+     * Value, in the interpolation space, in x of the segment starting at index, or of its
+     * extension when x is out of the table.
+     */
+    double interpolate(std::size_t index, double x, double interpolatedX) const;
     public:
     enum Interpolation {
         LINEAR,
@@ -175,9 +199,30 @@ public:
     FunctionTable(const Model&, Interpolation parameter = LINEAR, Interpolation value = LINEAR,
             Interpolation left = NONE, Interpolation right = NONE,
             int original_id = NO_ORIGINAL_ID);
+    /**
+     * Adds a point to the table. The abscissae must be given in increasing order.
+     * Throws invalid_argument if a LOGARITHMIC abscissa or ordinate is not positive.
+     */
     void setXY(const double X, const double Y);
     const std::vector<std::pair<double, double> >::const_iterator getBeginValuesXY() const;
     const std::vector<std::pair<double, double> >::const_iterator getEndValuesXY() const;
+    /**
+     * Value of the function in x, found by a binary search on the abscissae.
+     * Throws out_of_range if x is outside the table on a side where the prolongation
+     * (left or right) is NONE, or is not one of the abscissae when the interpolation is NONE,
+     * and invalid_argument if x is not positive with a LOGARITHMIC parameter.
+     */
+    double evaluate(double x) const;
+    /**
+     * Values of the function at increasing abscissae (a frequency grid for instance), computed
+     * in a single walk along the table.
+     */
+    std::vector<double> evaluate(const std::vector<double>& sortedX) const;
+    /**
+     * Interpolations, parameter names and points of the table: tables with equal payloads
+     * are interchangeable.
+     */
+    std::vector<double> getPayload() const;
     std::shared_ptr<Value> clone() const;
 };
 
@@ -62,7 +62,7 @@ const vector<string> AsterModel::DofByPosition = {
 };
 
 AsterModel::AsterModel(const vega::Model& model, const vega::ConfigurationParameters &configuration) :
-        model(model), configuration(configuration) {
+        model(model), configuration(configuration), resources(model, configuration) {
     this->phenomene = "MECANIQUE";
 }
 
@@ -99,18 +99,6 @@ const string AsterModel::getAsterVersion() const {
     return result;
 }
 
-double AsterModel::getMemjeveux() const {
-    double mem = 2048.0* model.mesh->countNodes() / 300000.0;
-    mem = max<double>(128., mem);
-    mem = min<double>(12000.0, mem);
-    return mem;
-}
-double AsterModel::getTpmax() const {
-    double time = 3600.0 * model.mesh->countNodes() / 300000.0;
-    time = max<double>(360.,time) * max(1,model.analyses.size());
-    return time;
-}
-
 const string AsterModel::getModelisations(const shared_ptr<ElementSet> elementSet) const {
     ModelType modelType = elementSet->getModelType();
     string result;
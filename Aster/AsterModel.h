@@ -13,6 +13,7 @@
 
 #include "../Abstract/Value.h"
 #include "../Abstract/ConfigurationParameters.h"
+#include "AsterResources.h"
 
 namespace vega {
 class Model;
@@ -25,12 +26,14 @@ public:
 	const vega::Model& model;
 	const vega::ConfigurationParameters configuration;
 	std::string phenomene;
+	/**
+	 * Processors, memory, time and linear solver planned for the run.
+	 */
+	const AsterResources resources;
 	AsterModel(const vega::Model& model, const vega::ConfigurationParameters &configuration);
 	virtual ~AsterModel();
 	const std::string getOutputFileName(std::string extension, bool absolute = true) const;
 	const std::string getAsterVersion() const;
-	double getMemjeveux() const;
-	double getTpmax() const;
 	const std::string getModelisations(const std::shared_ptr<ElementSet>) const;
 	static const std::map<Value::ParaName, std::string> NomParaByParaName;
 	static const std::map<FunctionTable::Interpolation, std::string> InterpolationByInterpolation;
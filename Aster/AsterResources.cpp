@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * AsterResources.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "AsterResources.h"
+#include "../Abstract/Model.h"
+#include "../Abstract/Parallel.h"
+#include "../Abstract/SolverInterfaces.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vega {
+namespace aster {
+
+using namespace std;
+
+namespace {
+
+/**
+ * Terms and flops of the factorization of n DOFs, by unit of the nested dissection bounds.
+ */
+const double FACTOR_TERMS_BY_UNIT = 10.0;
+const double FACTOR_FLOPS_BY_UNIT = 10.0;
+/**
+ * Working space of MUMPS, as a ratio of the size of the factors.
+ */
+const double MUMPS_WORKSPACE_RATIO = 1.5;
+/**
+ * Copies of the assembled matrix: elementary terms, assembled matrix, MUMPS input.
+ */
+const double MATRIX_COPIES = 3.0;
+/**
+ * Memory (MB) of the executable, the mesh and the fields.
+ */
+const double BASE_MEMORY = 512.0;
+const double FLOPS_BY_CPU = 1.0e9;
+/**
+ * Margin on the estimated time: assembly, post-processing and writing of the results.
+ */
+const double TIME_SAFETY_FACTOR = 4.0;
+/**
+ * Newton iterations by increment of a nonlinear analysis (REAC_ITER=1 factorizes the
+ * tangent matrix at each iteration).
+ */
+const double NEWTON_ITERATIONS = 5.0;
+/**
+ * Modes expected when the analysis only gives a frequency band.
+ */
+const int MODES_IN_BAND = 20;
+/**
+ * Lanczos (TRI_DIAG) substitutions by mode, and additional substitutions by analysis.
+ */
+const double SUBSTITUTIONS_BY_MODE = 2.0;
+const double LANCZOS_SUBSTITUTIONS = 20.0;
+const double BYTES_BY_MB = 1024.0 * 1024.0;
+const double BYTES_BY_TERM = 8.0;
+
+}
+
+const long AsterResources::DOFS_BY_CPU;
+const long AsterResources::METIS_DOFS;
+const long AsterResources::PETSC_DOFS;
+const double AsterResources::MIN_MEMORY = 1024.0;
+const double AsterResources::MIN_TIME = 360.0;
+
+AsterResources::AsterResources(const Model& model, const ConfigurationParameters& configuration) {
+	const int nodeCount = model.mesh->countNodes();
+	dofCount = model.mesh->countDOFS();
+	const double dofsByNode = nodeCount > 0 ? static_cast<double>(dofCount) / nodeCount : 0.0;
+
+	int volumeCellCount = 0;
+	int otherCellCount = 0;
+	for (const auto& codeAndType : CellType::typeByCode) {
+		const CellType& cellType = *codeAndType.second;
+		if (cellType.numNodes == 0) {
+			continue;
+		}
+		const int cellCount = model.mesh->countCells(cellType);
+		const double cellDofs = cellType.numNodes * dofsByNode;
+		matrixTermCount += cellCount * cellDofs * cellDofs;
+		if (cellType.dimension.code == SpaceDimension::DIMENSION3D_CODE) {
+			volumeCellCount += cellCount;
+		} else if (cellType.dimension.code != SpaceDimension::DIMENSION0D_CODE) {
+			otherCellCount += cellCount;
+		}
+	}
+
+	const double n = static_cast<double>(max(dofCount, 1L));
+	if (volumeCellCount >= otherCellCount && volumeCellCount > 0) {
+		factorTermCount = FACTOR_TERMS_BY_UNIT * pow(n, 4.0 / 3.0);
+		factorizationFlops = FACTOR_FLOPS_BY_UNIT * n * n;
+	} else {
+		factorTermCount = FACTOR_TERMS_BY_UNIT * n * max(log2(n), 1.0);
+		factorizationFlops = FACTOR_FLOPS_BY_UNIT * pow(n, 1.5);
+	}
+
+	int bandedModalCount = 0;
+	for (const auto& analysis : model.analyses) {
+		switch (analysis->type) {
+		case Analysis::LINEAR_MECA_STAT:
+			factorizationCount += 1;
+			substitutionCount += 1;
+			break;
+		case Analysis::NONLINEAR_MECA_STAT: {
+			const NonLinearMecaStat& nonLinAnalysis =
+					dynamic_cast<const NonLinearMecaStat&>(*analysis);
+			const auto& strategy = dynamic_pointer_cast<NonLinearStrategy>(
+					model.find(nonLinAnalysis.strategy_reference));
+			const int increments = strategy ? max(strategy->number_of_increments, 1) : 1;
+			factorizationCount += increments * NEWTON_ITERATIONS;
+			substitutionCount += increments * NEWTON_ITERATIONS;
+			break;
+		}
+		case Analysis::LINEAR_MODAL:
+		case Analysis::LINEAR_DYNA_MODAL_FREQ: {
+			const LinearModal& linearModal = dynamic_cast<const LinearModal&>(*analysis);
+			const auto& frequencyBand = linearModal.getFrequencyBand();
+			int modes = MODES_IN_BAND;
+			if (frequencyBand && frequencyBand->num_max != Globals::UNAVAILABLE_INT
+					&& frequencyBand->num_max > 0) {
+				modes = frequencyBand->num_max;
+			}
+			modeCount += modes;
+			if (frequencyBand && !is_equal(frequencyBand->upper, Globals::UNAVAILABLE_DOUBLE)) {
+				bandedModalCount++;
+			}
+			factorizationCount += 1;
+			substitutionCount += SUBSTITUTIONS_BY_MODE * modes + LANCZOS_SUBSTITUTIONS;
+			break;
+		}
+		default:
+			factorizationCount += 1;
+			substitutionCount += 1;
+		}
+	}
+
+	// the hardware threads of the host, unless limited by the command line
+	const int maxCpus = configuration.asterMaxCpus > 0 ?
+			configuration.asterMaxCpus : static_cast<int>(countWorkers());
+	const long neededCpus = (dofCount + DOFS_BY_CPU - 1) / DOFS_BY_CPU;
+	const int cpus = static_cast<int>(max(1L, min(neededCpus, static_cast<long>(maxCpus))));
+	if (bandedModalCount > 0 && configuration.asterModalBands > 1) {
+		// one MPI process at least by sub-band, the sub-bands are solved concurrently: with
+		// fewer processors than requested sub-bands, there are fewer sub-bands
+		threads = 1;
+		mpiCpus = min(max(cpus, configuration.asterModalBands), maxCpus);
+		modalBands = min(configuration.asterModalBands, mpiCpus);
+	} else {
+		threads = cpus >= 4 ? 2 : 1;
+		mpiCpus = cpus / threads;
+		if (bandedModalCount > 0 && configuration.asterModalBands == 0) {
+			modalBands = mpiCpus;
+		}
+	}
+	distributedMesh = mpiCpus > 1;
+
+	const double factorMemory = factorTermCount * BYTES_BY_TERM * MUMPS_WORKSPACE_RATIO
+			/ mpiCpus / BYTES_BY_MB;
+	const double matrixMemory = matrixTermCount * BYTES_BY_TERM * MATRIX_COPIES
+			/ (distributedMesh ? mpiCpus : 1) / BYTES_BY_MB;
+	memoryLimit = max(MIN_MEMORY, ceil(BASE_MEMORY + factorMemory + matrixMemory));
+	if (configuration.asterMaxMemory > 0 && memoryLimit > configuration.asterMaxMemory) {
+		memoryLimit = configuration.asterMaxMemory;
+		outOfCore = true;
+	}
+
+	const double flops = factorizationCount * factorizationFlops
+			+ substitutionCount * 4.0 * factorTermCount;
+	const double solveTime = TIME_SAFETY_FACTOR * flops / (FLOPS_BY_CPU * mpiCpus * threads);
+	const double analysisCount = static_cast<double>(max<size_t>(model.analyses.size(), 1));
+	timeLimit = max(MIN_TIME * analysisCount, ceil(solveTime));
+	if (configuration.asterMaxTime > 0) {
+		timeLimit = min(timeLimit, configuration.asterMaxTime);
+	}
+}
+
+double AsterResources::getMemjeveux() const {
+	return memoryLimit / BYTES_BY_TERM;
+}
+
+vector<pair<string, string>> AsterResources::getSolverKeywords(Analysis::Type analysisType) const {
+	vector<pair<string, string>> keywords;
+	if (analysisType == Analysis::LINEAR_MECA_STAT && dofCount > PETSC_DOFS) {
+		keywords.push_back({"RENUM", "'RCMK'"});
+		keywords.push_back({"METHODE", "'PETSC'"});
+		keywords.push_back({"PRE_COND", "'LDLT_SP'"});
+	} else {
+		if (dofCount <= METIS_DOFS) {
+			keywords.push_back({"RENUM", "'PORD'"});
+		} else if (mpiCpus > 1) {
+			keywords.push_back({"RENUM", "'SCOTCH'"});
+		} else {
+			keywords.push_back({"RENUM", "'METIS'"});
+		}
+		keywords.push_back({"METHODE", "'MUMPS'"});
+		if (outOfCore) {
+			keywords.push_back({"GESTION_MEMOIRE", "'OUT_OF_CORE'"});
+		}
+	}
+	if (distributedMesh) {
+		keywords.push_back({"MATR_DISTRIBUEE", "'OUI'"});
+	}
+	return keywords;
+}
+
+}
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * AsterResources.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef ASTERRESOURCES_H_
+#define ASTERRESOURCES_H_
+
+#include "../Abstract/Analysis.h"
+#include "../Abstract/ConfigurationParameters.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vega {
+class Model;
+
+namespace aster {
+
+/**
+ * Size of the problem solved by Code_Aster, estimated from a finished Model, and the
+ * resources and linear solver settings planned from it.
+ *
+ * The estimations follow the nested dissection bounds of a sparse direct solver: the
+ * factorized matrix has about n.log(n) terms and costs n^1.5 flops for shells and beams,
+ * n^4/3 terms and n^2 flops for solids. They are only meant to size the run, the limits
+ * given on the command line (ConfigurationParameters::asterMax*) always prevail.
+ */
+class AsterResources final {
+public:
+	/**
+	 * Number of DOFs handled by each processor.
+	 */
+	static const long DOFS_BY_CPU = 50000;
+	/**
+	 * Above this number of DOFs, PORD is replaced by METIS (or SCOTCH with MPI) to renumber
+	 * the matrix.
+	 */
+	static const long METIS_DOFS = 50000;
+	/**
+	 * Above this number of DOFs, the linear static analyses use PETSc preconditioned by a
+	 * single precision MUMPS factorization instead of a direct solve.
+	 */
+	static const long PETSC_DOFS = 2000000;
+	static const double MIN_MEMORY; /**< Memory (MB) by process of the smallest studies */
+	static const double MIN_TIME; /**< Time (s) by analysis of the smallest studies */
+
+	long dofCount = 0;
+	/**
+	 * Number of terms of the elementary matrices: upper bound of the non zero terms of the
+	 * assembled matrix.
+	 */
+	double matrixTermCount = 0;
+	double factorTermCount = 0;
+	double factorizationFlops = 0;
+	/**
+	 * Number of factorizations and of forward-backward substitutions of all the analyses.
+	 */
+	double factorizationCount = 0;
+	double substitutionCount = 0;
+	/**
+	 * Number of modes computed by the modal analyses.
+	 */
+	int modeCount = 0;
+
+	int mpiCpus = 1;
+	/**
+	 * Threads by MPI process.
+	 */
+	int threads = 1;
+	double memoryLimit = MIN_MEMORY; /**< MB by process */
+	double timeLimit = MIN_TIME; /**< s */
+	/**
+	 * True if the memory needed by MUMPS exceeds the limit: the factors are then written on disk.
+	 */
+	bool outOfCore = false;
+	/**
+	 * True if each MPI process only assembles the elements of its sub-domain.
+	 */
+	bool distributedMesh = false;
+	/**
+	 * Number of frequency sub-bands of the modal analyses, each one computed by a group of
+	 * MPI processes.
+	 */
+	int modalBands = 1;
+
+	AsterResources(const Model& model, const ConfigurationParameters& configuration);
+	/**
+	 * Memory of Jeveux, the Code_Aster memory manager, in mega words of 8 bytes.
+	 */
+	double getMemjeveux() const;
+	/**
+	 * Keywords of the SOLVEUR of the command that solves an analysis, in writing order.
+	 */
+	std::vector<std::pair<std::string, std::string>> getSolverKeywords(Analysis::Type analysisType) const;
+};
+
+}
+}
+#endif /* ASTERRESOURCES_H_ */
@@ -24,7 +24,9 @@
 #include "AsterRunner.h"
 
 #include "../Abstract/ConfigurationParameters.h"
+#include "../ResultReaders/ResultComparator.h"
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <stdio.h>
@@ -46,14 +48,22 @@ Runner::ExitCode AsterRunnerImpl::execSolver(const ConfigurationParameters &conf
         string modelFile) {
     bool local = configuration.solverServer.empty() || configuration.solverServer == "localhost"
             || configuration.solverServer == "127.0.0.1";
-    string command = configuration.solverCommand.empty() ? "as_run" : configuration.solverCommand;
+    if (!local) {
+        throw logic_error("Remote server not implemented");
+    }
     fs::path modelFilePath(modelFile);
     string fname = modelFilePath.stem().string();
-    command = command + " " + modelFile + " > " + fname + ".stdout 2> " + fname + ".stderr";
+    SolverJob job;
+    job.arguments = splitCommand(configuration.solverCommand.empty() ? "as_run" : configuration.solverCommand);
+    job.arguments.push_back(fs::absolute(modelFilePath).string());
+    job.workingDirectory = configuration.outputPath;
+    job.stdoutFile = (fs::path(configuration.outputPath) / (fname + ".stdout")).string();
+    job.stderrFile = (fs::path(configuration.outputPath) / (fname + ".stderr")).string();
+    // the TEST_RESU left in the command file are printed in the messages too, this is only a
+    // fallback for the .resu file checked below
+    job.patterns.push_back({ "NOOK", "" });
+    readResources(modelFile, job);
 
-    if (configuration.outputPath != ".") {
-        command = "cd " + configuration.outputPath + " && " + command;
-    }
     vector<string> fileList = { ".mess", ".resu", ".rmed", ".stdout", ".stderr" };
     deletePreviousResultFiles(modelFile, fileList);
     fs::path repeout = modelFilePath.remove_filename();
@@ -70,55 +80,99 @@ Runner::ExitCode AsterRunnerImpl::execSolver(const ConfigurationParameters &conf
         cerr << "Repe Output Directory " + repeout.string() + " can't be created."
                 << endl;
     }
-    if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "About to launch " << command << endl;
-    }
 
-    int i = 0;
-    if (local) {
-        i = system(command.c_str());
-    } else {
-        throw logic_error("Remote server not implemented");
-    }
-    if (i != 0) {
-        cerr << "Command " << command << " exit code:" << i << endl;
-    } else if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Command " << command << " ended with exit code " << i << endl;
-    }
-
-    ExitCode exitCode = convertExecResult(i);
+    const SolverJobResult result = runJob(configuration, job);
+    ExitCode exitCode = convertJobResult(result);
 
     if (exitCode == OK) {
         //check if resu file exist
         string resuFileStr = stripExtension(modelFile) + ".resu";
-        ifstream resuFile(resuFileStr);
-        if (!(resuFile.is_open() && resuFile.good())) {
-            ostringstream str;
-            str << "Error executing Code Aster: " << resuFileStr << " not found.";
-            perror(str.str().c_str());
+        if (!fs::exists(resuFileStr)) {
+            cerr << "Error executing Code Aster: " << resuFileStr << " not found." << endl;
             exitCode = SOLVER_RESULT_NOT_FOUND;
         } else {
-            //check if it contains nook
-            string line;
-            int lineNumber = 0;
-            while (getline(resuFile, line)) {
-                lineNumber += 1;
-                if (line.find("NOOK") != string::npos) {
-                    cerr << "Test fail: line " << lineNumber << " file: " << resuFileStr << endl;
-                    exitCode = TEST_FAIL;
+            //check if it contains nook: the TEST_RESU left in the command file
+            ifstream resuFile(resuFileStr);
+            if (resuFile.is_open() && resuFile.good()) {
+                string line;
+                int lineNumber = 0;
+                while (getline(resuFile, line)) {
+                    lineNumber += 1;
+                    if (line.find("NOOK") != string::npos) {
+                        cerr << "Test fail: line " << lineNumber << " file: " << resuFileStr << endl;
+                        exitCode = TEST_FAIL;
+                    }
                 }
+            } else if (!result.matches.empty()) {
+                // unreadable .resu: fall back on the NOOK seen in the solver output
+                cerr << "Test fail in the output of Code Aster: " << resuFileStr << " can't be read."
+                        << endl;
+                exitCode = TEST_FAIL;
+            }
+            if (exitCode == OK) {
+                exitCode = compareResults(configuration, modelFile);
             }
             if (exitCode == OK && configuration.logLevel >= LogLevel::DEBUG
                     && !configuration.resultFile.empty()) {
                 cout << "Tests OK." << endl;
             }
         }
-    } else if (i == 4) { //handle the case of code_aster exit code 4
+    } else if (exitCode == SOLVER_EXIT_NOT_ZERO && result.exitCode == 4) { //handle the case of code_aster exit code 4
         exitCode = TRANSLATION_SYNTAX_ERROR;
     }
     return exitCode;
 }
 
+void AsterRunnerImpl::readResources(const string& exportFile, SolverJob& job) const {
+    ifstream exportStream(exportFile);
+    string line;
+    int mpiCpus = 1;
+    int threads = 1;
+    double memoryLimit = 0;
+    while (getline(exportStream, line)) {
+        istringstream lineStream(line);
+        string type, name;
+        lineStream >> type >> name;
+        if (type != "P") {
+            continue;
+        }
+        if (name == "mpi_nbcpu") {
+            lineStream >> mpiCpus;
+        } else if (name == "ncpus") {
+            lineStream >> threads;
+        } else if (name == "memory_limit") {
+            lineStream >> memoryLimit;
+        }
+    }
+    job.cpus = max(mpiCpus, 1) * max(threads, 1);
+    job.memory = max(mpiCpus, 1) * memoryLimit;
+}
+
+Runner::ExitCode AsterRunnerImpl::compareResults(const ConfigurationParameters &configuration,
+        const string& modelFile) const {
+    const string referenceFileStr = stripExtension(modelFile) + ".ref";
+    if (!fs::exists(referenceFileStr)) {
+        return OK;
+    }
+    const string rmedFileStr = stripExtension(modelFile) + ".rmed";
+    if (!fs::exists(rmedFileStr)) {
+        cerr << "Error executing Code Aster: " << rmedFileStr << " not found." << endl;
+        return SOLVER_RESULT_NOT_FOUND;
+    }
+    result::ResultComparator comparator;
+    comparator.readMed(rmedFileStr);
+    const result::ComparisonSummary summary = comparator.compare(
+            result::ResultComparator::readReferences(referenceFileStr));
+    if (!summary.ok()) {
+        cerr << "Test fail: " << summary << " file: " << rmedFileStr << endl;
+        return TEST_FAIL;
+    }
+    if (configuration.logLevel >= LogLevel::DEBUG) {
+        cout << summary << endl;
+    }
+    return OK;
+}
+
 AsterRunnerImpl::~AsterRunnerImpl() {
 
 }
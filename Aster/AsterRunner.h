@@ -17,6 +17,17 @@ namespace vega {
 namespace aster {
 
 class AsterRunnerImpl: public vega::Runner {
+private:
+	/**
+	 * Compares the displacements of the MED results with the references written next to
+	 * the command file, if any.
+	 */
+	ExitCode compareResults(const ConfigurationParameters &configuration,
+			const std::string& modelFile) const;
+	/**
+	 * Reserves the processors and the memory planned in the export file (see AsterResources).
+	 */
+	void readResources(const std::string& exportFile, SolverJob& job) const;
 public:
 	AsterRunnerImpl();
 	virtual ExitCode execSolver(const ConfigurationParameters &configuration,
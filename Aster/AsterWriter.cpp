@@ -11,10 +11,15 @@
 #include "AsterWriter.h"
 #include "build_properties.h"
 #include "../Abstract/Model.h"
+#include "../Abstract/NumberFormat.h"
+#include "../Abstract/Parallel.h"
+#include <algorithm>
 #include <cstdlib>
+#include <future>
 #include <iostream>
 #include <iomanip>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <fstream>
 #include <limits>
@@ -26,6 +31,23 @@ namespace fs = boost::filesystem;
 namespace vega {
 namespace aster {
 
+namespace {
+
+/**
+ * Objects of a set ordered by pointer, sorted by id: the blocks written for them keep the
+ * same order from one run to the next.
+ */
+template<class T>
+vector<shared_ptr<T>> sortedById(const set<shared_ptr<T>>& objects) {
+	vector<shared_ptr<T>> sorted(objects.begin(), objects.end());
+	sort(sorted.begin(), sorted.end(), [](const shared_ptr<T>& left, const shared_ptr<T>& right) {
+		return left->getId() < right->getId();
+	});
+	return sorted;
+}
+
+}
+
 AsterWriterImpl::AsterWriterImpl() {
 
 }
@@ -48,13 +70,17 @@ string AsterWriterImpl::writeModel(const shared_ptr<vega::Model> model_ptr,
 	string med_path = asterModel.getOutputFileName(".med");
 	string comm_path = asterModel.getOutputFileName(".comm");
 
-	model_ptr->mesh->writeMED(med_path.c_str());
+	// the mesh is written to MED (HDF5 I/O) while the command file is formatted
+	shared_ptr<Mesh> mesh = model_ptr->mesh;
+	future<void> medWritten = async(launch::async, [mesh, med_path]() {
+		mesh->writeMED(med_path.c_str());
+	});
 
-	ofstream comm_file_ofs;
+	BufferedOfstream comm_file_ofs;
 	//comm_file_ofs.setf(ios::scientific);
  	comm_file_ofs.precision(DBL_DIG);
 
-	ofstream exp_file_ofs;
+	BufferedOfstream exp_file_ofs;
 	exp_file_ofs.open(exp_path.c_str(), ios::trunc | ios::out);
 	if (!exp_file_ofs.is_open()) {
 		string message = string("Can't open file ") + exp_path + " for writing.";
@@ -69,23 +95,39 @@ string AsterWriterImpl::writeModel(const shared_ptr<vega::Model> model_ptr,
 		string message = string("Can't open file ") + comm_path + " for writing.";
 		throw ios::failure(message);
 	}
+	displacementReferences.clear();
 	this->writeComm(asterModel, comm_file_ofs);
 	comm_file_ofs.close();
+
+	// the displacements are compared to the MED results by AsterRunnerImpl after the run
+	const string ref_path = asterModel.getOutputFileName(".ref");
+	if (!displacementReferences.empty()) {
+		result::ResultComparator::writeReferences(ref_path, displacementReferences);
+	} else if (fs::exists(ref_path)) {
+		fs::remove(ref_path);
+	}
+	medWritten.get();
 	return exp_path;
 }
 
 void AsterWriterImpl::writeExport(AsterModel &model, ostream& out) {
+	const AsterResources& resources = model.resources;
 	out << "P actions make_etude" << endl;
 	out << "P mem_aster 100.0" << endl;
 	out << "P mode interactif" << endl;
+	out << "P mpi_nbcpu " << resources.mpiCpus << endl;
+	out << "P mpi_nbnoeud 1" << endl;
+	out << "P ncpus " << resources.threads << endl;
+	out << "P memory_limit " << resources.memoryLimit << endl;
+	out << "P time_limit " << resources.timeLimit << endl;
 	if (model.model.analyses.size() == 0) {
 		out << "P copy_result_alarm no" << endl;
 	}
 	out << "P nomjob " << model.model.name << endl;
 	out << "P origine Vega++ " << VEGA_VERSION_MAJOR << "." << VEGA_VERSION_MINOR << endl;
 	out << "P version " << model.getAsterVersion() << endl;
-	out << "A memjeveux " << model.getMemjeveux() << endl;
-	out << "A tpmax " << model.getTpmax() << endl;
+	out << "A memjeveux " << resources.getMemjeveux() << endl;
+	out << "A tpmax " << resources.timeLimit << endl;
 	out << "F comm " << model.getOutputFileName(".comm", false) << " D 1" << endl;
 	out << "F mail " << model.getOutputFileName(".med", false) << " D 20" << endl;
 	out << "F mess " << model.getOutputFileName(".mess", false) << " R 6" << endl;
@@ -227,16 +269,19 @@ void AsterWriterImpl::writeAnalyses(const AsterModel& asterModel, ostream& out)
 			out << "           FORCE = 'REAC_NODA'," << endl;
 			out << ")" << endl;
 		}
-		vector<shared_ptr<Assertion>> assertions = analysis.getAssertions();
+		vector<shared_ptr<Assertion>> assertions;
+		for (shared_ptr<Assertion> assertion : analysis.getAssertions()) {
+			if (assertion->type == Assertion::NODAL_DISPLACEMENT_ASSERTION) {
+				addDisplacementReference(asterModel, analysis, *assertion);
+			} else {
+				assertions.push_back(assertion);
+			}
+		}
 		if (!assertions.empty()) {
 			out << "TEST_RESU(RESU = (" << endl;
 
 			for (shared_ptr<Assertion> assertion : assertions) {
 				switch (assertion->type) {
-				case Assertion::NODAL_DISPLACEMENT_ASSERTION:
-					out << "                  _F(RESULTAT=RESU" << analysis.getId() << "," << endl;
-					writeNodalDisplacementAssertion(asterModel, *assertion, out);
-					break;
 				case Assertion::FREQUENCY_ASSERTION:
 					out << "                  _F(RESULTAT="
 							<< ((analysis.type == Analysis::LINEAR_MODAL) ? "RESU" : "MODES")
@@ -319,9 +364,27 @@ void AsterWriterImpl::writeAffeModele(const AsterModel& asterModel, ostream& out
 		}
 	}
 	out << "                          )," << endl;
+	if (asterModel.resources.distributedMesh) {
+		out << "                    DISTRIBUTION=_F(METHODE='SOUS_DOMAINE',PARTITIONNEUR='METIS',),"
+				<< endl;
+	}
 	out << "                    );" << endl << endl;
 }
 
+string AsterWriterImpl::getSolveur(const AsterModel& asterModel, Analysis::Type analysisType,
+		const string& separator) const {
+	ostringstream solveur;
+	bool first = true;
+	for (const auto& keyword : asterModel.resources.getSolverKeywords(analysisType)) {
+		if (!first) {
+			solveur << separator;
+		}
+		solveur << keyword.first << "=" << keyword.second;
+		first = false;
+	}
+	return solveur.str();
+}
+
 string AsterWriterImpl::writeValue(Value& value, ostream& out) {
 	string concept_name;
 
@@ -651,8 +714,9 @@ void AsterWriterImpl::writeAffeCaraElemPoutre(const ElementSet& elementSet, ostr
 }
 
 void AsterWriterImpl::writeAffeCharMeca(const AsterModel& asterModel, ostream& out) {
+	vector<shared_ptr<ConstraintSet>> constraintSets;
 	for (auto it : asterModel.model.constraintSets) {
-		ConstraintSet& constraintSet = *it;
+		const ConstraintSet& constraintSet = *it;
 		if (constraintSet.getConstraints().size() == 0) {
 			//GC fix for http://hotline.alneos.fr/redmine/issues/801.
 			//What is the meaning of an empty constraintset?
@@ -664,35 +728,61 @@ void AsterWriterImpl::writeAffeCharMeca(const AsterModel& asterModel, ostream& o
 			// TODO LD primitive way to handle contacts, add isContact() methods instead
 			continue;
 		}
-		if (constraintSet.isOriginal()) {
-			out << "# ConstraintSet original id : " << constraintSet.getOriginalId() << endl;
-		}
-		out << "BL" << constraintSet.getId() << "=AFFE_CHAR_MECA(MODELE=MODMECA," << endl;
-		writeSPC(asterModel, constraintSet, out);
-		writeLIAISON_SOLIDE(asterModel, constraintSet, out);
-		writeRBE3(asterModel, constraintSet, out);
-		writeLMPC(asterModel, constraintSet, out);
-		out << "                   );" << endl << endl;
+		constraintSets.push_back(it);
 	}
-
+	vector<shared_ptr<LoadSet>> loadSets;
 	for (auto it : asterModel.model.loadSets) {
-		LoadSet& loadSet = *it;
-		if (loadSet.type == LoadSet::DLOAD) {
-			continue;
+		if (it->type != LoadSet::DLOAD) {
+			loadSets.push_back(it);
 		}
-		if (loadSet.isOriginal()) {
-			out << "# LoadSet original id : " << loadSet.getOriginalId() << endl;
+	}
+
+	// each AFFE_CHAR_MECA is formatted in its own buffer, then they are written in order
+	const size_t chargeCount = constraintSets.size() + loadSets.size();
+	vector<string> charges(chargeCount);
+	parallelFor(chargeCount, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			ostringstream charge;
+			charge.copyfmt(out);
+			if (i < constraintSets.size()) {
+				writeAffeCharMeca(asterModel, *constraintSets[i], charge);
+			} else {
+				writeAffeCharMeca(*loadSets[i - constraintSets.size()], charge);
+			}
+			charges[i] = charge.str();
 		}
-		out << "CHMEC" << loadSet.getId() << "=AFFE_CHAR_MECA(MODELE=MODMECA," << endl;
-		writePression(loadSet, out);
-		writeForceCoque(loadSet, out);
-		writeNodalForce(loadSet, out);
-		writeForceSurface(loadSet, out);
-		writeForceLine(loadSet, out);
-		writeGravity(loadSet, out);
-		writeRotation(loadSet, out);
-		out << "                      );" << endl << endl;
+	});
+	for (const string& charge : charges) {
+		out << charge;
+	}
+}
+
+void AsterWriterImpl::writeAffeCharMeca(const AsterModel& asterModel,
+		const ConstraintSet& constraintSet, ostream& out) {
+	if (constraintSet.isOriginal()) {
+		out << "# ConstraintSet original id : " << constraintSet.getOriginalId() << endl;
 	}
+	out << "BL" << constraintSet.getId() << "=AFFE_CHAR_MECA(MODELE=MODMECA," << endl;
+	writeSPC(asterModel, constraintSet, out);
+	writeLIAISON_SOLIDE(asterModel, constraintSet, out);
+	writeRBE3(asterModel, constraintSet, out);
+	writeLMPC(asterModel, constraintSet, out);
+	out << "                   );" << endl << endl;
+}
+
+void AsterWriterImpl::writeAffeCharMeca(const LoadSet& loadSet, ostream& out) {
+	if (loadSet.isOriginal()) {
+		out << "# LoadSet original id : " << loadSet.getOriginalId() << endl;
+	}
+	out << "CHMEC" << loadSet.getId() << "=AFFE_CHAR_MECA(MODELE=MODMECA," << endl;
+	writePression(loadSet, out);
+	writeForceCoque(loadSet, out);
+	writeNodalForce(loadSet, out);
+	writeForceSurface(loadSet, out);
+	writeForceLine(loadSet, out);
+	writeGravity(loadSet, out);
+	writeRotation(loadSet, out);
+	out << "                      );" << endl << endl;
 }
 
 void AsterWriterImpl::writeDefiContact(const AsterModel& asterModel, ostream& out) {
@@ -778,7 +868,8 @@ void AsterWriterImpl::writeDefiContact(const AsterModel& asterModel, ostream& ou
 
 void AsterWriterImpl::writeSPC(const AsterModel& asterModel, const ConstraintSet& cset,
 		ostream&out) {
-	const set<shared_ptr<Constraint>> spcs = cset.getConstraintsByType(Constraint::SPC);
+	const vector<shared_ptr<Constraint>> spcs =
+			sortedById(cset.getConstraintsByType(Constraint::SPC));
 	if (spcs.size() > 0) {
 		out << "                   DDL_IMPO=(" << endl;
 		for (shared_ptr<Constraint> constraint : spcs) {
@@ -828,10 +919,10 @@ void AsterWriterImpl::writeSPC(const AsterModel& asterModel, const ConstraintSet
 void AsterWriterImpl::writeLIAISON_SOLIDE(const AsterModel& asterModel, const ConstraintSet& cset,
 		ostream& out) {
 
-	const set<shared_ptr<Constraint>> rigidConstraints = cset.getConstraintsByType(
-			Constraint::RIGID);
-	const set<shared_ptr<Constraint>> quasiRigidConstraints = cset.getConstraintsByType(
-			Constraint::QUASI_RIGID);
+	const vector<shared_ptr<Constraint>> rigidConstraints = sortedById(cset.getConstraintsByType(
+			Constraint::RIGID));
+	const vector<shared_ptr<Constraint>> quasiRigidConstraints =
+			sortedById(cset.getConstraintsByType(Constraint::QUASI_RIGID));
 	vector<shared_ptr<Constraint>> constraints;
 	constraints.reserve(rigidConstraints.size() + quasiRigidConstraints.size());
 	constraints.assign(rigidConstraints.begin(), rigidConstraints.end());
@@ -862,7 +953,8 @@ void AsterWriterImpl::writeLIAISON_SOLIDE(const AsterModel& asterModel, const Co
 
 void AsterWriterImpl::writeRBE3(const AsterModel& asterModel, const ConstraintSet& cset,
 		ostream& out) {
-	const set<shared_ptr<Constraint>> constraints = cset.getConstraintsByType(Constraint::RBE3);
+	const vector<shared_ptr<Constraint>> constraints =
+			sortedById(cset.getConstraintsByType(Constraint::RBE3));
 	if (constraints.size() > 0) {
 		out << "                   LIAISON_RBE3=(" << endl;
 		for (auto constraint : constraints) {
@@ -942,14 +1034,15 @@ void AsterWriterImpl::writeRBE3(const AsterModel& asterModel, const ConstraintSe
 
 void AsterWriterImpl::writeLMPC(const AsterModel& asterModel, const ConstraintSet& cset,
 		ostream& out) {
-	const set<shared_ptr<Constraint>> lmpcs = cset.getConstraintsByType(Constraint::LMPC);
+	const vector<shared_ptr<Constraint>> lmpcs =
+			sortedById(cset.getConstraintsByType(Constraint::LMPC));
 	if (lmpcs.size() > 0) {
 		out << "                   LIAISON_DDL=(" << endl;
 		for (shared_ptr<Constraint> constraint : lmpcs) {
 			shared_ptr<const LinearMultiplePointConstraint> lmpc = static_pointer_cast<
 					const LinearMultiplePointConstraint>(constraint);
 			out << "                                _F(NOEUD=(";
-			set<int> nodes = lmpc->nodePositions();
+			const NodeSet nodes = lmpc->nodePositions();
 			for (int nodePosition : nodes) {
 				string nodeName = asterModel.model.mesh->findNode(nodePosition).getMedName();
 				DOFS dofs = lmpc->getDOFSForNode(nodePosition);
@@ -993,7 +1086,8 @@ void AsterWriterImpl::writeLMPC(const AsterModel& asterModel, const ConstraintSe
 }
 
 void AsterWriterImpl::writeGravity(const LoadSet& loadSet, ostream& out) {
-	const set<shared_ptr<Loading>> gravities = loadSet.getLoadingsByType(Loading::GRAVITY);
+	const vector<shared_ptr<Loading>> gravities =
+			sortedById(loadSet.getLoadingsByType(Loading::GRAVITY));
 	if (gravities.size() > 0) {
 		out << "                      PESANTEUR=(" << endl;
 		for (shared_ptr<Loading> loading : gravities) {
@@ -1009,7 +1103,8 @@ void AsterWriterImpl::writeGravity(const LoadSet& loadSet, ostream& out) {
 }
 
 void AsterWriterImpl::writeRotation(const LoadSet& loadSet, ostream& out) {
-	const set<shared_ptr<Loading>> rotations = loadSet.getLoadingsByType(Loading::ROTATION);
+	const vector<shared_ptr<Loading>> rotations =
+			sortedById(loadSet.getLoadingsByType(Loading::ROTATION));
 	if (rotations.size() > 0) {
 		out << "                      ROTATION=(" << endl;
 		for (shared_ptr<Loading> loading : rotations) {
@@ -1029,7 +1124,8 @@ void AsterWriterImpl::writeRotation(const LoadSet& loadSet, ostream& out) {
 }
 
 void AsterWriterImpl::writeNodalForce(const LoadSet& loadSet, ostream& out) {
-	const set<shared_ptr<Loading>> nodalForces = loadSet.getLoadingsByType(Loading::NODAL_FORCE);
+	const vector<shared_ptr<Loading>> nodalForces =
+			sortedById(loadSet.getLoadingsByType(Loading::NODAL_FORCE));
 	if (nodalForces.size() > 0) {
 		out << "                      FORCE_NODALE=(" << endl;
 		for (shared_ptr<Loading> loading : nodalForces) {
@@ -1058,8 +1154,8 @@ void AsterWriterImpl::writeNodalForce(const LoadSet& loadSet, ostream& out) {
 
 void AsterWriterImpl::writePression(const LoadSet& loadSet, ostream& out) {
 	return; // TODO : check if the cellContainer contain skin or shell elements
-	const set<shared_ptr<Loading>> normalPressionFace = loadSet.getLoadingsByType(
-			Loading::NORMAL_PRESSION_FACE);
+	const vector<shared_ptr<Loading>> normalPressionFace = sortedById(loadSet.getLoadingsByType(
+			Loading::NORMAL_PRESSION_FACE));
 	if (normalPressionFace.size() > 0) {
 		out << "           PRESS_REP=(" << endl;
 		for (shared_ptr<Loading> pressionFace : normalPressionFace) {
@@ -1074,8 +1170,8 @@ void AsterWriterImpl::writePression(const LoadSet& loadSet, ostream& out) {
 }
 
 void AsterWriterImpl::writeForceCoque(const LoadSet& loadSet, ostream&out) {
-	const set<shared_ptr<Loading> > pressionFaces = loadSet.getLoadingsByType(
-			Loading::NORMAL_PRESSION_FACE);
+	const vector<shared_ptr<Loading>> pressionFaces = sortedById(loadSet.getLoadingsByType(
+			Loading::NORMAL_PRESSION_FACE));
 	if (pressionFaces.size() > 0) {
 		out << "           FORCE_COQUE=(" << endl;
 		for (shared_ptr<Loading> pressionFace : pressionFaces) {
@@ -1090,7 +1186,8 @@ void AsterWriterImpl::writeForceCoque(const LoadSet& loadSet, ostream&out) {
 }
 
 void AsterWriterImpl::writeForceLine(const LoadSet& loadset, ostream& out) {
-	const set<shared_ptr<Loading> > forcesLine = loadset.getLoadingsByType(Loading::FORCE_LINE);
+	const vector<shared_ptr<Loading>> forcesLine =
+			sortedById(loadset.getLoadingsByType(Loading::FORCE_LINE));
 	vector<shared_ptr<ForceLine>> forcesOnPoutres;
 	vector<shared_ptr<ForceLine>> forcesOnGeometry;
 
@@ -1138,8 +1235,8 @@ void AsterWriterImpl::writeForceLine(const LoadSet& loadset, ostream& out) {
 
 }
 void AsterWriterImpl::writeForceSurface(const LoadSet& loadSet, ostream&out) {
-	const set<shared_ptr<Loading> > forceSurfaces = loadSet.getLoadingsByType(
-			Loading::FORCE_SURFACE);
+	const vector<shared_ptr<Loading>> forceSurfaces = sortedById(loadSet.getLoadingsByType(
+			Loading::FORCE_SURFACE));
 	if (forceSurfaces.size() > 0) {
 		out << "           FORCE_FACE=(" << endl;
 		for (shared_ptr<Loading> loading : forceSurfaces) {
@@ -1184,6 +1281,39 @@ void AsterWriterImpl::writeCellContainer(const CellContainer& cellContainer, ost
 	}
 }
 
+string AsterWriterImpl::writeModalBands(const AsterModel& asterModel,
+		const LinearModal& linearModal, double lower, double upper, int bandCount, ostream& out) {
+	const int id = linearModal.getId();
+	const int intervalCount = bandCount * INFO_MODE_INTERVALS_BY_BAND;
+	// Sturm counts of the modes on a regular grid of the band
+	out << "NBMODE" << id << "=INFO_MODE(TYPE_MODE='DYNAMIQUE'," << endl;
+	out << "                    MATR_RIGI=RIGI" << id << "," << endl;
+	out << "                    MATR_MASS=MASS" << id << "," << endl;
+	out << "                    FREQ=(";
+	for (int i = 0; i <= intervalCount; i++) {
+		out << (i == intervalCount ? upper : lower + (upper - lower) * i / intervalCount) << ",";
+	}
+	out << ")," << endl;
+	out << "                    NIVEAU_PARALLELISME='COMPLET'," << endl;
+	out << "                    SOLVEUR=_F(" << getSolveur(asterModel, linearModal.type, ",")
+			<< ",NPREC=8)," << endl;
+	out << "                    );" << endl << endl;
+
+	// Bounds of the sub-bands, merging the intervals so that each sub-band has about the
+	// same number of modes
+	out << "nbmode" << id << "=NBMODE" << id << ".EXTR_TABLE().values()['NB_MODE']" << endl;
+	out << "fmin" << id << "=NBMODE" << id << ".EXTR_TABLE().values()['FREQ_MIN']" << endl;
+	out << "freq" << id << "=[" << lower << "]" << endl;
+	out << "cumul" << id << "=0" << endl;
+	out << "for i in range(len(nbmode" << id << ")-1):" << endl;
+	out << "    cumul" << id << "+=nbmode" << id << "[i]" << endl;
+	out << "    if len(freq" << id << ")<" << bandCount << " and cumul" << id << "*" << bandCount
+			<< ">=len(freq" << id << ")*max(sum(nbmode" << id << "),1):" << endl;
+	out << "        freq" << id << ".append(fmin" << id << "[i+1])" << endl;
+	out << "freq" << id << ".append(" << upper << ")" << endl << endl;
+	return "freq" + to_string(id);
+}
+
 shared_ptr<NonLinearStrategy> AsterWriterImpl::getNonLinearStrategy(
 		NonLinearMecaStat& nonLinAnalysis) {
 	shared_ptr<NonLinearStrategy> nonLinearStrategy;
@@ -1225,7 +1355,8 @@ double AsterWriterImpl::writeAnalysis(const AsterModel& asterModel, Analysis& an
 			}
 		}
 		out << "                           )," << endl;
-                out << "                    SOLVEUR=_F(RENUM='PORD',METHODE='MUMPS')," << endl;
+		out << "                    SOLVEUR=_F(" << getSolveur(asterModel, analysis.type, ",")
+				<< ")," << endl;
 		out << "                    );" << endl << endl;
 		break;
 	}
@@ -1326,7 +1457,8 @@ double AsterWriterImpl::writeAnalysis(const AsterModel& asterModel, Analysis& an
 			out << "                    ETAT_INIT=_F(EVOL_NOLI =RESU"
 					<< nonLinAnalysis.previousAnalysis->getId() << ")," << endl;
 		}
-		out << "                    SOLVEUR=_F(RENUM='PORD',METHODE='MUMPS')," << endl;
+		out << "                    SOLVEUR=_F(" << getSolveur(asterModel, analysis.type, ",")
+				<< ")," << endl;
 		out << "                    );" << endl << endl;
 		break;
 	}
@@ -1350,6 +1482,17 @@ double AsterWriterImpl::writeAnalysis(const AsterModel& asterModel, Analysis& an
 		out << "                      )," << endl;
 		out << "           );" << endl << endl;
 
+		FrequencyBand& frequencyBand = *(linearModal.getFrequencyBand());
+		const int modalBands = asterModel.resources.modalBands;
+		string freqList;
+		if (!is_equal(frequencyBand.upper, vega::Globals::UNAVAILABLE_DOUBLE) && modalBands > 1) {
+			double lower =
+					(!is_equal(frequencyBand.lower , vega::Globals::UNAVAILABLE_DOUBLE)) ?
+							frequencyBand.lower : 0.0;
+			freqList = writeModalBands(asterModel, linearModal, lower, frequencyBand.upper,
+					modalBands, out);
+		}
+
 		if (analysis.type == Analysis::LINEAR_MODAL)
 			out << "RESU";
 		else
@@ -1358,7 +1501,6 @@ double AsterWriterImpl::writeAnalysis(const AsterModel& asterModel, Analysis& an
 				<< "," << endl;
 		out << "                       MATR_MASS=MASS" << linearModal.getId() << "," << endl;
 		out << "                       SOLVEUR_MODAL=_F(METHODE='TRI_DIAG')," << endl;
-		FrequencyBand& frequencyBand = *(linearModal.getFrequencyBand());
 		if (!is_equal(frequencyBand.upper, vega::Globals::UNAVAILABLE_DOUBLE)) {
 			out << "                                    OPTION='BANDE'," << endl;
 		} else {
@@ -1367,7 +1509,9 @@ double AsterWriterImpl::writeAnalysis(const AsterModel& asterModel, Analysis& an
 
 		out << "                       CALC_FREQ=_F(" << endl;
 
-		if (!is_equal(frequencyBand.upper, vega::Globals::UNAVAILABLE_DOUBLE)) {
+		if (!freqList.empty()) {
+			out << "                                    FREQ=" << freqList << "," << endl;
+		} else if (!is_equal(frequencyBand.upper, vega::Globals::UNAVAILABLE_DOUBLE)) {
 			double lower =
 					(!is_equal(frequencyBand.lower , vega::Globals::UNAVAILABLE_DOUBLE)) ?
 							frequencyBand.lower : 0.0;
@@ -1379,9 +1523,13 @@ double AsterWriterImpl::writeAnalysis(const AsterModel& asterModel, Analysis& an
 						<< "," << endl;
 		}
 		out << "                                    )," << endl;
+		if (!freqList.empty()) {
+			out << "                       NIVEAU_PARALLELISME='COMPLET'," << endl;
+		}
 		out << "                       VERI_MODE=_F(STOP_ERREUR='NON',)," << endl;
-		out << "                       SOLVEUR=_F(METHODE='MUMPS'," << endl;
-		out << "                                  RENUM='PORD'," << endl;
+		out << "                       SOLVEUR=_F("
+				<< getSolveur(asterModel, analysis.type, ",\n                                  ")
+				<< "," << endl;
 		out << "                                  NPREC=8," << endl;
 		out << "                                  )," << endl;
 		out << "                       );" << endl << endl;
@@ -1582,25 +1730,19 @@ double AsterWriterImpl::writeAnalysis(const AsterModel& asterModel, Analysis& an
 	return debut;
 }
 
-void AsterWriterImpl::writeNodalDisplacementAssertion(const AsterModel& asterModel,
-		Assertion& assertion, ostream& out) {
-	NodalDisplacementAssertion& nda = dynamic_cast<NodalDisplacementAssertion&>(assertion);
-	Node node = asterModel.model.mesh->findNode(nda.nodePosition);
-	bool relativeComparison = abs(nda.value) >= SMALLEST_RELATIVE_COMPARISON;
-	out << "                     CRITERE = "
-			<< (relativeComparison ? "'RELATIF'," : "'ABSOLU',") << endl;
-	out << "                     NOEUD='" << node.getMedName() << "'," << endl;
-	out << "                     NOM_CMP    = '" << AsterModel::DofByPosition.at(nda.dof.position) << "'," << endl;
-	out << "                     NOM_CHAM   = 'DEPL'," << endl;
-	if (!is_equal(nda.instant, -1)) {
-		out << "                     INST = " << nda.instant << "," << endl;
-	} else {
-		out << "                     NUME_ORDRE = 1," << endl;
-	}
-
-	out << "                     VALE_CALC = " << nda.value << "," << endl;
-	out << "                     TOLE_MACHINE = (" << (relativeComparison ? nda.tolerance : 1e-5) << "," << 1e-5 << ")," << endl;
-
+void AsterWriterImpl::addDisplacementReference(const AsterModel& asterModel,
+		const Analysis& analysis, const Assertion& assertion) {
+	const NodalDisplacementAssertion& nda = dynamic_cast<const NodalDisplacementAssertion&>(assertion);
+	result::DisplacementReference reference;
+	reference.resultName = "RESU" + to_string(analysis.getId());
+	reference.instant = is_equal(nda.instant, -1) ? result::DisplacementReference::FIRST_STEP : nda.instant;
+	reference.nodeNumber = nda.nodePosition + 1;
+	reference.nodeId = asterModel.model.mesh->findNode(nda.nodePosition).id;
+	reference.component = AsterModel::DofByPosition.at(nda.dof.position);
+	reference.value = nda.value;
+	reference.relative = abs(nda.value) >= SMALLEST_RELATIVE_COMPARISON;
+	reference.tolerance = reference.relative ? nda.tolerance : 1e-5;
+	displacementReferences.push_back(reference);
 }
 
 void AsterWriterImpl::writeNodalComplexDisplacementAssertion(const AsterModel& asterModel,
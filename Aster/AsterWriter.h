@@ -21,6 +21,7 @@
 #include "../Abstract/Model.h"
 #include "../Abstract/SolverInterfaces.h"
 #include "../Abstract/ConfigurationParameters.h"
+#include "../ResultReaders/ResultComparator.h"
 
 namespace vega {
 namespace aster {
@@ -29,16 +30,36 @@ class AsterWriterImpl : public Writer{
 	string mail_name, sigm_noeu, sigm_elno, sief_elga;
 	bool calc_sigm = false;
 	static constexpr const double SMALLEST_RELATIVE_COMPARISON = 1e-7;
+	/**
+	 * Intervals of the INFO_MODE grid by modal sub-band: the finer the grid, the better the
+	 * balance of the modes between the sub-bands.
+	 */
+	static constexpr const int INFO_MODE_INTERVALS_BY_BAND = 8;
+	/**
+	 * Nodal displacements to compare with the MED results after the run, instead of
+	 * writing a TEST_RESU for each of them.
+	 */
+	std::vector<result::DisplacementReference> displacementReferences;
 
 	void writeExport(AsterModel& model, std::ostream&);
 	void writeComm(const AsterModel& model, std::ostream&);
 	void writeLireMaillage(const AsterModel&, std::ostream&);
 	void writeAffeModele(const AsterModel&, std::ostream&);
+	/**
+	 * Keywords of the SOLVEUR planned for an analysis, joined by separator.
+	 */
+	string getSolveur(const AsterModel&, Analysis::Type, const string& separator) const;
 	void writeValues(const AsterModel&, std::ostream&);
 	void writeMaterials(const AsterModel&, std::ostream&);
 	void writeAffeCaraElem(const AsterModel&, std::ostream&);
 	void writeAffeCaraElemPoutre(const ElementSet&, std::ostream&);
+	/**
+	 * Writes an AFFE_CHAR_MECA by constraint set and by load set. They are formatted
+	 * concurrently.
+	 */
 	void writeAffeCharMeca(const AsterModel&, std::ostream&);
+	void writeAffeCharMeca(const AsterModel&, const ConstraintSet&, std::ostream&);
+	void writeAffeCharMeca(const LoadSet&, std::ostream&);
 	void writeDefiContact(const AsterModel&, std::ostream&);
 	void writeSPC(const AsterModel&, const ConstraintSet&, std::ostream&);
 	void writeLIAISON_SOLIDE(const AsterModel&, const ConstraintSet&, std::ostream&);
@@ -53,7 +74,14 @@ class AsterWriterImpl : public Writer{
 	void writeForceSurface(const LoadSet&, std::ostream&);
 	void writeCellContainer(const CellContainer& cellContainer, ostream&);
 	double writeAnalysis(const AsterModel&, Analysis& analysis, std::ostream&, double debut);
-	void writeNodalDisplacementAssertion(const AsterModel&, Assertion&, std::ostream&);
+	/**
+	 * Counts the modes of [lower, upper] and splits it into bandCount sub-bands with the
+	 * same number of modes, to be computed in parallel by CALC_MODES. Returns the name of
+	 * the Python list of the bounds of the sub-bands.
+	 */
+	string writeModalBands(const AsterModel&, const LinearModal&, double lower, double upper,
+			int bandCount, std::ostream&);
+	void addDisplacementReference(const AsterModel&, const Analysis&, const Assertion&);
 	void writeNodalComplexDisplacementAssertion(const AsterModel&, Assertion&, std::ostream&);
 	void writeFrequencyAssertion(Assertion&, std::ostream&);
 	void writeLoadset(LoadSet& loadSet, std::ostream& out);
@@ -17,6 +17,7 @@
 #include "../ResultReaders/ResultReadersFacade.h"
 #include <iostream>
 #include <fstream>
+#include <future>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
@@ -107,14 +108,34 @@ VegaCommandLine::ExitCode VegaCommandLine::convertStudy(
         cout << "Selected writer: " << *writer << endl;
     }
 
+    // The result file, if any, doesn't depend on the model: it is read while the input file
+    // is parsed, and its values are added to the model once it is parsed.
+    shared_ptr<ResultReader> resultReader = result::ResultReadersFacade::getResultReader(
+            configuration);
+    future<void> resultsRead;
+    if (resultReader) {
+        resultsRead = async(launch::async, [&resultReader, &configuration]() {
+            resultReader->read(configuration);
+        });
+    }
+
     // Parsing the input file
     Parser* parser = parserIterator->second;
     shared_ptr<Model> model = parser->parse(configuration);
+    const DiagnosticCollector& diagnostics = parser->getDiagnostics();
+    diagnostics.printSummary(cerr);
+    if (!configuration.diagnosticsFile.empty()) {
+        ofstream diagnosticsFile(configuration.diagnosticsFile);
+        if (!diagnosticsFile) {
+            cerr << "Can't write the diagnostics in " << configuration.diagnosticsFile << endl;
+        } else {
+            diagnostics.writeJson(diagnosticsFile);
+        }
+    }
 
     //adding assertions if result file is set in the model
-    shared_ptr<ResultReader> resultReader = result::ResultReadersFacade::getResultReader(
-            configuration);
     if (resultReader) {
+        resultsRead.get();
         resultReader->add_assertions(configuration, model);
     }
 
@@ -192,6 +213,34 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
     } else {
         tolerance = 0.02;
     }
+    string testNodes, testDofs, testSubcases, testSteps;
+    if (vm.count("test-nodes")) {
+        testNodes = vm["test-nodes"].as<string>();
+    }
+    if (vm.count("test-dofs")) {
+        testDofs = vm["test-dofs"].as<string>();
+    }
+    if (vm.count("test-subcases")) {
+        testSubcases = vm["test-subcases"].as<string>();
+    }
+    if (vm.count("test-steps")) {
+        testSteps = vm["test-steps"].as<string>();
+    }
+    int testSampleCount = 0;
+    if (vm.count("test-sample-count")) {
+        testSampleCount = vm["test-sample-count"].as<int>();
+        if (testSampleCount < 0) {
+            throw invalid_argument("Test sample count must be positive.");
+        }
+    }
+    string testSampling = "stride";
+    if (vm.count("test-sampling")) {
+        testSampling = vm["test-sampling"].as<string>();
+        set<string> availableSamplings { "stride", "random" };
+        if (availableSamplings.find(testSampling) == availableSamplings.end()) {
+            throw invalid_argument("Test sampling must be either stride (default) or random.");
+        }
+    }
     ConfigurationParameters::TranslationMode translationMode = ConfigurationParameters::BEST_EFFORT;
     bool hasParamBestEffort = false;
     if (vm.count("best-effort")) {
@@ -249,6 +298,32 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
         solverServer = vm["solver-server"].as<string>();
         boost::algorithm::trim(solverServer);
     }
+    double solverTimeout = 0;
+    if (vm.count("solver-timeout")) {
+        solverTimeout = vm["solver-timeout"].as<double>();
+        if (solverTimeout < 0) {
+            throw invalid_argument("Solver timeout must be positive.");
+        }
+    }
+    int solverMaxCpus = 0;
+    if (vm.count("solver-max-cpus")) {
+        solverMaxCpus = vm["solver-max-cpus"].as<int>();
+        if (solverMaxCpus < 0) {
+            throw invalid_argument("Solver maximum number of processors must be positive.");
+        }
+    }
+    double solverMaxMemory = 0;
+    if (vm.count("solver-max-memory")) {
+        solverMaxMemory = vm["solver-max-memory"].as<double>();
+        if (solverMaxMemory < 0) {
+            throw invalid_argument("Solver maximum memory must be positive.");
+        }
+    }
+
+    string diagnosticsFile;
+    if (vm.count("diagnostics-file")) {
+        diagnosticsFile = normalize_path(vm["diagnostics-file"].as<string>()).string();
+    }
 
     string solverVersion;
     if (vm.count("solver-version")) {
@@ -370,10 +445,62 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
     }
 
 
+    // Option for Nastran Conversion
+    string nastranFieldFormat="small";
+    if (vm.count("nastran.FieldFormat")){
+        nastranFieldFormat = vm["nastran.FieldFormat"].as<string>();
+        set<string> availableFormats { "small", "large", "free" };
+        set<string>::iterator it = availableFormats.find(nastranFieldFormat);
+        if (it == availableFormats.end()){
+            throw invalid_argument("Nastran field format must be either small (default), large or free");
+        }
+    }
+
+    // Limits of the Code_Aster resources
+    int asterMaxCpus = 0;
+    if (vm.count("aster.MaxCpus")){
+        asterMaxCpus = vm["aster.MaxCpus"].as<int>();
+        if (asterMaxCpus < 0){
+            throw invalid_argument("Aster maximum number of processors must be positive.");
+        }
+    }
+    double asterMaxMemory = 0;
+    if (vm.count("aster.MaxMemory")){
+        asterMaxMemory = vm["aster.MaxMemory"].as<double>();
+        if (asterMaxMemory < 0){
+            throw invalid_argument("Aster maximum memory must be positive.");
+        }
+    }
+    double asterMaxTime = 0;
+    if (vm.count("aster.MaxTime")){
+        asterMaxTime = vm["aster.MaxTime"].as<double>();
+        if (asterMaxTime < 0){
+            throw invalid_argument("Aster maximum time must be positive.");
+        }
+    }
+
+    int asterModalBands = 1;
+    if (vm.count("aster.ModalBands")){
+        asterModalBands = vm["aster.ModalBands"].as<int>();
+        if (asterModalBands < 0){
+            throw invalid_argument("Aster number of modal sub-bands must be positive.");
+        }
+    }
+
     if (vm.count("listOptions")){
         cout << "VEGA options for this translation are: "<< endl;
         cout << "\t Output directory: "<< outputDir << endl;
         cout << "\t Verbosity: "<< logLevel << endl;
+        cout << "\t Diagnostics file: " << (diagnosticsFile.empty() ? "none" : diagnosticsFile) << endl;
+        cout << "\t Test nodes: " << (testNodes.empty() ? "all" : testNodes) << endl;
+        cout << "\t Test dofs: " << (testDofs.empty() ? "all" : testDofs) << endl;
+        cout << "\t Test subcases: " << (testSubcases.empty() ? "all" : testSubcases) << endl;
+        cout << "\t Test steps: " << (testSteps.empty() ? "all" : testSteps) << endl;
+        cout << "\t Test sample count: " << (testSampleCount == 0 ? "none" : to_string(testSampleCount)) << endl;
+        cout << "\t Test sampling: " << testSampling << endl;
+        cout << "\t Solver timeout: " << (is_zero(solverTimeout) ? "none" : to_string(solverTimeout)) << endl;
+        cout << "\t Solver max cpus: " << (solverMaxCpus == 0 ? "auto" : to_string(solverMaxCpus)) << endl;
+        cout << "\t Solver max memory: " << (is_zero(solverMaxMemory) ? "none" : to_string(solverMaxMemory)) << endl;
         cout << "\t Systus RBE2 Translation Mode: "<< systusRBE2TranslationMode << endl;
         cout << "\t Systus RBE2 Rigidity (for penalty mode only): " << (is_equal(systusRBE2Rigidity, Globals::UNAVAILABLE_DOUBLE) ? "auto" : to_string(systusRBE2Rigidity)) << endl;
         cout << "\t Systus RBE Lagrangian (for RBE2 lagrangian mode and RBE3): " << systusRBELagrangian << endl;
@@ -383,6 +510,11 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
         cout << "\t Systus Output Matrix: " << systusOutputMatrix << endl;
         cout << "\t Systus Size Matrix: " << systusSizeMatrix << endl;
         cout << "\t Systus Version: " << solverVersion << endl;
+        cout << "\t Nastran Field format: " << nastranFieldFormat << endl;
+        cout << "\t Aster Max cpus: " << (asterMaxCpus == 0 ? "auto" : to_string(asterMaxCpus)) << endl;
+        cout << "\t Aster Max memory: " << (is_zero(asterMaxMemory) ? "auto" : to_string(asterMaxMemory)) << endl;
+        cout << "\t Aster Max time: " << (is_zero(asterMaxTime) ? "auto" : to_string(asterMaxTime)) << endl;
+        cout << "\t Aster Modal bands: " << (asterModalBands == 0 ? "auto" : to_string(asterModalBands)) << endl;
         for (size_t i = 0; i < systusSubcases.size(); ++i) {
            cout <<"\t Systus Subcase "<<(i+1)<<": ";
            for (size_t j = 0; j < systusSubcases[i].size(); ++j)
@@ -395,7 +527,10 @@ ConfigurationParameters VegaCommandLine::readCommandLineParameters(const po::var
             solverVersion, modelName, outputDir, logLevel, translationMode, testFnamePath,
             tolerance, runSolver, solverServer, solverCommand,
             systusRBE2TranslationMode, systusRBE2Rigidity, systusRBELagrangian, systusOptionAnalysis, systusOutputProduct,
-            systusSubcases, systusOutputMatrix, systusSizeMatrix, systusDynamicMethod);
+            systusSubcases, systusOutputMatrix, systusSizeMatrix, systusDynamicMethod, nastranFieldFormat,
+            asterMaxCpus, asterMaxMemory, asterMaxTime, asterModalBands,
+            solverTimeout, solverMaxCpus, solverMaxMemory, testNodes, testDofs, testSubcases,
+            testSteps, testSampleCount, testSampling, diagnosticsFile);
     return configuration;
 }
 
@@ -474,9 +609,27 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
                 "Solver command. Default 'as_run' if outputSolver is CODEASTER") //
         ("solver-server", po::value<string>()->default_value("localhost"),
                 "Solver server for remote solver execution.") //
+        ("solver-timeout", po::value<double>(),
+                "Time (s) after which the solver is killed. Default: no limit.") //
+        ("solver-max-cpus", po::value<int>(),
+                "Processors shared by the solver runs of vega. Default: the hardware threads.") //
+        ("solver-max-memory", po::value<double>(),
+                "Memory (MB) shared by the solver runs of vega. Default: no limit.") //
+        ("diagnostics-file", po::value<string>(),
+                "JSON file listing all the problems found in the input file. Default: only a summary is printed.") //
         ("debug,d", "set debug options in solvers, verbose output") //
         ("solver-version", po::value<string>(), "output solver specific version") //
         ("tolerance,x", po::value<double>(), "use TOLERANCE during tests.") //
+        ("test-nodes", po::value<string>(),
+                "Nodes tested: ids, ranges 'first:last' and groups, e.g. '1:100,205,TOP'. Default: all.") //
+        ("test-dofs", po::value<string>(), "DOFs tested, e.g. 'DX,DY,DZ'. Default: all.") //
+        ("test-subcases", po::value<string>(), "Subcases tested: ids and ranges. Default: all.") //
+        ("test-steps", po::value<string>(),
+                "Steps, times or frequencies tested: values and ranges 'min:max'. Default: all.") //
+        ("test-sample-count", po::value<int>(),
+                "Maximum number of values tested, chosen among the selected ones. Default: no limit.") //
+        ("test-sampling", po::value<string>(),
+                "Choice of the tested values: stride (default) or random.") //
         ("best-effort,b", "All the recognized keywords in the source file are "
                 "translated, unknown keywords are skipped.") //
         ("listOptions,l", "Print the options used by current translation.") //
@@ -509,6 +662,23 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
         ("systus.SizeMatrix", po::value<int>(),
                 "Maximum size of Systus Matrix Elements: default 9 for table, 20 for file."); //
 
+        // Nastran specific options
+        po::options_description nastranOptions("Nastran specific options");
+        nastranOptions.add_options() //
+        ("nastran.FieldFormat", po::value<string>()->default_value("small"),
+                "Format of the bulk data cards written by the Nastran writer: small (default), large or free."); //
+
+        // Aster specific options
+        po::options_description asterOptions("Aster specific options");
+        asterOptions.add_options() //
+        ("aster.MaxCpus", po::value<int>(),
+                "Maximum number of processors (MPI processes x threads) of a Code_Aster run, by default the hardware threads of the host.") //
+        ("aster.MaxMemory", po::value<double>(),
+                "Maximum memory (MB) by process of a Code_Aster run.") //
+        ("aster.MaxTime", po::value<double>(),
+                "Maximum time (s) of a Code_Aster run.") //
+        ("aster.ModalBands", po::value<int>(),
+                "Number of frequency sub-bands of the modal analyses, computed in parallel: 1 (default) or 0 for one by MPI process."); //
 
         // Hidden options, will be allowed both on command line and
         // in config file, but will not be shown to the user.
@@ -521,10 +691,10 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
                 "output format. Allowed formats are ASTER, SYSTUS");
 
         po::options_description cmdline_options;
-        cmdline_options.add(commandLine).add(generic).add(systusOptions).add(hidden);
+        cmdline_options.add(commandLine).add(generic).add(asterOptions).add(systusOptions).add(nastranOptions).add(hidden);
 
         po::options_description config_file_options;
-        config_file_options.add(generic).add(systusOptions).add(hidden);
+        config_file_options.add(generic).add(asterOptions).add(systusOptions).add(nastranOptions).add(hidden);
 
         po::positional_options_description p;
         p.add("input-file", 1);
@@ -532,7 +702,7 @@ VegaCommandLine::ExitCode VegaCommandLine::process(int ac, const char* av[]) {
         p.add("output-format", 1);
 
         po::options_description visible("Options");
-        visible.add(commandLine).add(generic).add(systusOptions);
+        visible.add(commandLine).add(generic).add(asterOptions).add(systusOptions).add(nastranOptions);
 
         po::variables_map vm;
         store(po::command_line_parser(ac, av).options(cmdline_options).positional(p).run(), vm);
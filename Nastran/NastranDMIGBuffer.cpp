@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * NastranDMIGBuffer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "NastranDMIGBuffer.h"
+#include <algorithm>
+#include <fstream>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace vega {
+namespace nastran {
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+const int DMIGBuffer::NO_MATRIX;
+const size_t DMIGBuffer::DEFAULT_MEMORY_BUDGET;
+
+bool DMIGBuffer::Term::operator<(const Term& other) const {
+	if (matrixIndex != other.matrixIndex) {
+		return matrixIndex < other.matrixIndex;
+	}
+	if (colNodeId != other.colNodeId) {
+		return colNodeId < other.colNodeId;
+	}
+	if (colDofPosition != other.colDofPosition) {
+		return colDofPosition < other.colDofPosition;
+	}
+	if (rowNodeId != other.rowNodeId) {
+		return rowNodeId < other.rowNodeId;
+	}
+	return rowDofPosition < other.rowDofPosition;
+}
+
+DMIGBuffer::DMIGBuffer(size_t memoryBudget) :
+		maxTerms(max(memoryBudget / sizeof(Term), size_t(1))) {
+}
+
+DMIGBuffer::~DMIGBuffer() {
+	removeRuns();
+}
+
+int DMIGBuffer::findMatrixIndex(const string& name) const {
+	auto it = indexByName.find(name);
+	return it == indexByName.end() ? NO_MATRIX : it->second;
+}
+
+int DMIGBuffer::addMatrix(const string& name, shared_ptr<MatrixElement> matrix) {
+	const int index = static_cast<int>(matrices.size());
+	matrices.push_back(matrix);
+	indexByName[name] = index;
+	return index;
+}
+
+void DMIGBuffer::addComponent(int matrixIndex, int colNodeId, const DOF colDof, int rowNodeId,
+		const DOF rowDof, double value) {
+	if (terms.size() >= maxTerms) {
+		spill();
+	}
+	Term term;
+	term.value = value;
+	term.matrixIndex = matrixIndex;
+	term.colNodeId = colNodeId;
+	term.rowNodeId = rowNodeId;
+	term.colDofPosition = static_cast<unsigned char>(colDof.position);
+	term.rowDofPosition = static_cast<unsigned char>(rowDof.position);
+	terms.push_back(term);
+}
+
+void DMIGBuffer::spill() {
+	stable_sort(terms.begin(), terms.end());
+	const fs::path path = fs::temp_directory_path() / fs::unique_path("vega-dmig-%%%%-%%%%-%%%%.bin");
+	ofstream out(path.string(), ios::binary);
+	if (!out) {
+		throw runtime_error("Can't create temporary DMIG file " + path.string());
+	}
+	runPaths.push_back(path);
+	out.write(reinterpret_cast<const char*>(terms.data()),
+			static_cast<streamsize>(terms.size() * sizeof(Term)));
+	out.close();
+	if (!out) {
+		throw runtime_error("Can't write temporary DMIG file " + path.string());
+	}
+	terms.clear();
+}
+
+void DMIGBuffer::assemble() {
+	static const DOF* const DOF_BY_POSITION[] = { &DOF::DX, &DOF::DY, &DOF::DZ, &DOF::RX, &DOF::RY,
+			&DOF::RZ };
+	// the terms come column after column: the node and the DOF of a column are resolved once,
+	// the node of a row once for its consecutive DOFs
+	MatrixElement* matrix = nullptr;
+	int colMatrixIndex = NO_MATRIX;
+	int colNodeId = 0;
+	int colDofPosition = -1;
+	int colNodePosition = 0;
+	const DOF* colDof = nullptr;
+	int rowNodeId = 0;
+	int rowNodePosition = -1;
+	auto addTerm = [&](const Term& term) {
+		if (term.matrixIndex != colMatrixIndex || term.colNodeId != colNodeId) {
+			colMatrixIndex = term.matrixIndex;
+			colNodeId = term.colNodeId;
+			matrix = matrices[static_cast<size_t>(colMatrixIndex)].get();
+			colNodePosition = matrix->findOrReserveNode(colNodeId);
+			colDofPosition = -1;
+			rowNodePosition = -1;
+		}
+		if (term.colDofPosition != colDofPosition) {
+			colDofPosition = term.colDofPosition;
+			colDof = DOF_BY_POSITION[colDofPosition];
+		}
+		if (rowNodePosition == -1 || term.rowNodeId != rowNodeId) {
+			rowNodeId = term.rowNodeId;
+			rowNodePosition = rowNodeId == colNodeId ?
+					colNodePosition : matrix->findOrReserveNode(rowNodeId);
+		}
+		matrix->addComponentByPosition(colNodePosition, *colDof, rowNodePosition,
+				*DOF_BY_POSITION[term.rowDofPosition], term.value);
+	};
+	stable_sort(terms.begin(), terms.end());
+	if (runPaths.empty()) {
+		for (const Term& term : terms) {
+			addTerm(term);
+		}
+	} else {
+		// k-way merge of the spilled runs and of the terms in memory, which come last: for equal
+		// terms, the source index keeps the reading order.
+		const size_t memorySource = runPaths.size();
+		typedef pair<Term, size_t> Head;
+		auto comesAfter = [](const Head& head1, const Head& head2) {
+			return head2.first < head1.first
+					|| (!(head1.first < head2.first) && head1.second > head2.second);
+		};
+		priority_queue<Head, vector<Head>, decltype(comesAfter)> heads(comesAfter);
+		vector<unique_ptr<ifstream>> runs;
+		auto readTerm = [&runs](size_t source, Term& term) {
+			runs[source]->read(reinterpret_cast<char*>(&term), sizeof(Term));
+			return runs[source]->gcount() == static_cast<streamsize>(sizeof(Term));
+		};
+		Term term;
+		for (size_t source = 0; source < memorySource; source++) {
+			runs.emplace_back(new ifstream(runPaths[source].string(), ios::binary));
+			if (!*runs.back()) {
+				throw runtime_error("Can't read temporary DMIG file " + runPaths[source].string());
+			}
+			if (readTerm(source, term)) {
+				heads.push(make_pair(term, source));
+			}
+		}
+		size_t memoryPosition = 0;
+		if (!terms.empty()) {
+			heads.push(make_pair(terms[memoryPosition++], memorySource));
+		}
+		while (!heads.empty()) {
+			const Head head = heads.top();
+			heads.pop();
+			addTerm(head.first);
+			if (head.second == memorySource) {
+				if (memoryPosition < terms.size()) {
+					heads.push(make_pair(terms[memoryPosition++], memorySource));
+				}
+			} else if (readTerm(head.second, term)) {
+				heads.push(make_pair(term, head.second));
+			}
+		}
+	}
+	removeRuns();
+	terms.clear();
+	terms.shrink_to_fit();
+	matrices.clear();
+	indexByName.clear();
+}
+
+size_t DMIGBuffer::countSpilledRuns() const {
+	return runPaths.size();
+}
+
+void DMIGBuffer::removeRuns() {
+	for (const fs::path& path : runPaths) {
+		boost::system::error_code error;
+		fs::remove(path, error);
+	}
+	runPaths.clear();
+}
+
+} /* namespace nastran */
+} /* namespace vega */
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * NastranDMIGBuffer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef NASTRANDMIGBUFFER_H_
+#define NASTRANDMIGBUFFER_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include "../Abstract/Element.h"
+
+namespace vega {
+namespace nastran {
+
+/**
+ * Collects the terms of the DMIG matrices while the bulk section is parsed, as compact
+ * (column, row, value) triplets. When the buffer exceeds its memory budget, the triplets are
+ * sorted and spilled into a temporary file. assemble() merges the sorted runs and adds the
+ * terms to their MatrixElement, column after column.
+ */
+class DMIGBuffer final {
+public:
+	static const int NO_MATRIX = -1;
+	static const std::size_t DEFAULT_MEMORY_BUDGET = 64 << 20;
+	explicit DMIGBuffer(std::size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+	DMIGBuffer(const DMIGBuffer&) = delete;
+	DMIGBuffer& operator=(const DMIGBuffer&) = delete;
+	~DMIGBuffer();
+	/**
+	 * @return the index of the matrix, or NO_MATRIX if no matrix with this name was added.
+	 */
+	int findMatrixIndex(const std::string& name) const;
+	int addMatrix(const std::string& name, std::shared_ptr<MatrixElement> matrix);
+	void addComponent(int matrixIndex, int colNodeId, const DOF colDof, int rowNodeId,
+			const DOF rowDof, double value);
+	/**
+	 * Adds all the buffered terms to their matrices, in the order of the columns, then empties
+	 * the buffer. A term given several times keeps its last value, as with
+	 * MatrixElement::addComponent().
+	 */
+	void assemble();
+	std::size_t countSpilledRuns() const;
+private:
+	struct Term {
+		double value;
+		int matrixIndex;
+		int colNodeId;
+		int rowNodeId;
+		unsigned char colDofPosition;
+		unsigned char rowDofPosition;
+		bool operator<(const Term& other) const;
+	};
+	std::size_t maxTerms;
+	std::vector<Term> terms;
+	std::vector<std::shared_ptr<MatrixElement>> matrices;
+	std::unordered_map<std::string, int> indexByName;
+	std::vector<boost::filesystem::path> runPaths;
+	/**
+	 * Sorts the buffered terms and writes them into a new temporary file.
+	 */
+	void spill();
+	void removeRuns();
+};
+
+} /* namespace nastran */
+} /* namespace vega */
+
+#endif /* NASTRANDMIGBUFFER_H_ */
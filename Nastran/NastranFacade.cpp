@@ -19,6 +19,10 @@ NastranParser::NastranParser() :
 shared_ptr<Model> NastranParser::parse(const ConfigurationParameters& configuration) {
 	return pimpl->parse(configuration);
 }
+
+DiagnosticCollector& NastranParser::getDiagnostics() {
+	return pimpl->getDiagnostics();
+}
 NastranParser::~NastranParser() {
 
 }
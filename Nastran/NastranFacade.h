@@ -42,6 +42,7 @@ private:
 	public:
 	NastranParser();
 	std::shared_ptr<Model> parse(const ConfigurationParameters& configuration) override;
+	DiagnosticCollector& getDiagnostics() override;
 	virtual ~NastranParser();
 };
 
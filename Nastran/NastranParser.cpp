@@ -30,6 +30,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <functional>
 #include <ciso646>
 
 namespace vega {
@@ -77,6 +78,7 @@ const unordered_map<string, NastranParserImpl::parseElementFPtr> NastranParserIm
                 { "CORD2C", &NastranParserImpl::parseCORD2C },
                 { "CORD2R", &NastranParserImpl::parseCORD2R },
                 { "CPENTA", &NastranParserImpl::parseCPENTA },
+                { "CPYRAM", &NastranParserImpl::parseCPYRAM },
                 { "CPYRAMID", &NastranParserImpl::parseCPYRAM },
                 { "CQUAD", &NastranParserImpl::parseCQUAD },
                 { "CQUAD4", &NastranParserImpl::parseCQUAD4 },
@@ -410,6 +412,8 @@ shared_ptr<Model> NastranParserImpl::parse(const ConfigurationParameters& config
     const string inputFilePathStr = inputFilePath.string();
     ifstream istream(inputFilePathStr);
     NastranTokenizer tok = NastranTokenizer(istream, logLevel, inputFilePath.string(), this->translationMode);
+    diagnostics.clear();
+    tok.setDiagnostics(&diagnostics);
 
     if (model->configuration.logLevel >= LogLevel::DEBUG) {
         cout << "Parsing Executive section." << endl;
@@ -420,8 +424,11 @@ shared_ptr<Model> NastranParserImpl::parse(const ConfigurationParameters& config
         cout << "Parsing BULK section." << endl;
     }
     tok.bulkSection();
+    tok.setSkippedCardFilter("DMIG", bind(&NastranParserImpl::isUnusedDMIGColumn, this,
+            placeholders::_1, placeholders::_2));
     parseBULKSection(tok, model);
     istream.close();
+    dmigBuffer.assemble();
 
     if (model->configuration.logLevel >= LogLevel::DEBUG) {
         cout << "Parsing finished." << endl;
@@ -895,9 +902,12 @@ void NastranParserImpl::parseDMIG(NastranTokenizer& tok, shared_ptr<Model> model
         }
     }
 
-    shared_ptr<MatrixElement> matrix = static_pointer_cast<MatrixElement>(
+    int matrixIndex = dmigBuffer.findMatrixIndex(name);
+    if (matrixIndex == DMIGBuffer::NO_MATRIX) {
+        shared_ptr<MatrixElement> matrix = static_pointer_cast<MatrixElement>(
                 model->find(*(it->second)));
-
+        matrixIndex = dmigBuffer.addMatrix(name, matrix);
+    }
 
     int gj = headerIndicator;
     int cj = tok.nextInt();
@@ -909,10 +919,16 @@ void NastranParserImpl::parseDMIG(NastranTokenizer& tok, shared_ptr<Model> model
         DOF dof1 = *(DOFS::nastranCodeToDOFS(c1).begin());
         double a1 = tok.nextDouble();
         tok.nextDouble(true, 0.0);
-        matrix->addComponent(gj, dofj, g1, dof1, a1);
+        dmigBuffer.addComponent(matrixIndex, gj, dofj, g1, dof1, a1);
     }
 }
 
+bool NastranParserImpl::isUnusedDMIGColumn(const string& name, const string& gj) const {
+    // the header cards (GJ = 0) are still parsed, to warn about the unused matrix
+    return gj != "0" && name != "UACCEL" && name != "CDSHUT"
+            && directMatrixByName.find(name) == directMatrixByName.end();
+}
+
 void NastranParserImpl::parseDPHASE(NastranTokenizer& tok, shared_ptr<Model> model) {
     int original_id = tok.nextInt();
     int p = tok.nextInt(true);
@@ -1134,7 +1150,10 @@ void NastranParserImpl::parseInclude(NastranTokenizer& tok, shared_ptr<Model> mo
     if (fs::exists(includePath)) {
         ifstream istream(includePathStr);
         NastranTokenizer tok2 = NastranTokenizer(istream, this->logLevel, includePathStr, this->translationMode);
+        tok2.setDiagnostics(&diagnostics);
         tok2.bulkSection();
+        tok2.setSkippedCardFilter("DMIG", bind(&NastranParserImpl::isUnusedDMIGColumn, this,
+                placeholders::_1, placeholders::_2));
         tok2.nextLine();
         parseBULKSection(tok2, model);
         istream.close();
@@ -2469,6 +2488,11 @@ void NastranParserImpl::parseTABLED1(NastranTokenizer& tok, shared_ptr<Model> mo
                 handleParsingWarning("Invalid key ("+sField+") should be SKIP or a real.", tok, model);
             }
         }
+        if ((parameter == FunctionTable::LOGARITHMIC && x <= 0)
+                || (value == FunctionTable::LOGARITHMIC && y <= 0)) {
+            handleParsingError("Point (" + to_string(x) + ", " + to_string(y)
+                    + ") not positive in a logarithmic table.", tok, model);
+        }
         functionTable.setXY(x, y);
     }
     
@@ -28,6 +28,7 @@
 #include "../Abstract/Model.h"
 #include "../Abstract/SolverInterfaces.h"
 #include "NastranTokenizer.h"
+#include "NastranDMIGBuffer.h"
 
 namespace vega {
 
@@ -35,8 +36,12 @@ namespace nastran {
 
 namespace fs = boost::filesystem;
 
+class NastranWriterImpl;
+
 class NastranParserImpl: public vega::Parser {
 private:
+    // the writer uses nastran2medNodeConnectByCellType to restore the Nastran node order
+    friend NastranWriterImpl;
     class GrdSet {
     public:
         GrdSet(const int cp = CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID,
@@ -52,6 +57,10 @@ private:
     GrdSet grdSet;
 
     std::unordered_map<string, shared_ptr<Reference<ElementSet>>> directMatrixByName;
+    /**
+     * Terms of the DMIG matrices, added to the model at the end of the parsing.
+     */
+    DMIGBuffer dmigBuffer;
     typedef void (NastranParserImpl::*parseElementFPtr)(NastranTokenizer& tok, std::shared_ptr<Model> model);
     static const std::set<string> IGNORED_KEYWORDS;
     static const std::set<string> IGNORED_PARAMS;
@@ -63,6 +72,11 @@ private:
 
     fs::path findModelFile(const string& filename);
     void parseBULKSection(NastranTokenizer &tok, std::shared_ptr<Model> model1);
+    /**
+     * True for the column cards of the DMIG matrices not used by the model, that the tokenizer
+     * can skip without reading their values.
+     */
+    bool isUnusedDMIGColumn(const string& name, const string& gj) const;
 
     void parseExecutiveSection(NastranTokenizer& tok, std::shared_ptr<Model> model, map<string, string>& context);
     /**Renumbers the nodes
@@ -140,22 +140,17 @@ int NastranParserImpl::parseOrientation(int point1, int point2, NastranTokenizer
 
     vector<string> line = tok.currentDataLine();
     bool alternateFormat = line.size() < 8 || line[6].empty() || line[7].empty();
-    OrientationCoordinateSystem* ocs;
     if (alternateFormat) {
         int g0 = tok.nextInt();
         tok.nextDouble(true);
         tok.nextDouble(true);
-        ocs = new OrientationCoordinateSystem(*model, point1, point2, g0);
-    } else {
-        double x1, x2, x3;
-        x1 = tok.nextDouble();
-        x2 = tok.nextDouble();
-        x3 = tok.nextDouble();
-        ocs = new OrientationCoordinateSystem(*model, point1, point2, VectorialValue(x1,x2,x3));
+        return model->addOrFindOrientation(point1, point2, g0);
     }
-    const int idOCS = model->addOrFindOrientation(*ocs);
-    delete(ocs);
-    return idOCS;
+    double x1, x2, x3;
+    x1 = tok.nextDouble();
+    x2 = tok.nextDouble();
+    x3 = tok.nextDouble();
+    return model->addOrFindOrientation(point1, point2, VectorialValue(x1,x2,x3));
 }
 
 void NastranParserImpl::parseCBAR(NastranTokenizer& tok, shared_ptr<Model> model) {
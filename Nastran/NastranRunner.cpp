@@ -45,28 +45,22 @@ Runner::ExitCode NastranRunnerImpl::execSolver(const ConfigurationParameters &co
         string modelFile) {
     fs::path modelFilePath(modelFile);
     string fname = modelFilePath.stem().string();
-    string command = "nastran " + modelFile + " > " + fname + ".stdout 2> " + fname
-            + ".stderr";
     fs::path outputFsPath(configuration.outputPath);
     cout << configuration.outputPath << endl;
     if (!fs::is_directory(outputFsPath))
         return SOLVER_NOT_FOUND;
-    if (configuration.outputPath != ".")
-        command = "cd " + configuration.outputPath + " && " + command;
+    SolverJob job;
+    job.arguments = { "nastran", fs::absolute(modelFilePath).string() };
+    job.workingDirectory = configuration.outputPath;
+    job.stdoutFile = (outputFsPath / fs::path(fname + ".stdout")).string();
+    job.stderrFile = (outputFsPath / fs::path(fname + ".stderr")).string();
 
     vector<string> fileList = { ".DBALL", ".f04", ".f06", ".IFPDAT", ".log", ".MASTER", ".stdout",
             ".stderr" };
     deletePreviousResultFiles(modelFile, fileList);
 
     //run command
-    int i = system(command.c_str());
-    if (i != 0) {
-        cerr << "Command " << command << " exit code:" << i << endl;
-    } else if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Command " << command << " ended with exit code " << i << endl;
-    }
-
-    ExitCode exitCode = convertExecResult(i);
+    ExitCode exitCode = convertJobResult(runJob(configuration, job));
 
     return exitCode;
 }
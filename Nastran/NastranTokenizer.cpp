@@ -17,6 +17,7 @@
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include <cctype>
 #include "NastranTokenizer.h"
 #include "../Abstract/SolverInterfaces.h"
 #include <ciso646>
@@ -217,12 +218,15 @@ bool NastranTokenizer::isEmptyUntilNextKeyword() {
 	} else if (nextSymbolType == NastranTokenizer::SYMBOL_EOF) {
 		return true;
 	}
-	bool result = true;
-	for (size_t i = currentField; i < this->currentLineVector.size() && result; i++) {
-		string curField = trim_copy(currentLineVector[i]);
-		result &= curField.empty();
+	// called on every card: the fields are checked in place, without a trimmed copy
+	for (size_t i = currentField; i < this->currentLineVector.size(); i++) {
+		const string& field = currentLineVector[i];
+		if (any_of(field.begin(), field.end(),
+				[](char c) {return !isspace(static_cast<unsigned char>(c));})) {
+			return false;
+		}
 	}
-	return result;
+	return true;
 }
 
 void NastranTokenizer::nextLine() {
@@ -233,6 +237,11 @@ void NastranTokenizer::nextLine() {
 	currentField = 0;
 
 	bool iseof = readLineSkipComment(this->currentLine);
+	while (!iseof && currentSection == SECTION_BULK && skippedCardFilter
+			&& isSkippedCard(this->currentLine)) {
+		skipContinuationLines();
+		iseof = readLineSkipComment(this->currentLine);
+	}
 	if (!iseof) {
 		switch (currentSection) {
 		case SECTION_EXECUTIVE:
@@ -249,6 +258,68 @@ void NastranTokenizer::nextLine() {
 	}
 }
 
+void NastranTokenizer::setSkippedCardFilter(const string& keyword,
+		function<bool(const string& field1, const string& field2)> filter) {
+	this->skippedCardKeyword = boost::to_upper_copy(keyword);
+	this->skippedCardFilter = filter;
+}
+
+bool NastranTokenizer::startsWithSkippedKeyword(const string& line) const {
+	const size_t size = skippedCardKeyword.size();
+	if (line.size() < size) {
+		return false;
+	}
+	for (size_t i = 0; i < size; i++) {
+		if (toupper(static_cast<unsigned char>(line[i])) != skippedCardKeyword[i]) {
+			return false;
+		}
+	}
+	// the keyword itself, not a longer one: DMIG but not DMIGROT
+	return line.size() == size || !isalnum(static_cast<unsigned char>(line[size]));
+}
+
+bool NastranTokenizer::isSkippedCard(const string& line) {
+	if (!startsWithSkippedKeyword(line)) {
+		return false;
+	}
+	string fields[3];
+	if (getLineType(line) == FREE_FORMAT) {
+		size_t begin = 0;
+		for (int i = 0; i < 3 && begin != string::npos; i++) {
+			const size_t end = line.find(',', begin);
+			fields[i] = line.substr(begin, end == string::npos ? string::npos : end - begin);
+			begin = end == string::npos ? end : end + 1;
+		}
+	} else {
+		const bool longFormat = getLineType(line) == LONG_FORMAT;
+		const size_t fieldSize = longFormat ? LFSIZE : SFSIZE;
+		string expandedLine = line;
+		replaceTabs(expandedLine, longFormat);
+		size_t begin = 0;
+		for (int i = 0; i < 3 && begin < expandedLine.size(); i++) {
+			const size_t size = i == 0 ? SFSIZE : fieldSize;
+			fields[i] = expandedLine.substr(begin, size);
+			begin += size;
+		}
+	}
+	for (string& field : fields) {
+		boost::trim(field);
+		boost::to_upper(field);
+	}
+	return skippedCardFilter(fields[1], fields[2]);
+}
+
+void NastranTokenizer::skipContinuationLines() {
+	string line;
+	char c = static_cast<char>(this->instrream.peek());
+	// comments may be interleaved with the continuation lines
+	while (c == ' ' || c == '+' || c == '*' || c == '\t' || c == ',' || c == '$') {
+		getline(this->instrream, line);
+		lineNumber += 1;
+		c = static_cast<char>(this->instrream.peek());
+	}
+}
+
 void NastranTokenizer::splitFixedFormat(string& line, const bool longFormat, const bool firstLine) {
 	boost::offset_separator f;
 
@@ -26,6 +26,7 @@
 
 #include <string>
 #include <fstream>
+#include <functional>
 #include <vector>
 #include <iostream>
 #include <limits>
@@ -58,6 +59,23 @@ private:
     void parseBulkSectionLine(std::string line);
     void parseParameters();
 
+    std::string skippedCardKeyword;
+    std::function<bool(const std::string&, const std::string&)> skippedCardFilter;
+    /**
+     * True if line starts with skippedCardKeyword, in any case. Doesn't allocate: it is
+     * called for every line of the bulk section.
+     */
+    bool startsWithSkippedKeyword(const std::string& line) const;
+    /**
+     * True if line is a skippedCardKeyword card whose first two fields are accepted by the
+     * skippedCardFilter.
+     */
+    bool isSkippedCard(const std::string& line);
+    /**
+     * Reads the continuation lines of the current card, without splitting them.
+     */
+    void skipContinuationLines();
+
     /**
      * Return the next symbol to be interpreted, as a string (trimmed + uppercase), and advances to next field
      * Return a void string if it's the end of the line.
@@ -158,6 +176,13 @@ public:
      * Advances to next data line, discarding the current content.
      */
     void nextLine();
+    /**
+     * Sets a filter on the two first fields of the bulk cards of a keyword: nextLine() skips
+     * the cards it accepts, continuation lines included, without splitting their fields. The
+     * other cards are only compared to the keyword.
+     */
+    void setSkippedCardFilter(const std::string& keyword,
+            std::function<bool(const std::string& field1, const std::string& field2)> filter);
 
 };
 
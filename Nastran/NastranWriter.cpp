@@ -17,11 +17,13 @@
 #include <string>
 #include <fstream>
 #include <limits>
+#include <algorithm>
+#include <unordered_map>
 
 #include <ciso646>
 #include "NastranWriter.h"
-#include <boost/algorithm/string/predicate.hpp>
-#include <boost/format.hpp>
+#include "NastranParser.h"
+#include "../Abstract/NumberFormat.h"
 
 namespace fs = boost::filesystem;
 using namespace std;
@@ -29,63 +31,30 @@ using namespace std;
 namespace vega {
 namespace nastran {
 
-ostream &operator<<(ostream &out, const Line& line) {
-	out << left << setw(8);
-	out << line.keyword;
-	int fieldCount = 0;
-	for(const auto& field : line.fields) {
-		fieldCount++;
-		if (fieldCount % line.fieldNum == 0) {
-			out << endl;
-			out << setw(line.fieldLength) << "";
-		}
-		out << field;
-	}
-	out << endl;
-	return out;
+Line::Field::Field(Kind kind, long long integer, double real, string text) :
+		kind(kind), integer(integer), real(real), text(text) {
 }
 
 Line::Line(string _keyword) : keyword(_keyword) {
-	if (boost::algorithm::ends_with(keyword, "*")) {
-		fieldLength = 16;
-		fieldNum = 4;
-	} else {
-		fieldLength = 8;
-		fieldNum = 8;
-	}
 }
 
 Line& Line::add() {
-	this->add(string());
+	this->fields.push_back(Field(Field::BLANK));
 	return *this;
 }
 
 Line& Line::add(double value) {
-	std::ostringstream strs;
-	strs << boost::format("%8.7g") % value;
-	string gnum = strs.str();
-	strs.str("");
-	strs.clear();
-	if (gnum.length() <= fieldLength) {
-		strs << internal << setw(this->fieldLength) << gnum;
-	} else {
-		strs << internal << setw(this->fieldLength) << boost::format("%4.2e") % value;
-	}
-	this->fields.push_back(strs.str());
+	this->fields.push_back(Field(Field::REAL, 0, value));
 	return *this;
 }
 
 Line& Line::add(string value) {
-	std::ostringstream strs;
-	strs << internal << setw(this->fieldLength) << value;
-	this->fields.push_back(strs.str());
+	this->fields.push_back(Field(value.empty() ? Field::BLANK : Field::TEXT, 0, 0.0, value));
 	return *this;
 }
 
 Line& Line::add(int value) {
-	std::ostringstream strs;
-	strs << internal << setw(this->fieldLength) << value;
-	this->fields.push_back(strs.str());
+	this->fields.push_back(Field(Field::INTEGER, value));
 	return *this;
 }
 
@@ -115,6 +84,127 @@ Line& Line::add(const VectorialValue vector) {
 	return *this;
 }
 
+CardWriter::CardWriter(ostream& out, FieldFormat fieldFormat) :
+		out(out), fieldFormat(fieldFormat) {
+	buffer.reserve(256);
+}
+
+CardWriter::FieldFormat CardWriter::fieldFormatFromString(const string& name) {
+	if (name == "small") {
+		return SMALL_FIELD;
+	} else if (name == "large") {
+		return LARGE_FIELD;
+	} else if (name == "free") {
+		return FREE_FIELD;
+	}
+	throw invalid_argument("Unknown Nastran field format " + name);
+}
+
+void CardWriter::append(const char* chars, size_t size) {
+	buffer.insert(buffer.end(), chars, chars + size);
+}
+
+void CardWriter::appendPadding(size_t size) {
+	buffer.insert(buffer.end(), size, ' ');
+}
+
+void CardWriter::appendField(const Line::Field& field, size_t width, bool justify) {
+	char chars[NUMBER_MAX_CHARS];
+	const char* value = chars;
+	size_t size = 0;
+	switch (field.kind) {
+	case Line::Field::BLANK:
+		break;
+	case Line::Field::INTEGER:
+		size = formatInteger(field.integer, chars);
+		break;
+	case Line::Field::REAL:
+		size = formatNastranDouble(field.real, width, chars);
+		break;
+	case Line::Field::TEXT:
+		value = field.text.c_str();
+		size = field.text.size();
+		break;
+	}
+	// fixed format fields are right justified
+	if (justify && size < width) {
+		appendPadding(width - size);
+	}
+	append(value, size);
+}
+
+void CardWriter::endPhysicalLine() {
+	while (!buffer.empty() && buffer.back() == ' ') {
+		buffer.pop_back();
+	}
+	buffer.push_back('\n');
+}
+
+CardWriter& CardWriter::operator<<(const Line& line) {
+	// trailing blank fields would only produce empty continuation lines
+	size_t fieldCount = line.fields.size();
+	while (fieldCount > 0 && line.fields[fieldCount - 1].kind == Line::Field::BLANK) {
+		fieldCount--;
+	}
+	buffer.clear();
+	switch (fieldFormat) {
+	case SMALL_FIELD:
+	case LARGE_FIELD: {
+		const bool large = fieldFormat == LARGE_FIELD;
+		const size_t fieldLength = large ? 16 : 8;
+		const size_t fieldNum = large ? 4 : 8;
+		append(line.keyword.c_str(), line.keyword.size());
+		size_t keywordLength = line.keyword.size();
+		if (large) {
+			buffer.push_back('*');
+			keywordLength++;
+		}
+		if (keywordLength < 8) {
+			appendPadding(8 - keywordLength);
+		}
+		for (size_t i = 0; i < fieldCount; i++) {
+			if (i > 0 && i % fieldNum == 0) {
+				// implicit continuation: the marker in column 1 is enough for the tokenizer
+				endPhysicalLine();
+				buffer.push_back(large ? '*' : '+');
+				appendPadding(7);
+			}
+			appendField(line.fields[i], fieldLength, true);
+		}
+		break;
+	}
+	case FREE_FIELD: {
+		append(line.keyword.c_str(), line.keyword.size());
+		for (size_t i = 0; i < fieldCount; i++) {
+			if (i > 0 && i % 8 == 0) {
+				// the first field of a continuation line is the (empty) continuation marker
+				buffer.push_back('\n');
+			}
+			buffer.push_back(',');
+			// no field width: the reals keep the digits needed to read them back exactly
+			appendField(line.fields[i], NUMBER_MAX_CHARS, false);
+		}
+		break;
+	}
+	}
+	endPhysicalLine();
+	out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+	return *this;
+}
+
+void CardWriter::writeRuler() {
+	switch (fieldFormat) {
+	case SMALL_FIELD:
+		out << "$---1--][---2--][---3--][---4--][---5--][---6--][---7--][---8--][---9--][--10--]\n";
+		break;
+	case LARGE_FIELD:
+		out << "$---1--][-------2------][-------3------][-------4------][-------5------][--10--]\n";
+		break;
+	case FREE_FIELD:
+		break;
+	}
+}
+
 NastranWriterImpl::NastranWriterImpl() {
 
 }
@@ -150,80 +240,139 @@ void NastranWriterImpl::writeSOL(const shared_ptr<vega::Model>& model, ofstream&
 	switch (firstAnalysis->type) {
 	case (Analysis::LINEAR_MECA_STAT):
 		{
-		out << "SOL 101" << endl;
+		out << "SOL 101\n";
 		break;
 	}
 	case (Analysis::LINEAR_MODAL):
 		{
-		out << "SOL 103" << endl;
+		out << "SOL 103\n";
 		break;
 	}
 	case (Analysis::LINEAR_DYNA_MODAL_FREQ):
 		{
-		out << "SOL 111" << endl;
+		out << "SOL 111\n";
 		break;
 	}
 	case (Analysis::NONLINEAR_MECA_STAT):
 		{
-		out << "SOL 106" << endl;
+		out << "SOL 106\n";
 		break;
 	}
 	default:
-		out << "$ WARN analysis " << firstAnalysis << " not supported. Skipping." << endl;
+		out << "$ WARN analysis " << firstAnalysis << " not supported. Skipping.\n";
 	}
 }
 
-void NastranWriterImpl::writeCells(const shared_ptr<vega::Model>& model, ofstream& out)
+const map<pair<NastranWriterImpl::CellFamily, CellType::Code>, NastranWriterImpl::CellCard> NastranWriterImpl::cellCardByFamilyAndType =
 		{
+				// no SEG3 beam: CBEAM3 can't be read back by NastranParser, the type is rejected
+				{ { BEAM_FAMILY, CellType::SEG2_CODE }, { "CBEAM", false } },
+				// shell cards are read without reordering, except the generic CQUAD
+				{ { SHELL_FAMILY, CellType::TRI3_CODE }, { "CTRIA3", false } },
+				{ { SHELL_FAMILY, CellType::TRI6_CODE }, { "CTRIA6", false } },
+				{ { SHELL_FAMILY, CellType::QUAD4_CODE }, { "CQUAD4", false } },
+				{ { SHELL_FAMILY, CellType::QUAD8_CODE }, { "CQUAD8", false } },
+				{ { SHELL_FAMILY, CellType::QUAD9_CODE }, { "CQUAD", true } },
+				{ { SOLID_FAMILY, CellType::TETRA4_CODE }, { "CTETRA", true } },
+				{ { SOLID_FAMILY, CellType::TETRA10_CODE }, { "CTETRA", true } },
+				{ { SOLID_FAMILY, CellType::PYRA5_CODE }, { "CPYRAM", true } },
+				{ { SOLID_FAMILY, CellType::PYRA13_CODE }, { "CPYRAM", true } },
+				{ { SOLID_FAMILY, CellType::PENTA6_CODE }, { "CPENTA", true } },
+				{ { SOLID_FAMILY, CellType::PENTA15_CODE }, { "CPENTA", true } },
+				{ { SOLID_FAMILY, CellType::HEXA8_CODE }, { "CHEXA", true } },
+				{ { SOLID_FAMILY, CellType::HEXA20_CODE }, { "CHEXA", true } },
+				{ { MASS_FAMILY, CellType::POINT1_CODE }, { "CONM2", false } }
+		};
+
+void NastranWriterImpl::writeCells(const shared_ptr<vega::Model>& model, CardWriter& out)
+		{
+	unordered_map<int, shared_ptr<ElementSet>> elementSetById;
 	for (const auto& elementSet : model->elementSets) {
-		if (elementSet->isDiscrete() || elementSet->isMatrixElement()) {
+		elementSetById[elementSet->getId()] = elementSet;
+	}
+	// sorted codes, for a reproducible output
+	vector<CellType::Code> codes;
+	for (const auto& codeAndType : CellType::typeByCode) {
+		codes.push_back(codeAndType.first);
+	}
+	sort(codes.begin(), codes.end());
+	for (CellType::Code code : codes) {
+		const CellType& cellType = *CellType::findByCode(code);
+		if (model->mesh->countCells(cellType) == 0) {
 			continue;
 		}
-		CellGroup* cellGroup = elementSet->cellGroup;
-		for (const Cell& cell : cellGroup->getCells()) {
-			string keyword;
-			if (elementSet->isBeam()) {
-				keyword = "CBEAM";
-			} else
-			if (elementSet->isShell()) {
-				switch (cell.type.code) {
-				case CellType::TRI3_CODE:
-					keyword = "CTRIA3";
-					break;
-				case CellType::TRI6_CODE:
-					keyword = "CTRIA6";
-					break;
-				case CellType::QUAD4_CODE:
-					keyword = "CQUAD4";
-					break;
-				case CellType::QUAD8_CODE:
-					keyword = "CQUAD8";
-					break;
-				default:
-					throw logic_error("Unimplemented type");
+		const vector<int>* nastran2med = nullptr;
+		const auto& reorderIt = NastranParserImpl::nastran2medNodeConnectByCellType.find(code);
+		if (reorderIt != NastranParserImpl::nastran2medNodeConnectByCellType.end()) {
+			nastran2med = &reorderIt->second;
+		}
+		// cells of a type usually come in runs of the same ElementSet: cache the last lookup
+		int lastElementId = Cell::UNAVAILABLE_CELL;
+		shared_ptr<ElementSet> elementSet;
+		const CellCard* card = nullptr;
+		vector<int> nodeIds(cellType.numNodes);
+		for (auto it = model->mesh->cells.cells_begin(cellType);
+				it != model->mesh->cells.cells_end(cellType); ++it) {
+			const Cell cell = *it;
+			if (cell.isvirtual) {
+				continue;
+			}
+			if (cell.elementId != lastElementId) {
+				lastElementId = cell.elementId;
+				const auto& elementSetIt = elementSetById.find(cell.elementId);
+				elementSet = elementSetIt == elementSetById.end() ? nullptr : elementSetIt->second;
+				card = nullptr;
+				if (elementSet) {
+					CellFamily family;
+					if (elementSet->isBeam()) {
+						family = BEAM_FAMILY;
+					} else if (elementSet->isShell()) {
+						family = SHELL_FAMILY;
+					} else if (elementSet->type == ElementSet::CONTINUUM) {
+						family = SOLID_FAMILY;
+					} else if (elementSet->type == ElementSet::NODAL_MASS) {
+						family = MASS_FAMILY;
+					} else {
+						// discrete, matrix and rigid elements are not written as cells
+						elementSet = nullptr;
+						continue;
+					}
+					const auto& cardIt = cellCardByFamilyAndType.find(make_pair(family, code));
+					if (cardIt == cellCardByFamilyAndType.end()) {
+						throw logic_error("Unimplemented type " + cellType.to_str() + " in Nastran writer");
+					}
+					card = &cardIt->second;
 				}
-			} else
-			if (elementSet->type == ElementSet::CONTINUUM) {
-				switch (cell.type.code) {
-				case CellType::HEXA8_CODE:
-					case CellType::HEXA20_CODE:
-					keyword = "CHEXA";
-					break;
-				case CellType::TETRA4_CODE:
-					case CellType::TETRA10_CODE:
-					keyword = "CTETRA";
-					break;
-				default:
-					throw logic_error("Unimplemented type");
+			}
+			if (card == nullptr) {
+				continue;
+			}
+			Line line(card->keyword);
+			line.add(cell.id);
+			if (elementSet->type == ElementSet::NODAL_MASS) {
+				const NodalMass& nodalMass = dynamic_cast<const NodalMass&>(*elementSet);
+				line.add(cell.nodeIds[0]).add(0).add(nodalMass.getMassAsForce());
+				line.add(nodalMass.ex).add(nodalMass.ey).add(nodalMass.ez).add();
+				// inverse of the sign conventions of NastranParserImpl::parseCONM2
+				line.add(nodalMass.ixx).add(-nodalMass.ixy).add(nodalMass.iyy);
+				line.add(-nodalMass.iyz).add(-nodalMass.ixz).add(nodalMass.izz);
+			} else {
+				line.add(elementSet->bestId());
+				if (card->reorderNodes && nastran2med != nullptr) {
+					for (size_t i = 0; i < nodeIds.size(); i++) {
+						nodeIds[i] = cell.nodeIds[static_cast<size_t>((*nastran2med)[i])];
+					}
+					line.add(nodeIds);
+				} else {
+					line.add(cell.nodeIds);
 				}
 			}
-
-			out << Line(keyword).add(cell.id).add(elementSet->bestId()).add(cell.nodeIds);
+			out << line;
 		}
 	}
 }
 
-void NastranWriterImpl::writeNodes(const shared_ptr<vega::Model>& model, ofstream& out)
+void NastranWriterImpl::writeNodes(const shared_ptr<vega::Model>& model, CardWriter& out)
 		{
 	for (Node node : model->mesh->nodes) {
 	    if (node.positionCS!= CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID)
@@ -234,7 +383,7 @@ void NastranWriterImpl::writeNodes(const shared_ptr<vega::Model>& model, ofstrea
 	}
 }
 
-void NastranWriterImpl::writeMaterials(const shared_ptr<vega::Model>& model, ofstream& out)
+void NastranWriterImpl::writeMaterials(const shared_ptr<vega::Model>& model, CardWriter& out)
 		{
 	for (const auto& material : model->materials) {
 		Line mat1("MAT1");
@@ -254,7 +403,7 @@ void NastranWriterImpl::writeMaterials(const shared_ptr<vega::Model>& model, ofs
 	}
 }
 
-void NastranWriterImpl::writeConstraints(const shared_ptr<vega::Model>& model, ofstream& out)
+void NastranWriterImpl::writeConstraints(const shared_ptr<vega::Model>& model, CardWriter& out)
 		{
 	for (const auto& constraintSet : model->constraintSets) {
 		const set<shared_ptr<Constraint> > spcs = constraintSet->getConstraintsByType(
@@ -292,7 +441,7 @@ void NastranWriterImpl::writeConstraints(const shared_ptr<vega::Model>& model, o
 	}
 }
 
-void NastranWriterImpl::writeLoadings(const shared_ptr<vega::Model>& model, ofstream& out)
+void NastranWriterImpl::writeLoadings(const shared_ptr<vega::Model>& model, CardWriter& out)
 		{
 	for (const auto& loadingSet : model->loadSets) {
 		const set<shared_ptr<Loading> > gravities = loadingSet->getLoadingsByType(Loading::GRAVITY);
@@ -317,45 +466,44 @@ void NastranWriterImpl::writeLoadings(const shared_ptr<vega::Model>& model, ofst
 		if (forceSurfaces.size() > 0) {
 			for (shared_ptr<Loading> loading : forceSurfaces) {
 				shared_ptr<ForceSurface> forceSurface = static_pointer_cast<ForceSurface>(loading);
-				Line pload4("PLOAD4");
-				pload4.add(loadingSet->bestId());
-				vector<Cell> cells = forceSurface->getCells();
-				if (cells.size() == 1) {
-					Cell cell = cells[0];
-					pload4.add(cell.id);
-				} else {
-					throw logic_error("Unimplemented multiple cells in PLOAD4");
-				}
-				pload4.add(forceSurface->getForce().norm());
-				pload4.add(0.0);
-				pload4.add(0.0);
-				pload4.add(0.0);
 				if (!forceSurface->getMoment().iszero()) {
 					throw logic_error("Unimplemented moment in PLOAD4");
 				}
-				// TODO LD must recalculate two opposite nodes... hack
-				pload4.add(forceSurface->getApplicationFace()[0]);
-				pload4.add(forceSurface->getApplicationFace()[2]);
-				if (forceSurface->hasCoordinateSystem()) {
-					shared_ptr<CoordinateSystem> coordinateSystem = model->find(forceSurface->coordinateSystem_reference);
-					pload4.add(coordinateSystem->bestId());
-					pload4.add(coordinateSystem->vectorToGlobal(forceSurface->getForce().normalized()));
-				} else {
-					pload4.add(0);
-					pload4.add(forceSurface->getForce().normalized());
+				// a face force merged over several skin cells is written for each of them
+				for (const Cell& cell : forceSurface->getCells()) {
+					Line pload4("PLOAD4");
+					pload4.add(loadingSet->bestId());
+					pload4.add(cell.id);
+					pload4.add(forceSurface->getForce().norm());
+					// blank P2, P3 and P4: uniform pressure P1
+					pload4.add();
+					pload4.add();
+					pload4.add();
+					// TODO LD must recalculate two opposite nodes... hack
+					if (cell.type.dimension == SpaceDimension::DIMENSION_2D) {
+						// skin cell, built on the loaded face
+						pload4.add(cell.nodeIds[0]);
+						pload4.add(cell.nodeIds[2]);
+					} else {
+						pload4.add(forceSurface->getApplicationFace()[0]);
+						pload4.add(forceSurface->getApplicationFace()[2]);
+					}
+					if (forceSurface->hasCoordinateSystem()) {
+						shared_ptr<CoordinateSystem> coordinateSystem = model->find(forceSurface->coordinateSystem_reference);
+						pload4.add(coordinateSystem->bestId());
+						pload4.add(coordinateSystem->vectorToGlobal(forceSurface->getForce().normalized()));
+					} else {
+						pload4.add(0);
+						pload4.add(forceSurface->getForce().normalized());
+					}
+					out << pload4;
 				}
 			}
 		}
 	}
 }
 
-void NastranWriterImpl::writeRuler(ofstream& out)
-		{
-	out << "$---1--][---2--][---3--][---4--][---5--][---6--][---7--][---8--][---9--][--10--]"
-			<< endl;
-}
-
-void NastranWriterImpl::writeElements(const shared_ptr<vega::Model>& model, ofstream& out)
+void NastranWriterImpl::writeElements(const shared_ptr<vega::Model>& model, CardWriter& out)
 		{
 	for (shared_ptr<Beam> beam : model->getBeams()) {
 		Line pbeam("PBEAM");
@@ -391,7 +539,7 @@ string NastranWriterImpl::writeModel(const shared_ptr<vega::Model> model,
 	}
 
 	string datPath = getDatFilename(model, outputPath);
-	ofstream out;
+	BufferedOfstream out;
 	out.precision(DBL_DIG);
 	out.open(datPath.c_str(), ios::out | ios::trunc);
 	if (!out.is_open()) {
@@ -399,38 +547,40 @@ string NastranWriterImpl::writeModel(const shared_ptr<vega::Model> model,
 		throw ios::failure(message);
 	}
 
-	out << "$ " << model->name << endl;
+	out << "$ " << model->name << '\n';
 	writeSOL(model, out);
-	out << "TIME 10000" << endl;
+	out << "TIME 10000\n";
 	for (const auto& analysis : model->analyses) {
-		out << "SUBCASE " << analysis->bestId() << endl;
+		out << "SUBCASE " << analysis->bestId() << '\n';
 		for (shared_ptr<LoadSet> loadSet : analysis->getLoadSets()) {
 			string typeName = loadSet->stringByType.find(loadSet->type)->second;
-			out << "  " << typeName << "=" << loadSet->bestId() << endl;
+			out << "  " << typeName << "=" << loadSet->bestId() << '\n';
 		}
 		for (shared_ptr<ConstraintSet> constraintSet : analysis->getConstraintSets()) {
 			string typeName = constraintSet->stringByType.find(constraintSet->type)->second;
-			out << "  " << typeName << "=" << constraintSet->bestId() << endl;
+			out << "  " << typeName << "=" << constraintSet->bestId() << '\n';
 		}
 	}
-	out << "CEND" << endl;
-	out << "$" << endl;
-	out << "TITLE=Vega Exported Model" << endl;
-	out << "BEGIN BULK" << endl;
+	out << "CEND\n";
+	out << "$\n";
+	out << "TITLE=Vega Exported Model\n";
+	out << "BEGIN BULK\n";
+
+	CardWriter cards(out, CardWriter::fieldFormatFromString(configuration.nastranFieldFormat));
 
 	for (shared_ptr<CoordinateSystem> coordinateSystem : model->coordinateSystems) {
 		switch (coordinateSystem->type) {
 			case CoordinateSystem::CARTESIAN:
 				// TODO LD complete
-				out << Line("CORD2R").add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
+				cards << Line("CORD2R").add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
 				break;
 			case CoordinateSystem::SPHERICAL:
 				// TODO LD complete
-				out << Line("CORD2S").add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
+				cards << Line("CORD2S").add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
 				break;
 			case CoordinateSystem::CYLINDRICAL:
 				// TODO LD complete
-				out << Line("CORD2C").add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
+				cards << Line("CORD2C").add(coordinateSystem->bestId()).add(coordinateSystem->getOrigin());
 				break;
 			case CoordinateSystem::ORIENTATION:
 				// Nothing to do here: it will be handled by CBEAM, CBAR etc.
@@ -439,18 +589,18 @@ string NastranWriterImpl::writeModel(const shared_ptr<vega::Model> model,
 				throw logic_error("Unimplemented coordinate system type");
 		}
 	}
-	writeRuler(out);
-	writeNodes(model, out);
-	writeRuler(out);
-	writeCells(model, out);
-	writeRuler(out);
-	writeMaterials(model, out);
-	writeRuler(out);
-	writeElements(model, out);
-	writeRuler(out);
-	writeConstraints(model, out);
-	writeRuler(out);
-	writeLoadings(model, out);
+	cards.writeRuler();
+	writeNodes(model, cards);
+	cards.writeRuler();
+	writeCells(model, cards);
+	cards.writeRuler();
+	writeMaterials(model, cards);
+	cards.writeRuler();
+	writeElements(model, cards);
+	cards.writeRuler();
+	writeConstraints(model, cards);
+	cards.writeRuler();
+	writeLoadings(model, cards);
 
 //	{%- set key_counter = 0 -%}
 //	{% macro lpad(text) -%}{{ "%-16s" % text }}{%- endmacro %}
@@ -554,7 +704,7 @@ string NastranWriterImpl::writeModel(const shared_ptr<vega::Model> model,
 //	{%- endif -%}
 //	{%- endfor %}
 
-	out << "ENDDATA" << endl;
+	out << "ENDDATA\n";
 
 	out.close();
 	return datPath;
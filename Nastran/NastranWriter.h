@@ -24,13 +24,28 @@
 namespace vega {
 namespace nastran {
 
+/**
+ * Fields of a Nastran bulk data card, formatted later by a CardWriter
+ * according to the chosen field format.
+ */
 class Line {
 private:
-	friend std::ostream &operator<<(std::ostream &out, const Line& line);
-	unsigned int fieldLength = 0;
-	unsigned int fieldNum = 0;
+	friend class CardWriter;
+	struct Field {
+		enum Kind {
+			BLANK,
+			INTEGER,
+			REAL,
+			TEXT
+		};
+		Kind kind;
+		long long integer;
+		double real;
+		string text;
+		Field(Kind kind, long long integer = 0, double real = 0.0, string text = "");
+	};
 	const string keyword = "";
-	std::vector<string> fields;
+	std::vector<Field> fields;
 public:
 	Line(string _keyword);
 	Line& add();
@@ -43,9 +58,60 @@ public:
 	Line& add(const VectorialValue vector);
 };
 
-std::ostream &operator<<(std::ostream &out, const Line& line);
+/**
+ * Writes Lines to a stream as small field, large field (GRID*) or free field (comma separated) cards.
+ * Each card, continuation lines included, is formatted into a reused buffer and written in a single
+ * call, without flushing the stream.
+ *
+ * Free field reals are written with the shortest representation that reads back to the same double
+ * (17 significant digits at most). The fixed width formats keep the digits that fit in a field: at
+ * most 7 significant digits in small field and 15 in large field, so their reals are rounded.
+ */
+class CardWriter {
+public:
+	enum FieldFormat {
+		SMALL_FIELD,
+		LARGE_FIELD,
+		FREE_FIELD
+	};
+	CardWriter(std::ostream& out, FieldFormat fieldFormat = SMALL_FIELD);
+	CardWriter& operator<<(const Line& line);
+	/**
+	 * Writes a comment line showing the field boundaries (nothing in free field format).
+	 */
+	void writeRuler();
+	static FieldFormat fieldFormatFromString(const string& name);
+private:
+	std::ostream& out;
+	const FieldFormat fieldFormat;
+	std::vector<char> buffer;
+	void append(const char* chars, size_t size);
+	void appendPadding(size_t size);
+	void appendField(const Line::Field& field, size_t width, bool justify);
+	void endPhysicalLine();
+};
 
 class NastranWriterImpl {
+private:
+	/**
+	 * Kind of Nastran card used to write a cell, depending on its ElementSet.
+	 */
+	enum CellFamily {
+		BEAM_FAMILY,
+		SHELL_FAMILY,
+		SOLID_FAMILY,
+		MASS_FAMILY
+	};
+	/**
+	 * Keyword of the card written for a cell. If reorderNodes is true, the card nodes are
+	 * written in the Nastran order, which differs from the Vega (MED) one: the parser
+	 * reordered them with NastranParserImpl::nastran2medNodeConnectByCellType.
+	 */
+	struct CellCard {
+		string keyword;
+		bool reorderNodes;
+	};
+	static const std::map<std::pair<CellFamily, CellType::Code>, CellCard> cellCardByFamilyAndType;
 public:
 	NastranWriterImpl();
 	virtual ~NastranWriterImpl();
@@ -54,13 +120,16 @@ public:
 private:
 	string getDatFilename(const shared_ptr<vega::Model>& model, const string& outputPath) const;
 	void writeSOL(const shared_ptr<vega::Model>& model, ofstream& out) const;
-	void writeCells(const shared_ptr<vega::Model>& model, ofstream& out);
-	void writeNodes(const shared_ptr<vega::Model>& model, ofstream& out);
-	void writeMaterials(const shared_ptr<vega::Model>& model, ofstream& out);
-	void writeConstraints(const shared_ptr<vega::Model>& model, ofstream& out);
-	void writeLoadings(const shared_ptr<vega::Model>& model, ofstream& out);
-	void writeRuler(ofstream& out);
-	void writeElements(const shared_ptr<vega::Model>& model, ofstream& out);
+	/**
+	 * Writes the cells type by type, the card of each cell being looked up in
+	 * cellCardByFamilyAndType.
+	 */
+	void writeCells(const shared_ptr<vega::Model>& model, CardWriter& out);
+	void writeNodes(const shared_ptr<vega::Model>& model, CardWriter& out);
+	void writeMaterials(const shared_ptr<vega::Model>& model, CardWriter& out);
+	void writeConstraints(const shared_ptr<vega::Model>& model, CardWriter& out);
+	void writeLoadings(const shared_ptr<vega::Model>& model, CardWriter& out);
+	void writeElements(const shared_ptr<vega::Model>& model, CardWriter& out);
 };
 
 }
@@ -5,193 +5,266 @@
  *      Author: devel
  */
 
-#define BOOST_SPIRIT_DEBUG
-#define BOOST_SPIRIT_USE_PHOENIX_V3
-//#define BOOST_NO_SFINAE
-
-#ifdef _WIN32
-//#define BOOST_RESULT_OF_USE_TR1_WITH_DECLTYPE_FALLBACK
-#define BOOST_RESULT_OF_USE_TR1
-//windows fix error C2516: 'boost::phoenix::evaluator::impl<const Expr &,boost::phoenix::vector2<boost::mpl::true_,boost::phoenix::is_nullary>,
-//boost::proto::envns_::empty_env>::result_type' : is not a legal base class is_nullary.hpp
-#define BOOST_PHOENIX_NO_SPECIALIZE_CUSTOM_TERMINAL
-#endif
-
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <memory>
-#include <fstream>
 #include <iostream>
-#include <unordered_map>
-#include <boost/assign/list_of.hpp>
-#include <boost/spirit/include/qi.hpp>
-#include <boost/spirit/include/phoenix.hpp>
-#include <boost/spirit/include/phoenix_operator.hpp>
-#include <boost/spirit/include/phoenix_function.hpp>
-#include <boost/spirit/include/phoenix_statement.hpp>
-#include <boost/spirit/include/phoenix_bind.hpp>
-#include <boost/spirit/include/phoenix_stl.hpp>
-#include <boost/spirit/include/support_line_pos_iterator.hpp>
 #include "CSVResultReader.h"
+#include "MappedFile.h"
+#include "ResultFilter.h"
+#include "TextScanner.h"
 #include "../Abstract/ConfigurationParameters.h"
 #include "../Abstract/Model.h"
-
-#include <boost/fusion/container/vector.hpp>
-#include <boost/fusion/include/adapt_struct.hpp>
-#include <boost/fusion/include/define_struct.hpp>
-#include <boost/optional.hpp>
-#include <boost/variant.hpp>
-
-namespace qi = boost::spirit::qi;
-namespace spirit = boost::spirit;
-namespace phx = boost::phoenix;
-
-using namespace vega;
-
-enum LineItems {
-	UNUSED,
-	RESULT_NAME,
-	NODE,
-	NUM_ORD,
-	TIME,
-	DX,
-	DY,
-	DZ,
-	DRX,
-	DRY,
-	DRZ
-};
-
-typedef spirit::line_pos_iterator<spirit::istream_iterator> stream_iterator_type;
+#include "../Abstract/Parallel.h"
 
 namespace vega {
 namespace result {
 
 using namespace std;
 
-struct CsvGrammar: qi::grammar<stream_iterator_type, void(), qi::locals<vector<LineItems>>,
-		qi::blank_type> {
-	CsvGrammar(shared_ptr<Model> _model, const ConfigurationParameters& _configuration) :
-			CsvGrammar::base_type(start), model(_model), configuration(_configuration) {
-		using namespace qi;
-
-		static const char colsep = ',';
-
-		start = omit[*comment >> header[_a = qi::_1] >> eol] >> line(_a) % eol;
-		header = header_cell % colsep;
-		header_cell = lit("RESULTAT")[_val = LineItems::RESULT_NAME] | lit("NUME_ORDRE")[_val =
-				LineItems::NUM_ORD] | lit("INST")[_val = LineItems::TIME] | lit("NOEUD")[_val =
-				LineItems::NODE] | lit("DX")[_val = LineItems::DX] | lit("DY")[_val = LineItems::DY]
-				| lit("DZ")[_val = LineItems::DZ] | lit("DRX")[_val = LineItems::DRX]
-				| lit("DRY")[_val = LineItems::DRY] | lit("DRZ")[_val = LineItems::DRZ]
-				| column[_val = LineItems::UNUSED];
-		line = (column % colsep)[phx::bind(&CsvGrammar::convertFunc, this, qi::_1, qi::_r1)];
-		column = quoted | *~char_(",\n");
-		quoted = '"' >> *("\"\"" | ~char_("\"\n")) >> '"';
-		comment = ("#" >> *~char_("\n") > qi::eol) | qi::eol;
-		BOOST_SPIRIT_DEBUG_NODES((header)(column)(quoted)(comment)(line));
+namespace {
+
+const char COLUMN_SEPARATOR = ',';
+/**
+ * Columns read in a row, at most: the rows with more columns than the header are skipped.
+ */
+const size_t MAX_COLUMNS = 256;
+
+bool isComment(const TextRange& line) {
+	const TextRange trimmed = line.trimmed();
+	return trimmed.size() > 0 && *trimmed.begin == '#';
+}
+
+/**
+ * Integer that follows the prefix in the field, e.g. 12 in RESU12 or N12.
+ */
+bool parseIdAfter(const TextRange& field, const char* prefix, int& value) {
+	const size_t length = strlen(prefix);
+	return field.size() > length && strncmp(field.begin, prefix, length) == 0
+			&& parseInt(TextRange(field.begin + length, field.end), value);
+}
+
+}
+
+CSVResultReader::CSVResultReader() {
+
+}
+
+vector<CSVResultReader::Column> CSVResultReader::readHeader(const TextRange& line) {
+	static const vector<pair<const char*, Column>> columnByName = {
+			{ "RESULTAT", RESULT_NAME }, { "NUME_ORDRE", NUM_ORD }, { "INST", TIME },
+			{ "NOEUD", NODE }, { "DX", DX }, { "DY", DY }, { "DZ", DZ }, { "DRX", DRX },
+			{ "DRY", DRY }, { "DRZ", DRZ } };
+	TextRange fields[MAX_COLUMNS];
+	const size_t fieldCount = min(splitFields(line, COLUMN_SEPARATOR, fields, MAX_COLUMNS),
+			MAX_COLUMNS);
+	vector<Column> columns(fieldCount, UNUSED);
+	for (size_t i = 0; i < fieldCount; i++) {
+		const TextRange name = fields[i].trimmed();
+		for (const auto& nameColumn : columnByName) {
+			if (name == nameColumn.first) {
+				columns[i] = nameColumn.second;
+			}
+		}
 	}
+	return columns;
+}
 
-	void convertFunc(const vector<string>& columns, const vector<LineItems>& positions) {
-		if (columns.size() != positions.size()) {
-			return;
+void CSVResultReader::readRows(const char* begin, const char* end, const vector<Column>& columns,
+		const ResultFilter& filter, Table& table) const {
+	LineScanner scanner(begin, end);
+	TextRange line;
+	TextRange fields[MAX_COLUMNS];
+	while (scanner.readLine(line)) {
+		if (isComment(line)) {
+			continue;
+		}
+		const size_t fieldCount = splitFields(line, COLUMN_SEPARATOR, fields, MAX_COLUMNS);
+		if (fieldCount != columns.size()) {
+			table.errors.push_back(make_pair(scanner.lineNumber,
+					"Row has " + to_string(fieldCount) + " cells, the header "
+							+ to_string(columns.size())));
+			continue;
 		}
-		int i = 0;
-		string result_name;
-		int result_number;
-		string node_name;
-		int nodeId;
-		int num_step;
+		int resultNumber = 0;
+		int nodeId = 0;
 		double time = 0;
-		for (LineItems position : positions) {
-			switch (position) {
+		bool hasNode = false;
+		string error;
+		for (size_t i = 0; i < columns.size() && error.empty(); i++) {
+			const TextRange field = fields[i].trimmed();
+			switch (columns[i]) {
 			case RESULT_NAME:
-				result_name = columns[i];
-				if (result_name.find("RESU") == 0) {
-					result_number = atoi(result_name.substr(4).c_str());
-				} else {
-					cerr << "Can't parse result name" << result_name << endl;
-					return;
+				if (!parseIdAfter(field, "RESU", resultNumber)) {
+					error = "Can't parse result name " + field.str();
 				}
 				break;
 			case NODE:
-				node_name = columns[i];
-				nodeId = atoi(node_name.substr(1).c_str());
-				break;
-			case NUM_ORD:
-				num_step = atoi(columns[i].c_str());
+				hasNode = parseIdAfter(field, "N", nodeId);
+				if (!hasNode) {
+					error = "Can't parse node name " + field.str();
+				}
 				break;
 			case TIME:
-				time = atof(columns[i].c_str());
+				if (!parseDouble(field, time)) {
+					error = "Can't parse time " + field.str();
+				}
 				break;
 			default:
-				//nothing to do
 				break;
 			}
-			i++;
-		}
-		UNUSEDV(num_step);
-		i = 0;
-		shared_ptr<Analysis> analysis = model->analyses.find(result_number);
-		for (LineItems position : positions) {
-			auto it = dofPosition_by_lineItemEnum.find(position);
-			if (it != dofPosition_by_lineItemEnum.end()) {
-				double value = atof(columns[i].c_str());
-				NodalDisplacementAssertion nda(*model, configuration.testTolerance, nodeId,
-						DOF::findByPosition(it->second), value, time);
-				model->add(nda);
-				if (analysis) {
-					analysis->add(nda);
-				}
+		}
+		if (!error.empty() || !hasNode) {
+			table.errors.push_back(make_pair(scanner.lineNumber,
+					error.empty() ? "No node in row" : error));
+			continue;
+		}
+		if (!filter.acceptsSubcase(resultNumber) || !filter.acceptsNode(nodeId)
+				|| !filter.acceptsStep(time)) {
+			continue;
+		}
+		double values[6] = { 0, 0, 0, 0, 0, 0 };
+		unsigned char dofMask = 0;
+		for (size_t i = 0; i < columns.size(); i++) {
+			if (columns[i] < DX) {
+				continue;
+			}
+			const int dofPosition = columns[i] - DX;
+			const TextRange field = fields[i].trimmed();
+			// an empty cell is a DOF that the node doesn't have
+			if (field.size() == 0 || !filter.acceptsDOF(DOF::findByPosition(dofPosition))) {
+				continue;
 			}
-			i++;
+			if (!parseDouble(field, values[dofPosition])) {
+				error = "Can't parse value " + field.str();
+				break;
+			}
+			dofMask = static_cast<unsigned char>(dofMask | (1 << dofPosition));
+		}
+		if (!error.empty()) {
+			table.errors.push_back(make_pair(scanner.lineNumber, error));
+			continue;
+		}
+		if (dofMask == 0) {
+			continue;
 		}
+		table.resultNumbers.push_back(resultNumber);
+		table.nodeIds.push_back(nodeId);
+		table.times.push_back(time);
+		for (int i = 0; i < 6; i++) {
+			table.values[i].push_back(values[i]);
+		}
+		table.dofMasks.push_back(dofMask);
 	}
+	table.lineCount = scanner.lineNumber;
+}
 
-	qi::rule<stream_iterator_type, void(), qi::locals<vector<LineItems>>, qi::blank_type> start;
-	qi::rule<stream_iterator_type, vector<LineItems>(), qi::blank_type> header;
-	qi::rule<stream_iterator_type, LineItems(), qi::blank_type> header_cell;
-	qi::rule<stream_iterator_type, void(vector<LineItems>), qi::blank_type> line;
-	qi::rule<stream_iterator_type, string(), qi::blank_type> column;
-	qi::rule<stream_iterator_type, string()> quoted;
-	qi::rule<stream_iterator_type, qi::blank_type> empty;
-	qi::rule<stream_iterator_type> comment;
-	shared_ptr<Model> model;
-	const ConfigurationParameters configuration;
-	//visual studio 2013 refuses to compile initializer list
-	unordered_map<LineItems, int, hash<int>> dofPosition_by_lineItemEnum =
-			boost::assign::map_list_of(LineItems::DX, 0)(LineItems::DY, 1)(
-					LineItems::DZ, 2)(LineItems::DRX, 3)(LineItems::DRY,
-					4)(LineItems::DRZ, 5);
-};
+void CSVResultReader::read(const ConfigurationParameters& configuration) {
+	columns.clear();
+	tables.clear();
+	tablesRead = true;
+	if (configuration.resultFile.empty()) {
+		return;
+	}
+	const ResultFilter filter(configuration);
+	const MappedFile file(configuration.resultFile.string());
 
-CSVResultReader::CSVResultReader() {
+	// the header is the first line that is not a comment
+	LineScanner scanner(file.begin(), file.end());
+	TextRange line;
+	while (scanner.readLine(line) && isComment(line)) {
+	}
+	if (line.begin == nullptr || isComment(line)) {
+		return;
+	}
+	columns = readHeader(line);
+	const char* rowsBegin = scanner.getPosition();
+	// a table without row for the comments and the header, numbering the lines of the rows
+	Table header;
+	header.lineCount = scanner.lineNumber;
+	tables.push_back(header);
 
+	const size_t size = static_cast<size_t>(file.end() - rowsBegin);
+	const size_t chunkCount = max(size_t(1), min(countWorkers(), size / CHUNK_SIZE));
+	const vector<const char*> chunkBegins = splitLines(rowsBegin, file.end(), chunkCount);
+	tables.resize(chunkCount + 1);
+	parallelFor(chunkCount, [&](size_t begin, size_t end) {
+		for (size_t chunk = begin; chunk < end; chunk++) {
+			readRows(chunkBegins[chunk], chunkBegins[chunk + 1], columns, filter,
+					tables[chunk + 1]);
+		}
+	});
 }
 
 void CSVResultReader::add_assertions(const ConfigurationParameters& configuration,
 		shared_ptr<Model> model) {
+	if (!tablesRead) {
+		read(configuration);
+	}
+	tablesRead = false;
+	if (configuration.resultFile.empty()) {
+		return;
+	}
+	// the nodes of the groups are only known with the model
+	const ResultFilter filter(configuration, *model);
+	bool ok = !tables.empty();
+	int firstLineNumber = 0;
+	vector<pair<size_t, size_t>> rows;
+	for (size_t t = 0; t < tables.size(); t++) {
+		const Table& table = tables[t];
+		for (const auto& error : table.errors) {
+			ok = false;
+			cerr << "Error parsing:" << configuration.resultFile.string() << " Line number "
+					<< firstLineNumber + error.first << " " << error.second << endl;
+		}
+		firstLineNumber += table.lineCount;
+		for (size_t row = 0; row < table.size(); row++) {
+			if (filter.acceptsNode(table.nodeIds[row])) {
+				rows.push_back(make_pair(t, row));
+			}
+		}
+	}
 
-	if (!configuration.resultFile.empty()) {
-		ifstream in(configuration.resultFile.string());
-		in.unsetf(ios::skipws);
-		spirit::istream_iterator begin(in);
-		const spirit::istream_iterator end;
-
-		stream_iterator_type begin1(begin);
-		stream_iterator_type end1(end);
-		CsvGrammar grammar(model, configuration);
-
-		bool ok = qi::phrase_parse(begin1, end1, grammar, qi::blank);
-
-		if (ok) {
-			cout << "Parse OK\n";
-		} else {
-			cout << "Parse failed\n";
+	size_t valueCount = 0;
+	for (size_t i = 0; i < columns.size(); i++) {
+		if (columns[i] >= DX && filter.acceptsDOF(DOF::findByPosition(columns[i] - DX))) {
+			valueCount++;
+		}
+	}
+	const vector<size_t> kept = filter.sample(rows.size(), valueCount);
+	for (size_t index = 0; index < rows.size(); index++) {
+		if (kept[index] == 0) {
+			continue;
 		}
+		const Table& table = tables[rows[index].first];
+		const size_t row = rows[index].second;
+		shared_ptr<Analysis> analysis = model->analyses.find(table.resultNumbers[row]);
+		size_t valueIndex = 0;
+		for (int i = 0; i < 6; i++) {
+			if ((table.dofMasks[row] & (1 << i)) == 0) {
+				continue;
+			}
+			if (valueIndex++ == kept[index]) {
+				break;
+			}
+			NodalDisplacementAssertion nda(*model, configuration.testTolerance,
+					table.nodeIds[row], DOF::findByPosition(i), table.values[i][row],
+					table.times[row]);
+			model->add(nda);
+			if (analysis) {
+				analysis->add(nda);
+			}
+		}
+	}
+	columns.clear();
+	tables.clear();
 
-		if (begin1 != end1)
-			cout << "Remaining unparsed: '" << string(begin1, end1) << endl;
+	if (ok) {
+		cout << "Parse OK\n";
+	} else {
+		cout << "Parse failed\n";
 	}
 }
 
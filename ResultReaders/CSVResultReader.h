@@ -9,6 +9,8 @@
 #define COMMANDLINE_CSVASSERTIONPARSER_H_
 
 #include "../Abstract/SolverInterfaces.h"
+#include <string>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -18,10 +20,71 @@ class ConfigurationParameters;
 class Assertion;
 
 namespace result {
+struct TextRange;
+class ResultFilter;
 
+/**
+ * Reads the displacements of a Code_Aster table (IMPR_TABLE FORMAT='TABLEAU' SEPARATEUR=',')
+ * and adds them to the model as assertions.
+ *
+ * The columns are found by their header: RESULTAT (RESUn: result of the subcase n), NOEUD
+ * (Nid), INST, NUME_ORDRE, DX, DY, DZ, DRX, DRY, DRZ, the others are ignored. A cell between
+ * double quotes may contain commas, "" being an escaped quote. A row that hasn't the cells of
+ * the header is an error. The file is memory-mapped and its rows are read concurrently, by
+ * chunks of whole lines, into typed columns, the values being converted in place.
+ *
+ * read() doesn't need the model: the rows are kept by node id until add_assertions().
+ */
 class CSVResultReader: public vega::ResultReader {
+private:
+	enum Column {
+		UNUSED,
+		RESULT_NAME,
+		NODE,
+		NUM_ORD,
+		TIME,
+		DX,
+		DY,
+		DZ,
+		DRX,
+		DRY,
+		DRZ
+	};
+	/**
+	 * Rows of a part of the file, by column. The displacements present in a row are given by
+	 * its mask (bit i for the DOF at position i).
+	 */
+	struct Table {
+		std::vector<int> resultNumbers;
+		std::vector<int> nodeIds;
+		std::vector<double> times;
+		std::vector<double> values[6];
+		std::vector<unsigned char> dofMasks;
+		/**
+		 * Rows that couldn't be read: line number in the part of the file, and message.
+		 */
+		std::vector<std::pair<int, std::string>> errors;
+		int lineCount = 0;
+		std::size_t size() const {
+			return nodeIds.size();
+		}
+	};
+	/**
+	 * Columns of the file and rows kept by read(), until add_assertions().
+	 */
+	std::vector<Column> columns;
+	std::vector<Table> tables;
+	bool tablesRead = false;
+	static std::vector<Column> readHeader(const TextRange& line);
+	void readRows(const char* begin, const char* end, const std::vector<Column>& columns,
+			const ResultFilter& filter, Table& table) const;
+	/**
+	 * Bytes of the file read by each task, at least.
+	 */
+	static const std::size_t CHUNK_SIZE = 4 * 1024 * 1024;
 public:
 	CSVResultReader();
+	virtual void read(const ConfigurationParameters& configuration) override;
 	virtual void add_assertions(const ConfigurationParameters& configuration,
 			std::shared_ptr<Model> model) override;
 	virtual ~CSVResultReader();
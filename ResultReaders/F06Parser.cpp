@@ -9,313 +9,398 @@
  */
 
 #include "F06Parser.h"
+#include "MappedFile.h"
+#include "ResultFilter.h"
+#include "TextScanner.h"
 
-//#include <bits/basic_string.h>
 #if defined VDEBUG && defined __GNUC__
 #include <valgrind/memcheck.h>
 #endif
-#include <cstdio>
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstring>
 #include <iostream>
-#include <fstream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <stdlib.h>
-#include <exception>
 #include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
 #include <ciso646>
 #include "../Abstract/Model.h"
 #include "../Abstract/ConfigurationParameters.h"
+#include "../Abstract/Parallel.h"
 
 using namespace std;
 
 namespace vega {
 namespace result {
 
-using boost::algorithm::trim;
 using boost::algorithm::trim_copy;
-using boost::lexical_cast;
 
-F06Parser::F06Parser() {
-	lineNumber = 0;
+namespace {
+
+const char* const DISPLACEMENT_TITLE = "D I S P L A C E M E N T   V E C T O R";
+const char* const EIGENVALUE_TITLE = "R E A L   E I G E N V A L U E S";
+const char* const COMPLEX_DISPLACEMENT_TITLE =
+		"C O M P L E X   D I S P L A C E M E N T   V E C T O R";
+const char* const COMPLEX_DISPLACEMENT_HEADER =
+		"POINT ID.   TYPE          T1             T2             T3             R1             R2             R3";
+/**
+ * Bytes of the F06 file indexed by each task, at least.
+ */
+const size_t INDEX_CHUNK_SIZE = 4 * 1024 * 1024;
+/**
+ * Subcase of a SUBCASE line that doesn't give one.
+ */
+const int UNCHANGED_SUBCASE = INT_MIN;
+
+/**
+ * A line of the F06 file that changes the state of the sections that follow it.
+ */
+struct IndexEvent {
+	enum Kind {
+		SUBCASE,
+		LOAD_STEP,
+		FREQUENCY,
+		TITLE
+	};
+	Kind kind;
+	int subcase;
+	double value;
+	int sectionType;
+	size_t offset;
+	int lineNumber;
+};
+
+double readNumberAfter(const string& line, size_t position) {
+	double value = 0;
+	istringstream(trim_copy(line.substr(position))) >> value;
+	return value;
 }
 
-int F06Parser::readDisplacementSection(const Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream,
-		vector<Assertion*>& assertions, double loadStep) {
-	string header;
-	string currentLine;
-	int subcase_id = NO_SUBCASE;
-	//skip header line
-	this->readLine(istream, header);
-	try {
-		while (this->readLine(istream, currentLine)) {
-			size_t subCasePosition = currentLine.find("SUBCASE");
-			if (currentLine.find("DIAGNOSTIC TOOLS") != string::npos) {
-				//skip
-			} else if (subCasePosition != string::npos) {
-				/*
-				 * Only used to detect if this section has ended.
-				 * Since the line has been consumed, we will return the (next) subcase
-				 * LD : All this should simply be replaced by a buffer parser and a "peek" getline
-				 */
-				subcase_id = parseSubcase(subcase_id, currentLine);
-				break;
-			} else if (!isspace(currentLine.at(0))) {
-				//stop parsing the section at the first line that don't start with a space
-				break;
-			} else {
-				istringstream istringLine(currentLine);
-				vector<string> tokens;
-				copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
-						back_inserter(tokens));
-				if (tokens.size() != 8)
-					break;
+string errorLine(int lineNumber, const TextRange& line) {
+	return "Line number " + to_string(lineNumber) + " Line: " + line.str();
+}
 
-				int nodeId = stoi(tokens[0]);
-				if (tokens[1] != "G"){
-					//cerr << "unsupported assertion type " << assertionType
-					//		<< " : line n." << lineNumber << " " << currentLine
-					//		<< endl;
-					continue;
-				}
-				VectorialValue translation(stod(tokens[2]), stod(tokens[3]), stod(tokens[4]));
-				VectorialValue rotation(stod(tokens[5]), stod(tokens[6]), stod(tokens[7]));
+}
 
-				int nodePosition = model.mesh->findNodePosition(nodeId);
-				Node node = model.mesh->findNode(nodePosition, true, &model);
-				if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
-					Node node = model.mesh->findNode(nodePosition, true, &model);
-					shared_ptr<CoordinateSystem> coordSystem = model.find(
-							Reference<CoordinateSystem>(CoordinateSystem::UNKNOWN,
-									node.displacementCS));
-					coordSystem->updateLocalBase(VectorialValue(node.x, node.y, node.z));
-					translation = coordSystem->vectorToGlobal(translation);
-					rotation = coordSystem->vectorToGlobal(rotation);
+F06Parser::F06Parser() {
+}
+
+vector<F06Parser::Section> F06Parser::indexSections(const MappedFile& file) const {
+	// chunks of whole lines, indexed concurrently
+	const size_t chunkCount = max(size_t(1), min(countWorkers(), file.size() / INDEX_CHUNK_SIZE));
+	const vector<const char*> chunkBegins = splitLines(file.begin(), file.end(), chunkCount);
+	vector<vector<IndexEvent>> eventsByChunk(chunkCount);
+	vector<int> lineCountByChunk(chunkCount, 0);
+	parallelFor(chunkCount, [&](size_t begin, size_t end) {
+		for (size_t chunk = begin; chunk < end; chunk++) {
+			LineScanner scanner(chunkBegins[chunk], chunkBegins[chunk + 1]);
+			vector<IndexEvent>& events = eventsByChunk[chunk];
+			TextRange line;
+			while (scanner.readLine(line)) {
+				const TextRange trimmed = line.trimmed();
+				IndexEvent event;
+				event.lineNumber = scanner.lineNumber;
+				event.offset = static_cast<size_t>(scanner.getPosition() - file.begin());
+				if (trimmed.contains("SUBCASE")) {
+					event.kind = IndexEvent::SUBCASE;
+					event.subcase = parseSubcase(UNCHANGED_SUBCASE, trimmed.str());
+					events.push_back(event);
 				}
-				double values[6] = {
-						translation.x(), translation.y(), translation.z(),
-						rotation.x(), rotation.y(), rotation.z(),
-				};
-				for (int i = 0; i < 6; i++) {
-					double value = values[i];
-					if (abs(value) < 1e-12)
-						value = 0.;
-					assertions.push_back(new NodalDisplacementAssertion(model, configuration.testTolerance,
-									nodeId, DOF::findByPosition(i), value, loadStep));
+				if (trimmed.contains("LOAD STEP = ")) {
+					const string text = trimmed.str();
+					event.kind = IndexEvent::LOAD_STEP;
+					event.value = readNumberAfter(text, text.find("LOAD STEP = ") + 12);
+					events.push_back(event);
+				}
+				if (trimmed.contains("FREQUENCY = ")) {
+					const string text = trimmed.str();
+					event.kind = IndexEvent::FREQUENCY;
+					event.value = readNumberAfter(text, text.find("FREQUENCY = ") + 12);
+					events.push_back(event);
+				}
+				event.kind = IndexEvent::TITLE;
+				if (trimmed == DISPLACEMENT_TITLE) {
+					event.sectionType = Section::DISPLACEMENT;
+					events.push_back(event);
+				} else if (trimmed == EIGENVALUE_TITLE) {
+					event.sectionType = Section::EIGENVALUE;
+					events.push_back(event);
+				} else if (trimmed == COMPLEX_DISPLACEMENT_TITLE) {
+					event.sectionType = Section::COMPLEX_DISPLACEMENT;
+					events.push_back(event);
 				}
-
 			}
+			lineCountByChunk[chunk] = scanner.lineNumber;
 		}
-	} catch (const exception &e) {
-		string message("Error ");
-		message += string(e.what()) + " parsing:";
-		message += configuration.resultFile.string();
-		message += " Line number " + lexical_cast<string>(currentLine);
-		message += " Line: " + currentLine;
-		cerr << message << endl;
-		if (ConfigurationParameters::MODE_STRICT == configuration.translationMode) {
-			throw e;
-		} else {
-			//cerr << "Conditions not added, parsing next section" << endl;
-		}
-	}
-	return subcase_id /* It could have consumed the next subcase id so we give it back for the next section parsing */;
-}
+	});
 
-void F06Parser::readEigenvalueSection(const Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream,
-		vector<Assertion*>& assertions) {
-	string currentLine;
-	try {
-		while (this->readLine(istream, currentLine)) {
-			size_t orderPosition = currentLine.find("ORDER");
-			if (orderPosition != string::npos) {
+	vector<Section> sections;
+	int currentSubCase = NO_SUBCASE;
+	double loadStep = -1;
+	double frequency = -1;
+	int firstLineNumber = 0;
+	for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+		for (const IndexEvent& event : eventsByChunk[chunk]) {
+			switch (event.kind) {
+			case IndexEvent::SUBCASE:
+				if (event.subcase != UNCHANGED_SUBCASE) {
+					currentSubCase = event.subcase;
+				}
+				loadStep = -1;
+				break;
+			case IndexEvent::LOAD_STEP:
+				loadStep = event.value;
+				break;
+			case IndexEvent::FREQUENCY:
+				frequency = event.value;
+				break;
+			case IndexEvent::TITLE: {
+				Section section;
+				section.type = static_cast<Section::Type>(event.sectionType);
+				section.subcase = currentSubCase;
+				section.loadStep = loadStep;
+				section.frequency = frequency;
+				section.offset = event.offset;
+				section.lineNumber = firstLineNumber + event.lineNumber;
+				sections.push_back(section);
 				break;
 			}
-			orderPosition = currentLine.find("AFTER AUGMENTATION OF RESIDUAL VECTORS");
-			if (orderPosition != string::npos) {
-				//not taking into account RESVEC result
-				return;
 			}
-			orderPosition = currentLine.find("ACTUAL MODES USED IN THE DYNAMIC ANALYSIS");
-			if (orderPosition != string::npos) {
-				//not taking into account modes used in dynamic analysis
+		}
+		firstLineNumber += lineCountByChunk[chunk];
+	}
+	return sections;
+}
+
+void F06Parser::readDisplacementSection(const MappedFile& file, const ResultFilter& filter,
+		Section& section) const {
+	LineScanner scanner(file.begin() + section.offset, file.end(), section.lineNumber + 1);
+	TextRange line;
+	TextRange fields[8];
+	//skip header line
+	scanner.readLine(line);
+	while (scanner.readLine(line)) {
+		if (line.contains("DIAGNOSTIC TOOLS")) {
+			continue;
+		}
+		if (line.contains("SUBCASE") || !isspace(static_cast<unsigned char>(*line.begin))) {
+			//stop parsing the section at the next subcase or at the first line that don't start with a space
+			break;
+		}
+		if (splitFields(line, fields, 8) != 8) {
+			break;
+		}
+		Row row;
+		if (!parseInt(fields[0], row.id)) {
+			section.error = errorLine(scanner.lineNumber, line);
+			break;
+		}
+		if (!(fields[1] == "G") || !filter.acceptsNode(row.id)) {
+			continue;
+		}
+		for (int i = 0; i < 6; i++) {
+			if (!parseDouble(fields[2 + i], row.values[i])) {
+				section.error = errorLine(scanner.lineNumber, line);
 				return;
 			}
 		}
-		while (this->readLine(istream, currentLine)) {
-			istringstream istringLine(currentLine);
-			vector<string> tokens;
-			copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
-					back_inserter(tokens));
-			if (tokens.size() != 7)
-				break;
-			int number = stoi(tokens.at(0));
-			double value = stod(tokens.at(4));
-			if (abs(value) < 1e-12)
-				value = 0.;
-			assertions.push_back(
-					new FrequencyAssertion(model, number, value, configuration.testTolerance));
+		section.rows.push_back(row);
+	}
+}
+
+void F06Parser::readEigenvalueSection(const MappedFile& file, Section& section) const {
+	LineScanner scanner(file.begin() + section.offset, file.end(), section.lineNumber + 1);
+	TextRange line;
+	TextRange fields[7];
+	while (scanner.readLine(line)) {
+		if (line.contains("ORDER")) {
+			break;
 		}
-	} catch (const exception &e) {
-		string message("Error ");
-		message += string(e.what()) + " parsing:";
-		message += configuration.resultFile.string();
-		message += " Line number " + lexical_cast<string>(currentLine);
-		message += " Line: " + currentLine;
-		cerr << message << endl;
-		if (ConfigurationParameters::MODE_STRICT == configuration.translationMode) {
-			throw e;
-		} else {
-			//cerr << "Conditions not added, parsing next section" << endl;
+		if (line.contains("AFTER AUGMENTATION OF RESIDUAL VECTORS")) {
+			//not taking into account RESVEC result
+			return;
+		}
+		if (line.contains("ACTUAL MODES USED IN THE DYNAMIC ANALYSIS")) {
+			//not taking into account modes used in dynamic analysis
+			return;
+		}
+	}
+	while (scanner.readLine(line)) {
+		if (splitFields(line, fields, 7) != 7) {
+			break;
 		}
+		Row row;
+		if (!parseInt(fields[0], row.id) || !parseDouble(fields[4], row.values[0])) {
+			section.error = errorLine(scanner.lineNumber, line);
+			break;
+		}
+		section.rows.push_back(row);
 	}
 }
 
-int F06Parser::readComplexDisplacementSection(const Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream,
-		vector<Assertion*>& assertions, double frequency) {
-	string currentLine;
-	int subcase_id = NO_SUBCASE;
-	try {
-
-		while (this->readLine(istream, currentLine)) {
-			size_t orderPosition =
-					currentLine.find(
-							"POINT ID.   TYPE          T1             T2             T3             R1             R2             R3");
-			if (orderPosition != string::npos)
-				break;
+void F06Parser::readComplexDisplacementSection(const MappedFile& file,
+		const ResultFilter& filter, Section& section) const {
+	LineScanner scanner(file.begin() + section.offset, file.end(), section.lineNumber + 1);
+	TextRange line;
+	TextRange fields[15];
+	while (scanner.readLine(line)) {
+		if (line.contains(COMPLEX_DISPLACEMENT_HEADER)) {
+			break;
 		}
-		while (this->readLine(istream, currentLine)) {
-			size_t subCasePosition = currentLine.find("SUBCASE");
-			if (subCasePosition != string::npos) {
-				subcase_id = parseSubcase(subcase_id, currentLine);
-				break;
-			}
-
-			istringstream istringLine(currentLine);
-			vector<string> tokens;
-			copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
-					back_inserter(tokens));
-			if (tokens.size() != 9)
-				break;
-
-			this->readLine(istream, currentLine);
-			istringLine.clear();
-			istringLine.str(currentLine);
-			copy(istream_iterator<string>(istringLine), istream_iterator<string>(),
-					back_inserter(tokens));
-			if (tokens.size() != 15)
-				throw exception();
-
-			int nodeId = stoi(tokens[1]);
-
-			for (int i = 0; i < 6; i++) {
-				double real = stod(tokens[3 + i]);
-				if (abs(real) < 1e-12)
-					real = 0;
-				double imag = stod(tokens[9 + i]);
-				if (abs(imag) < 1e-12)
-					imag = 0;
-				complex<double> value(real, imag);
-
-				assertions.push_back(
-						new NodalComplexDisplacementAssertion(model, configuration.testTolerance,
-								nodeId, DOF::findByPosition(i), value, frequency));
-			}
+	}
+	while (scanner.readLine(line)) {
+		if (line.contains("SUBCASE") || splitFields(line, fields, 9) != 9) {
+			break;
 		}
-	} catch (const exception &e) {
-		string message("Error ");
-		message += string(e.what()) + " parsing:";
-		message += configuration.resultFile.string();
-		message += " Line number " + lexical_cast<string>(currentLine);
-		message += " Line: " + currentLine;
-		cerr << message << endl;
-		if (ConfigurationParameters::MODE_STRICT == configuration.translationMode) {
-			throw e;
-		} else {
-			//cerr << "Conditions not added, parsing next section" << endl;
+		// real parts, then imaginary parts on the next line
+		TextRange imaginaryLine;
+		if (!scanner.readLine(imaginaryLine) || splitFields(imaginaryLine, fields + 9, 6) != 6) {
+			section.error = errorLine(scanner.lineNumber, imaginaryLine);
+			break;
+		}
+		Row row;
+		bool valid = parseInt(fields[1], row.id);
+		if (valid && !filter.acceptsNode(row.id)) {
+			continue;
 		}
+		for (int i = 0; valid && i < 6; i++) {
+			valid = parseDouble(fields[3 + i], row.values[i])
+					&& parseDouble(fields[9 + i], row.values[6 + i]);
+		}
+		if (!valid) {
+			section.error = errorLine(scanner.lineNumber, line);
+			break;
+		}
+		section.rows.push_back(row);
 	}
-	return subcase_id /* It could have consumed the next subcase id so we give it back for the next section parsing */;
 }
 
-int F06Parser::addAssertionsToModel(int currentSubcase, double loadStep, Model &model,
-		const ConfigurationParameters& configuration, ifstream& istream) {
-
-	vector<Assertion*> assertions;
-	int nextSubcase = readDisplacementSection(model, configuration, istream, assertions, loadStep);
-	shared_ptr<Analysis> analysis;
-	if (currentSubcase != NO_SUBCASE) {
-		analysis = model.analyses.find(currentSubcase);
-		if (analysis == nullptr and model.configuration.logLevel >= LogLevel::INFO) {
-			cout << "Could not find subcase : " << currentSubcase << " in model." << endl;
+void F06Parser::sampleRows(const ResultFilter& filter, vector<Section>& sections) const {
+	size_t rowCount = 0;
+	for (const Section& section : sections) {
+		if (section.type != Section::EIGENVALUE) {
+			rowCount += section.rows.size();
 		}
-	} else {
-		// LD If no subcase indicated, the first one is used.
-		// FIXME: what if the model don't have an analysis and the default one is
-		// created inside the finish()? GC
-		analysis = *model.analyses.begin();
 	}
-	for (Assertion* assertion : assertions) {
-		if (analysis != nullptr) {
-			model.add(*assertion);
-			analysis->add(assertion->getReference());
-			if (model.configuration.logLevel >= LogLevel::TRACE) {
-				cout << "Adding NodalDisplacementAssertion : " << *assertion << " to subcase: "
-						<< currentSubcase << endl;
+	size_t dofCount = 0;
+	for (int i = 0; i < 6; i++) {
+		dofCount += filter.acceptsDOF(DOF::findByPosition(i)) ? 1 : 0;
+	}
+	const vector<size_t> kept = filter.sample(rowCount, dofCount);
+	size_t index = 0;
+	for (Section& section : sections) {
+		if (section.type == Section::EIGENVALUE) {
+			continue;
+		}
+		vector<Row> keptRows;
+		for (const Row& row : section.rows) {
+			if (kept[index] > 0) {
+				keptRows.push_back(row);
+				keptRows.back().dofCount = static_cast<int>(kept[index]);
 			}
-		} else if (model.configuration.logLevel >= LogLevel::DEBUG) {
-			cout << "Discarding NodalDisplacementAssertion : " << *assertion
-					<< " because subcase id: " << currentSubcase << " was not found." << endl;
+			index++;
 		}
-		delete (assertion);
+		section.rows.swap(keptRows);
 	}
-	return nextSubcase;
 }
 
-void F06Parser::addFrequencyAssertionsToModel(int currentSubCase, Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream) {
-	vector<Assertion*> assertions;
-	readEigenvalueSection(model, configuration, istream, assertions);
-	shared_ptr<Analysis> analysis;
-	if (currentSubCase != NO_SUBCASE) {
-		analysis = model.analyses.find(currentSubCase);
-		if (analysis == nullptr and model.configuration.logLevel >= LogLevel::INFO) {
-			cout << "Could not find subcase : " << currentSubCase << " in model." << endl;
+void F06Parser::addAssertionsToModel(const Section& section, const ResultFilter& filter,
+		Model& model, const ConfigurationParameters& configuration) const {
+	auto reportError = [&configuration](const string& error) {
+		const string message = "Error parsing:" + configuration.resultFile.string() + " " + error;
+		cerr << message << endl;
+		if (ConfigurationParameters::MODE_STRICT == configuration.translationMode) {
+			throw runtime_error(message);
 		}
-	} else {
-		// LD If no subcase indicated, the first one is used.
-		// FIXME: what if the model don't have an analysis and the default one is
-		// created inside the finish()? GC
-		analysis = *model.analyses.begin();
+		//Conditions read before the error are added
+	};
+	if (!section.error.empty()) {
+		reportError(section.error);
 	}
-	for (Assertion* assertion : assertions) {
-		if (analysis != nullptr) {
-			model.add(*assertion);
-			analysis->add(Reference<Objective>(*assertion));
-			if (model.configuration.logLevel >= LogLevel::TRACE) {
-				cout << "Adding FrequencyAssertion : " << *assertion << " to subcase: "
-						<< currentSubCase << endl;
+	vector<shared_ptr<Assertion>> assertions;
+	string assertionName;
+	switch (section.type) {
+	case Section::DISPLACEMENT:
+		assertionName = "NodalDisplacementAssertion";
+		for (const Row& row : section.rows) {
+			VectorialValue translation(row.values[0], row.values[1], row.values[2]);
+			VectorialValue rotation(row.values[3], row.values[4], row.values[5]);
+			try {
+				int nodePosition = model.mesh->findNodePosition(row.id);
+				Node node = model.mesh->findNode(nodePosition, true, &model);
+				if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID) {
+					shared_ptr<CoordinateSystem> coordSystem = model.find(
+							Reference<CoordinateSystem>(CoordinateSystem::UNKNOWN,
+									node.displacementCS));
+					coordSystem->updateLocalBase(VectorialValue(node.x, node.y, node.z));
+					translation = coordSystem->vectorToGlobal(translation);
+					rotation = coordSystem->vectorToGlobal(rotation);
+				}
+			} catch (const exception& e) {
+				// the section is not read further, as an invalid line
+				reportError(string(e.what()) + " Node: " + to_string(row.id));
+				break;
+			}
+			double values[6] = {
+					translation.x(), translation.y(), translation.z(),
+					rotation.x(), rotation.y(), rotation.z(),
+			};
+			int dofCount = 0;
+			for (int i = 0; i < 6 && dofCount < row.dofCount; i++) {
+				if (!filter.acceptsDOF(DOF::findByPosition(i))) {
+					continue;
+				}
+				dofCount++;
+				double value = values[i];
+				if (abs(value) < 1e-12)
+					value = 0.;
+				assertions.push_back(make_shared<NodalDisplacementAssertion>(model,
+						configuration.testTolerance, row.id, DOF::findByPosition(i), value,
+						section.loadStep));
+			}
+		}
+		break;
+	case Section::EIGENVALUE:
+		assertionName = "FrequencyAssertion";
+		for (const Row& row : section.rows) {
+			double value = row.values[0];
+			if (abs(value) < 1e-12)
+				value = 0.;
+			assertions.push_back(make_shared<FrequencyAssertion>(model, row.id, value,
+					configuration.testTolerance));
+		}
+		break;
+	case Section::COMPLEX_DISPLACEMENT:
+		assertionName = "Complex Displacement Assertion";
+		for (const Row& row : section.rows) {
+			int dofCount = 0;
+			for (int i = 0; i < 6 && dofCount < row.dofCount; i++) {
+				if (!filter.acceptsDOF(DOF::findByPosition(i))) {
+					continue;
+				}
+				dofCount++;
+				double real = row.values[i];
+				if (abs(real) < 1e-12)
+					real = 0;
+				double imag = row.values[6 + i];
+				if (abs(imag) < 1e-12)
+					imag = 0;
+				assertions.push_back(make_shared<NodalComplexDisplacementAssertion>(model,
+						configuration.testTolerance, row.id, DOF::findByPosition(i),
+						complex<double>(real, imag), section.frequency));
 			}
-		} else if (model.configuration.logLevel >= LogLevel::INFO) {
-			cout << "Discarding FrequencyAssertion : " << *assertion << " because subcase id: "
-					<< currentSubCase << " was not found." << endl;
 		}
-		delete (assertion);
+		break;
 	}
-}
 
-int F06Parser::addComplexAssertionsToModel(int currentSubCase, double frequency, Model& model,
-		const ConfigurationParameters& configuration, ifstream& istream) {
-	vector<Assertion*> assertions;
-	int nextSubcase = readComplexDisplacementSection(model, configuration, istream, assertions,
-			frequency);
 	shared_ptr<Analysis> analysis;
-	if (currentSubCase != NO_SUBCASE) {
-		analysis = model.analyses.find(currentSubCase);
+	if (section.subcase != NO_SUBCASE) {
+		analysis = model.analyses.find(section.subcase);
 		if (analysis == nullptr and model.configuration.logLevel >= LogLevel::INFO) {
-			cout << "Could not find subcase : " << currentSubCase << " in model." << endl;
+			cout << "Could not find subcase : " << section.subcase << " in model." << endl;
 		}
 	} else {
 		// LD If no subcase indicated, the first one is used.
@@ -323,21 +408,19 @@ int F06Parser::addComplexAssertionsToModel(int currentSubCase, double frequency,
 		// created inside the finish()? GC
 		analysis = *model.analyses.begin();
 	}
-	for (Assertion* assertion : assertions) {
+	for (const auto& assertion : assertions) {
 		if (analysis != nullptr) {
 			model.add(*assertion);
 			analysis->add(Reference<Objective>(*assertion));
 			if (model.configuration.logLevel >= LogLevel::TRACE) {
-				cout << "Adding Complex Displacement Assertion : " << *assertion << " to subcase: "
-						<< currentSubCase << endl;
+				cout << "Adding " << assertionName << " : " << *assertion << " to subcase: "
+						<< section.subcase << endl;
 			}
-		} else if (model.configuration.logLevel >= LogLevel::INFO) {
-			cout << "Discarding Complex Displacement Assertion : " << *assertion
-					<< " because subcase id: " << currentSubCase << " was not found." << endl;
+		} else if (model.configuration.logLevel >= LogLevel::DEBUG) {
+			cout << "Discarding " << assertionName << " : " << *assertion
+					<< " because subcase id: " << section.subcase << " was not found." << endl;
 		}
-		delete (assertion);
 	}
-	return nextSubcase;
 }
 
 int F06Parser::parseSubcase(int currentSubCase, const string& currentLine) {
@@ -355,70 +438,83 @@ int F06Parser::parseSubcase(int currentSubCase, const string& currentLine) {
 	return parsedSubCase;
 }
 
+void F06Parser::read(const ConfigurationParameters& configuration) {
+	sections.clear();
+	sectionsRead = true;
+	if (configuration.resultFile.empty()) {
+		return;
+	}
+	// the subcase of the sections without subcase is only known with the model
+	const ResultFilter filter(configuration);
+	const MappedFile file(configuration.resultFile.string());
+	sections = indexSections(file);
+	sections.erase(remove_if(sections.begin(), sections.end(), [&filter](const Section& section) {
+				if (section.subcase != NO_SUBCASE && !filter.acceptsSubcase(section.subcase)) {
+					return true;
+				}
+				switch (section.type) {
+				case Section::DISPLACEMENT:
+					return section.loadStep >= 0 && !filter.acceptsStep(section.loadStep);
+				case Section::COMPLEX_DISPLACEMENT:
+					return !filter.acceptsStep(section.frequency);
+				default:
+					return false;
+				}
+			}), sections.end());
+	parallelFor(sections.size(), [this, &file, &filter](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			Section& section = sections[i];
+			switch (section.type) {
+			case Section::DISPLACEMENT:
+				readDisplacementSection(file, filter, section);
+				break;
+			case Section::EIGENVALUE:
+				readEigenvalueSection(file, section);
+				break;
+			case Section::COMPLEX_DISPLACEMENT:
+				readComplexDisplacementSection(file, filter, section);
+				break;
+			}
+		}
+	});
+}
+
 void F06Parser::add_assertions(const ConfigurationParameters& configuration,
 		shared_ptr<Model> model) {
-	if (!configuration.resultFile.empty()) {
-		ifstream istream(configuration.resultFile.string());
-		string currentLine;
-		int currentSubCase = NO_SUBCASE;
-		double loadStep = -1;
-		double frequency = -1;
-		while (this->readLine(istream, currentLine)) {
-			trim(currentLine);
-			size_t subCasePosition = currentLine.find("SUBCASE");
-			if (subCasePosition != string::npos) {
-				string subcaseN = trim_copy(currentLine.substr(subCasePosition + 7));
-				//cout << "SUBCASE "<<subcaseN<< "  " << currentLine <<endl;
-				currentSubCase = parseSubcase(currentSubCase, currentLine);
-				loadStep = -1;
-			}
-			size_t loadStepPosition = currentLine.find("LOAD STEP = ");
-			if (loadStepPosition != string::npos) {
-				string loadStepString = trim_copy(currentLine.substr(loadStepPosition + 12));
-				istringstream istringLine(loadStepString);
-				istringLine >> loadStep;
-			}
-			size_t frequencyPosition = currentLine.find("FREQUENCY = ");
-			if (frequencyPosition != string::npos) {
-				string frequencyString = trim_copy(currentLine.substr(frequencyPosition + 12));
-				istringstream istringLine(frequencyString);
-				istringLine >> frequency;
-			}
-			if (currentLine == "D I S P L A C E M E N T   V E C T O R") {
-				/*
-				 * The next subcase can be consumed to understand if the section has ended.
-				 * In this case, it will be given back as return value, to be used for the next section.
-				 */
-				currentSubCase = addAssertionsToModel(currentSubCase, loadStep, *model,
-						configuration, istream);
-			} else if (currentLine == "R E A L   E I G E N V A L U E S") {
-				addFrequencyAssertionsToModel(currentSubCase, *model, configuration, istream);
-			} else if (currentLine == "C O M P L E X   D I S P L A C E M E N T   V E C T O R") {
-				currentSubCase = addComplexAssertionsToModel(currentSubCase, frequency, *model,
-						configuration, istream);
-			}
+	if (!sectionsRead) {
+		read(configuration);
+	}
+	sectionsRead = false;
+	if (configuration.resultFile.empty()) {
+		return;
+	}
+	// the nodes of the groups and the subcase of the sections without subcase
+	const ResultFilter filter(configuration, *model);
+	const int defaultSubcase = model->analyses.size() == 0 ? NO_SUBCASE :
+			(*model->analyses.begin())->getOriginalId();
+	sections.erase(remove_if(sections.begin(), sections.end(),
+			[&filter, defaultSubcase](const Section& section) {
+				return !filter.acceptsSubcase(section.subcase == NO_SUBCASE ? defaultSubcase : section.subcase);
+			}), sections.end());
+	for (Section& section : sections) {
+		if (section.type != Section::EIGENVALUE) {
+			section.rows.erase(remove_if(section.rows.begin(), section.rows.end(),
+					[&filter](const Row& row) {return !filter.acceptsNode(row.id);}),
+					section.rows.end());
 		}
-		istream.close();
 	}
+	if (filter.isSampled()) {
+		sampleRows(filter, sections);
+	}
+	for (const Section& section : sections) {
+		addAssertionsToModel(section, filter, *model, configuration);
+	}
+	sections.clear();
 }
 
 F06Parser::~F06Parser() {
 
 }
 
-bool F06Parser::readLine(istream &istream, string& line) {
-	bool lineAvailable = false;
-	while (getline(istream, line)) {
-		lineNumber += 1;
-		if (!line.empty()) {
-			if (trim_copy(line).size() > 0) {
-				lineAvailable = true;
-				break;
-			}
-		}
-	}
-	return lineAvailable;
-}
-
 }
 } /* namespace vega */
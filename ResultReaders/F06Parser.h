@@ -12,33 +12,93 @@
 #define F06PARSER_H_
 #include "../Abstract/SolverInterfaces.h"
 #include <iostream>
+#include <vector>
 
 namespace vega {
 class Model;
 
 namespace result {
+class MappedFile;
+class ResultFilter;
+
+/**
+ * Reads the displacements and the eigenvalues printed in a Nastran F06 file and adds them to
+ * the model as assertions.
+ *
+ * The file is memory-mapped and read in three passes: the sections (displacement, eigenvalue,
+ * complex displacement) are indexed with their subcase by a single scan of the file, split
+ * between threads, then their values are read concurrently, and finally the assertions are
+ * added to the model in the order of the file.
+ *
+ * The results left out by the ResultFilter of the configuration are skipped while the file is
+ * read: whole sections for the subcases and steps, lines for the nodes, before their values
+ * are parsed.
+ *
+ * The first two passes don't need the model: read() keeps the values of the sections by node
+ * id, and can run while the model is parsed. The nodes are found in the mesh only by
+ * add_assertions().
+ */
 class F06Parser: public vega::ResultReader {
 private:
-	int lineNumber;
-	bool readLine(std::istream &istream, std::string& line);
-	int addAssertionsToModel(int currentSubcase, double loadStep, Model &model,
-			const ConfigurationParameters&, std::ifstream& istream);
-	void addFrequencyAssertionsToModel(int currentSubCase, Model&, const ConfigurationParameters&,
-			std::ifstream&);
-	int addComplexAssertionsToModel(int currentSubCase, double frequency, Model&,
-			const ConfigurationParameters&, std::ifstream&);
-	int readDisplacementSection(const Model& model, const ConfigurationParameters&,
-			std::ifstream& istream, std::vector<Assertion*>& assertions, double loadStep);
-	void readEigenvalueSection(const Model&, const ConfigurationParameters&, std::ifstream&,
-			std::vector<Assertion*>&);
-	int readComplexDisplacementSection(const Model&, const ConfigurationParameters&, std::ifstream&,
-			std::vector<Assertion*>&, double frequency);
+	/**
+	 * Values of a line of a section: node id and 6 displacements, 6 real then 6 imaginary
+	 * displacements, or mode number and frequency.
+	 */
+	struct Row {
+		int id;
+		double values[12];
+		/**
+		 * Number of the selected DOFs turned into assertions: less than all of them only in
+		 * the last row kept by the sampling.
+		 */
+		int dofCount = 6;
+	};
+	struct Section {
+		enum Type {
+			DISPLACEMENT,
+			EIGENVALUE,
+			COMPLEX_DISPLACEMENT
+		};
+		Type type;
+		int subcase;
+		double loadStep;
+		double frequency;
+		/**
+		 * Offset of the line following the title in the file, and number of the title line.
+		 */
+		std::size_t offset;
+		int lineNumber;
+		std::vector<Row> rows;
+		/**
+		 * Message of the error that ended the reading of the section, if any.
+		 */
+		std::string error;
+	};
+	/**
+	 * Sections kept by read(), until add_assertions().
+	 */
+	std::vector<Section> sections;
+	bool sectionsRead = false;
+	std::vector<Section> indexSections(const MappedFile& file) const;
+	void readDisplacementSection(const MappedFile& file, const ResultFilter& filter,
+			Section& section) const;
+	void readEigenvalueSection(const MappedFile& file, Section& section) const;
+	void readComplexDisplacementSection(const MappedFile& file, const ResultFilter& filter,
+			Section& section) const;
+	/**
+	 * Keeps the sample of the lines of displacements chosen by the filter, among all the
+	 * sections.
+	 */
+	void sampleRows(const ResultFilter& filter, std::vector<Section>& sections) const;
+	void addAssertionsToModel(const Section& section, const ResultFilter& filter, Model& model,
+			const ConfigurationParameters& configuration) const;
 
-	int parseSubcase(int currentSubCase, const std::string& currentLine);
+	static int parseSubcase(int currentSubCase, const std::string& currentLine);
 	static const int NO_SUBCASE = -1;
 
 public:
 	F06Parser();
+	virtual void read(const ConfigurationParameters& configuration) override;
 	virtual void add_assertions(const ConfigurationParameters& configuration,
 			std::shared_ptr<Model> model) override;
 	virtual ~F06Parser();
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * MappedFile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "MappedFile.h"
+#include <fstream>
+#include <iterator>
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vega {
+namespace result {
+
+using namespace std;
+
+MappedFile::MappedFile(const string& path) {
+#ifdef __unix__
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw ios::failure("Can't open file " + path + " for reading.");
+	}
+	struct stat status;
+	if (fstat(fd, &status) == 0 && status.st_size > 0) {
+		length = static_cast<size_t>(status.st_size);
+		void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (address != MAP_FAILED) {
+			mapping = address;
+			data = static_cast<const char*>(address);
+			// read by large contiguous blocks, a block by thread
+			madvise(address, length, MADV_WILLNEED);
+		}
+	}
+	close(fd);
+	if (mapping != nullptr || length == 0) {
+		data = mapping != nullptr ? data : buffer.data();
+		return;
+	}
+#endif
+	ifstream file(path, ios::in | ios::binary);
+	if (!file.is_open()) {
+		throw ios::failure("Can't open file " + path + " for reading.");
+	}
+	buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+	data = buffer.data();
+	length = buffer.size();
+}
+
+MappedFile::~MappedFile() {
+#ifdef __unix__
+	if (mapping != nullptr) {
+		munmap(mapping, length);
+	}
+#endif
+}
+
+}
+} /* namespace vega */
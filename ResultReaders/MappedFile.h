@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * MappedFile.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef RESULTREADERS_MAPPEDFILE_H_
+#define RESULTREADERS_MAPPEDFILE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace vega {
+namespace result {
+
+/**
+ * Read-only view of the whole content of a file, memory-mapped on Unix (read in memory
+ * elsewhere), so that huge result files can be scanned, and split between threads, without
+ * copying them line by line.
+ */
+class MappedFile final {
+private:
+	const char* data = nullptr;
+	std::size_t length = 0;
+	/**
+	 * Content of the file when it can't be mapped.
+	 */
+	std::string buffer;
+	void* mapping = nullptr;
+public:
+	/**
+	 * Throws ios::failure if the file can't be read.
+	 */
+	explicit MappedFile(const std::string& path);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	const char* begin() const {
+		return data;
+	}
+	const char* end() const {
+		return data + length;
+	}
+	std::size_t size() const {
+		return length;
+	}
+	~MappedFile();
+};
+
+}
+} /* namespace vega */
+
+#endif /* RESULTREADERS_MAPPEDFILE_H_ */
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * ResultComparator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "ResultComparator.h"
+#include "../Abstract/Utility.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <boost/algorithm/string/trim.hpp>
+#include <med.h>
+
+namespace vega {
+namespace result {
+
+using namespace std;
+
+constexpr double DisplacementReference::FIRST_STEP;
+
+namespace {
+
+/**
+ * Relative precision on the instants, as the default PRECISION of Code_Aster.
+ */
+const double INSTANT_PRECISION = 1e-6;
+/**
+ * Maximum number of failing nodes listed by operator<<.
+ */
+const size_t MAX_REPORTED_NODES = 20;
+const string DISPLACEMENT_FIELD = "DEPL";
+/**
+ * Length of the concept names of Code_Aster, which prefix the names of the fields in MED files.
+ */
+const size_t CONCEPT_NAME_SIZE = 8;
+
+/**
+ * Keeps the values of the field ordered by node number.
+ */
+void sortByNodeNumber(NodalField& field) {
+	if (is_sorted(field.nodeNumbers.begin(), field.nodeNumbers.end())) {
+		return;
+	}
+	const size_t componentCount = field.components.size();
+	vector<size_t> order(field.nodeNumbers.size());
+	iota(order.begin(), order.end(), 0);
+	sort(order.begin(), order.end(), [&field](size_t left, size_t right) {
+		return field.nodeNumbers[left] < field.nodeNumbers[right];
+	});
+	vector<int> nodeNumbers(order.size());
+	vector<double> values(field.values.size());
+	for (size_t i = 0; i < order.size(); i++) {
+		nodeNumbers[i] = field.nodeNumbers[order[i]];
+		copy_n(field.values.begin() + static_cast<ptrdiff_t>(order[i] * componentCount),
+				componentCount, values.begin() + static_cast<ptrdiff_t>(i * componentCount));
+	}
+	field.nodeNumbers.swap(nodeNumbers);
+	field.values.swap(values);
+}
+
+/**
+ * Position of the values of a node in a field, or -1 if the field has no value on the node.
+ */
+ptrdiff_t findNodeIndex(const NodalField& field, int nodeNumber) {
+	if (field.nodeNumbers.empty()) {
+		const size_t nodeCount = field.components.empty() ? 0 : field.values.size() / field.components.size();
+		return (nodeNumber >= 1 && static_cast<size_t>(nodeNumber) <= nodeCount) ? nodeNumber - 1 : -1;
+	}
+	auto it = lower_bound(field.nodeNumbers.begin(), field.nodeNumbers.end(), nodeNumber);
+	return (it != field.nodeNumbers.end() && *it == nodeNumber) ? it - field.nodeNumbers.begin() : -1;
+}
+
+string trimmed(const char* medString, size_t size) {
+	return boost::algorithm::trim_copy(string(medString, strnlen(medString, size)));
+}
+
+}
+
+ostream& operator<<(ostream& out, const ComparisonSummary& summary) {
+	out << "Compared " << summary.comparedCount << " values: " << summary.failedCount
+			<< " failed, " << summary.missingCount << " missing, max error " << summary.maxError;
+	if (!summary.failingNodeIds.empty()) {
+		out << ", failing nodes:";
+		for (size_t i = 0; i < min(summary.failingNodeIds.size(), MAX_REPORTED_NODES); i++) {
+			out << " " << summary.failingNodeIds[i];
+		}
+		if (summary.failingNodeIds.size() > MAX_REPORTED_NODES) {
+			out << " ... (" << summary.failingNodeIds.size() << " nodes)";
+		}
+	}
+	return out;
+}
+
+void ResultComparator::writeReferences(const string& path,
+		const vector<DisplacementReference>& references) {
+	ofstream out(path, ios::out | ios::trunc);
+	if (!out.is_open()) {
+		throw ios::failure("Can't open file " + path + " for writing.");
+	}
+	out << "# result instant node_number node_id component value tolerance criterion" << endl;
+	out << setprecision(numeric_limits<double>::max_digits10);
+	for (const DisplacementReference& reference : references) {
+		out << reference.resultName << " " << reference.instant << " " << reference.nodeNumber
+				<< " " << reference.nodeId << " " << reference.component << " " << reference.value
+				<< " " << reference.tolerance << " "
+				<< (reference.relative ? "RELATIF" : "ABSOLU") << "\n";
+	}
+}
+
+vector<DisplacementReference> ResultComparator::readReferences(const string& path) {
+	ifstream in(path);
+	if (!in.is_open()) {
+		throw runtime_error("Can't open reference file " + path);
+	}
+	vector<DisplacementReference> references;
+	string line;
+	int lineNumber = 0;
+	while (getline(in, line)) {
+		lineNumber++;
+		boost::algorithm::trim(line);
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		istringstream fields(line);
+		DisplacementReference reference;
+		string criterion;
+		fields >> reference.resultName >> reference.instant >> reference.nodeNumber
+				>> reference.nodeId >> reference.component >> reference.value
+				>> reference.tolerance >> criterion;
+		if (fields.fail() || (criterion != "RELATIF" && criterion != "ABSOLU")) {
+			ostringstream message;
+			message << "Invalid reference in " << path << " line " << lineNumber << ": " << line;
+			throw runtime_error(message.str());
+		}
+		reference.relative = criterion == "RELATIF";
+		references.push_back(reference);
+	}
+	return references;
+}
+
+void ResultComparator::addField(const string& resultName, int stepNumber, double instant,
+		const NodalField& field) {
+	NodalField& added = fieldsByResult[resultName][make_pair(stepNumber, instant)];
+	added = field;
+	sortByNodeNumber(added);
+}
+
+void ResultComparator::readMed(const string& path) {
+	const med_idt fid = MEDfileOpen(path.c_str(), MED_ACC_RDONLY);
+	if (fid < 0) {
+		throw runtime_error("Can't open MED result file " + path);
+	}
+	auto fail = [fid, &path](const string& message) {
+		MEDfileClose(fid);
+		throw runtime_error(message + " in MED result file " + path);
+	};
+	const med_int fieldCount = MEDnField(fid);
+	if (fieldCount < 0) {
+		fail("Can't count the fields");
+	}
+	for (med_int fieldIndex = 1; fieldIndex <= fieldCount; fieldIndex++) {
+		const med_int componentCount = MEDfieldnComponent(fid, static_cast<int>(fieldIndex));
+		if (componentCount <= 0) {
+			continue;
+		}
+		const size_t namesSize = static_cast<size_t>(componentCount) * MED_SNAME_SIZE;
+		char fieldName[MED_NAME_SIZE + 1] = "";
+		char meshName[MED_NAME_SIZE + 1] = "";
+		char dtUnit[MED_SNAME_SIZE + 1] = "";
+		vector<char> componentNames(namesSize + 1, '\0');
+		vector<char> componentUnits(namesSize + 1, '\0');
+		med_bool localMesh;
+		med_field_type fieldType;
+		med_int stepCount;
+		if (MEDfieldInfo(fid, static_cast<int>(fieldIndex), fieldName, meshName, &localMesh,
+				&fieldType, componentNames.data(), componentUnits.data(), dtUnit, &stepCount) < 0) {
+			fail("Can't read the field info");
+		}
+		const string name = trimmed(fieldName, MED_NAME_SIZE);
+		if (fieldType != MED_FLOAT64 || name.size() <= CONCEPT_NAME_SIZE
+				|| name.substr(CONCEPT_NAME_SIZE) != DISPLACEMENT_FIELD) {
+			continue;
+		}
+		const string resultName = boost::algorithm::trim_right_copy_if(
+				name.substr(0, CONCEPT_NAME_SIZE), [](char c) {return c == '_';});
+		NodalField field;
+		for (size_t i = 0; i < static_cast<size_t>(componentCount); i++) {
+			field.components.push_back(trimmed(componentNames.data() + i * MED_SNAME_SIZE, MED_SNAME_SIZE));
+		}
+		for (med_int step = 1; step <= stepCount; step++) {
+			med_int numdt, numit;
+			med_float dt;
+			if (MEDfieldComputingStepInfo(fid, fieldName, static_cast<int>(step), &numdt, &numit, &dt) < 0) {
+				fail("Can't read the steps of " + name);
+			}
+			char profileName[MED_NAME_SIZE + 1] = "";
+			char localizationName[MED_NAME_SIZE + 1] = "";
+			med_int profileSize;
+			med_int integrationPointCount;
+			const med_int valueCount = MEDfieldnValueWithProfile(fid, fieldName, numdt, numit,
+					MED_NODE, MED_NONE, 1, MED_COMPACT_STMODE, profileName, &profileSize,
+					localizationName, &integrationPointCount);
+			if (valueCount < 0) {
+				fail("Can't count the values of " + name);
+			}
+			field.values.assign(static_cast<size_t>(valueCount * componentCount), 0.0);
+			field.nodeNumbers.clear();
+			if (valueCount > 0 && MEDfieldValueWithProfileRd(fid, fieldName, numdt, numit, MED_NODE,
+					MED_NONE, MED_COMPACT_STMODE, profileName, MED_FULL_INTERLACE, MED_ALL_CONSTITUENT,
+					reinterpret_cast<unsigned char*>(field.values.data())) < 0) {
+				fail("Can't read the values of " + name);
+			}
+			if (profileName[0] != '\0') {
+				vector<med_int> profile(static_cast<size_t>(valueCount));
+				if (MEDprofileRd(fid, profileName, profile.data()) < 0) {
+					fail("Can't read the profile of " + name);
+				}
+				field.nodeNumbers.assign(profile.begin(), profile.end());
+			}
+			addField(resultName, static_cast<int>(numdt), dt, field);
+		}
+	}
+	MEDfileClose(fid);
+}
+
+const NodalField* ResultComparator::findField(const string& resultName, double instant) const {
+	auto it = fieldsByResult.find(resultName);
+	if (it == fieldsByResult.end() || it->second.empty()) {
+		return nullptr;
+	}
+	if (is_equal(instant, DisplacementReference::FIRST_STEP)) {
+		return &it->second.begin()->second;
+	}
+	for (const auto& fieldByStep : it->second) {
+		if (is_equal(fieldByStep.first.second, instant, INSTANT_PRECISION)) {
+			return &fieldByStep.second;
+		}
+	}
+	return nullptr;
+}
+
+ComparisonSummary ResultComparator::compare(const vector<DisplacementReference>& references) const {
+	const size_t count = references.size();
+	vector<double> computed(count, 0.0);
+	vector<double> expected(count);
+	vector<double> scales(count);
+	vector<double> tolerances(count);
+	vector<char> found(count, 0);
+	// Gather the computed values: consecutive references usually share the same field.
+	const NodalField* field = nullptr;
+	const DisplacementReference* fieldReference = nullptr;
+	for (size_t i = 0; i < count; i++) {
+		const DisplacementReference& reference = references[i];
+		if (fieldReference == nullptr || fieldReference->resultName != reference.resultName
+				|| !is_equal(fieldReference->instant, reference.instant)) {
+			field = findField(reference.resultName, reference.instant);
+			fieldReference = &reference;
+		}
+		expected[i] = reference.value;
+		const bool relative = reference.relative && !is_zero(reference.value);
+		scales[i] = relative ? 1.0 / abs(reference.value) : 1.0;
+		tolerances[i] = reference.tolerance;
+		if (field == nullptr) {
+			continue;
+		}
+		auto component = find(field->components.begin(), field->components.end(), reference.component);
+		const ptrdiff_t nodeIndex = findNodeIndex(*field, reference.nodeNumber);
+		if (component == field->components.end() || nodeIndex < 0) {
+			continue;
+		}
+		computed[i] = field->values[static_cast<size_t>(nodeIndex) * field->components.size()
+				+ static_cast<size_t>(component - field->components.begin())];
+		found[i] = 1;
+	}
+
+	vector<double> errors(count);
+	for (size_t i = 0; i < count; i++) {
+		errors[i] = abs(computed[i] - expected[i]) * scales[i];
+	}
+
+	ComparisonSummary summary;
+	for (size_t i = 0; i < count; i++) {
+		if (!found[i]) {
+			summary.missingCount++;
+			summary.failingNodeIds.push_back(references[i].nodeId);
+			continue;
+		}
+		summary.comparedCount++;
+		summary.maxError = max(summary.maxError, errors[i]);
+		if (!(errors[i] <= tolerances[i])) {
+			summary.failedCount++;
+			summary.failingNodeIds.push_back(references[i].nodeId);
+		}
+	}
+	sort(summary.failingNodeIds.begin(), summary.failingNodeIds.end());
+	summary.failingNodeIds.erase(unique(summary.failingNodeIds.begin(), summary.failingNodeIds.end()),
+			summary.failingNodeIds.end());
+	return summary;
+}
+
+}
+} /* namespace vega */
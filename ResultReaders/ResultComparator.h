@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * ResultComparator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef RESULTREADERS_RESULTCOMPARATOR_H_
+#define RESULTREADERS_RESULTCOMPARATOR_H_
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace vega {
+namespace result {
+
+/**
+ * Expected value of a component of the displacement (DEPL field) of a node, in a result of
+ * the solver. It replaces a TEST_RESU entry of the command file.
+ */
+struct DisplacementReference final {
+	static constexpr double FIRST_STEP = -1;
+	std::string resultName;
+	/**
+	 * Instant of the computing step, or FIRST_STEP for the first step (NUME_ORDRE=1).
+	 */
+	double instant = FIRST_STEP;
+	/**
+	 * Number of the node in the mesh file, from 1, and its id in the input model for the reports.
+	 */
+	int nodeNumber = 0;
+	int nodeId = 0;
+	std::string component;
+	double value = 0;
+	/**
+	 * Relative tolerance (error / |value|) if relative, absolute tolerance otherwise.
+	 */
+	double tolerance = 0;
+	bool relative = true;
+};
+
+/**
+ * Values of the components of a nodal field at a computing step.
+ */
+struct NodalField final {
+	std::vector<std::string> components;
+	/**
+	 * Numbers of the nodes having a value, in the order of the values. Empty if all the nodes
+	 * of the mesh have a value, in their order.
+	 */
+	std::vector<int> nodeNumbers;
+	/**
+	 * Values, node after node (components.size() values by node).
+	 */
+	std::vector<double> values;
+};
+
+/**
+ * Result of a ResultComparator::compare().
+ */
+struct ComparisonSummary final {
+	std::size_t comparedCount = 0;
+	std::size_t failedCount = 0;
+	/**
+	 * References without a computed value: field, step, node or component not found.
+	 */
+	std::size_t missingCount = 0;
+	/**
+	 * Largest error, relative or absolute according to each reference.
+	 */
+	double maxError = 0;
+	/**
+	 * Ids of the nodes with a failed or missing comparison, in increasing order.
+	 */
+	std::vector<int> failingNodeIds;
+	bool ok() const {
+		return failedCount == 0 && missingCount == 0;
+	}
+};
+
+std::ostream& operator<<(std::ostream&, const ComparisonSummary&);
+
+/**
+ * Compares whole displacement fields of a result file with reference values, instead of
+ * asking the solver to test them one by one.
+ *
+ * The fields are read once (readMed()) or added (addField()), then compare() gathers the
+ * computed values of all the references and checks them in a single loop.
+ */
+class ResultComparator final {
+private:
+	/**
+	 * Fields by result name, then by (step number, instant).
+	 */
+	std::map<std::string, std::map<std::pair<int, double>, NodalField>> fieldsByResult;
+	const NodalField* findField(const std::string& resultName, double instant) const;
+public:
+	/**
+	 * Writes references to a text file, one by line.
+	 */
+	static void writeReferences(const std::string& path,
+			const std::vector<DisplacementReference>& references);
+	/**
+	 * Reads a file written by writeReferences(). Throws runtime_error if it is malformed.
+	 */
+	static std::vector<DisplacementReference> readReferences(const std::string& path);
+	/**
+	 * Adds the DEPL field of a result at a computing step.
+	 */
+	void addField(const std::string& resultName, int stepNumber, double instant,
+			const NodalField& field);
+	/**
+	 * Reads the DEPL fields of a MED result file written by Code_Aster: the fields named
+	 * after the result, padded to 8 characters with '_', followed by DEPL.
+	 * Throws runtime_error if the file can't be read.
+	 */
+	void readMed(const std::string& path);
+	ComparisonSummary compare(const std::vector<DisplacementReference>& references) const;
+};
+
+}
+} /* namespace vega */
+
+#endif /* RESULTREADERS_RESULTCOMPARATOR_H_ */
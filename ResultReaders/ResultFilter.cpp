@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * ResultFilter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "ResultFilter.h"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <boost/algorithm/string.hpp>
+#include "../Abstract/ConfigurationParameters.h"
+#include "../Abstract/Model.h"
+
+namespace vega {
+namespace result {
+
+using namespace std;
+
+namespace {
+
+/**
+ * Non empty, trimmed items of a comma separated list.
+ */
+vector<string> splitList(const string& list) {
+	vector<string> tokens;
+	boost::split(tokens, list, boost::is_any_of(","));
+	vector<string> items;
+	for (const string& token : tokens) {
+		const string item = boost::trim_copy(token);
+		if (!item.empty()) {
+			items.push_back(item);
+		}
+	}
+	return items;
+}
+
+bool readInt(const string& text, int& value) {
+	char* stop;
+	const long parsed = strtol(text.c_str(), &stop, 10);
+	value = static_cast<int>(parsed);
+	return !text.empty() && *stop == '\0';
+}
+
+bool readDouble(const string& text, double& value) {
+	char* stop;
+	value = strtod(text.c_str(), &stop);
+	return !text.empty() && *stop == '\0';
+}
+
+}
+
+ResultFilter::IdRange ResultFilter::parseIdRange(const string& token, const string& option) {
+	IdRange range;
+	const size_t separator = token.find(':');
+	if (separator == string::npos) {
+		if (!readInt(token, range.first)) {
+			throw invalid_argument("Invalid id " + token + " in " + option + ".");
+		}
+		range.second = range.first;
+	} else if (!readInt(boost::trim_copy(token.substr(0, separator)), range.first)
+			|| !readInt(boost::trim_copy(token.substr(separator + 1)), range.second)
+			|| range.first > range.second) {
+		throw invalid_argument("Invalid id range " + token + " in " + option + ".");
+	}
+	return range;
+}
+
+DOF ResultFilter::parseDOF(const string& token) {
+	const string name = boost::to_upper_copy(token);
+	static const vector<vector<string>> namesByPosition = {
+			{ "DX", "T1" }, { "DY", "T2" }, { "DZ", "T3" },
+			{ "DRX", "RX", "R1" }, { "DRY", "RY", "R2" }, { "DRZ", "RZ", "R3" } };
+	for (size_t position = 0; position < namesByPosition.size(); position++) {
+		const vector<string>& names = namesByPosition[position];
+		if (find(names.begin(), names.end(), name) != names.end()) {
+			return DOF::findByPosition(static_cast<int>(position));
+		}
+	}
+	throw invalid_argument("Invalid DOF " + token + " in test dofs.");
+}
+
+ResultFilter::ResultFilter(const ConfigurationParameters& configuration, const Model& model) :
+		ResultFilter(configuration, &model) {
+}
+
+ResultFilter::ResultFilter(const ConfigurationParameters& configuration) :
+		ResultFilter(configuration, nullptr) {
+}
+
+ResultFilter::ResultFilter(const ConfigurationParameters& configuration, const Model* model) {
+	bool hasGroups = false;
+	for (const string& token : splitList(configuration.testNodes)) {
+		allNodes = false;
+		if (isdigit(static_cast<unsigned char>(token[0])) || token[0] == '-' || token[0] == '+') {
+			const IdRange range = parseIdRange(token, "test nodes");
+			if (range.first == range.second) {
+				nodeIds.insert(range.first);
+			} else {
+				nodeRanges.push_back(range);
+			}
+			continue;
+		}
+		hasGroups = true;
+		if (model == nullptr) {
+			continue;
+		}
+		const Group* group = model->mesh->findGroup(token);
+		if (group == nullptr) {
+			throw invalid_argument("Unknown group " + token + " in test nodes.");
+		}
+		for (int position : group->nodePositions()) {
+			nodeIds.insert(model->mesh->findNode(position).id);
+		}
+	}
+	if (hasGroups && model == nullptr) {
+		allNodes = true;
+	}
+	for (const string& token : splitList(configuration.testSubcases)) {
+		allSubcases = false;
+		subcaseRanges.push_back(parseIdRange(token, "test subcases"));
+	}
+	for (const string& token : splitList(configuration.testSteps)) {
+		pair<double, double> range;
+		const size_t separator = token.find(':');
+		const string first = boost::trim_copy(token.substr(0, separator));
+		const string second = separator == string::npos ? first :
+				boost::trim_copy(token.substr(separator + 1));
+		if (!readDouble(first, range.first) || !readDouble(second, range.second)
+				|| range.first > range.second) {
+			throw invalid_argument("Invalid step " + token + " in test steps.");
+		}
+		stepRanges.push_back(range);
+	}
+	const vector<string> dofNames = splitList(configuration.testDofs);
+	if (!dofNames.empty()) {
+		dofs = DOFS::NO_DOFS;
+		for (const string& token : dofNames) {
+			dofs += parseDOF(token);
+		}
+	}
+	if (configuration.testSampleCount < 0) {
+		throw invalid_argument("Test sample count must be positive.");
+	}
+	sampleCount = static_cast<size_t>(configuration.testSampleCount);
+	if (configuration.testSampling == "random") {
+		sampling = Sampling::RANDOM;
+	} else if (configuration.testSampling == "stride") {
+		sampling = Sampling::STRIDE;
+	} else {
+		throw invalid_argument("Test sampling must be either stride or random.");
+	}
+}
+
+bool ResultFilter::acceptsSubcase(int subcaseId) const {
+	if (allSubcases) {
+		return true;
+	}
+	for (const IdRange& range : subcaseRanges) {
+		if (subcaseId >= range.first && subcaseId <= range.second) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ResultFilter::acceptsStep(double step) const {
+	if (stepRanges.empty()) {
+		return true;
+	}
+	for (const auto& range : stepRanges) {
+		if ((step >= range.first && step <= range.second) || is_equal(step, range.first)
+				|| is_equal(step, range.second)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+vector<size_t> ResultFilter::sample(size_t candidateCount, size_t valuesByCandidate) const {
+	if (!isSampled() || candidateCount * valuesByCandidate <= sampleCount) {
+		return vector<size_t>(candidateCount, valuesByCandidate);
+	}
+	// whole candidates, the last one is cut to the sample count
+	const size_t keptCount = (sampleCount + valuesByCandidate - 1) / valuesByCandidate;
+	vector<size_t> kept(candidateCount, 0);
+	switch (sampling) {
+	case Sampling::STRIDE:
+		for (size_t i = 0; i < keptCount; i++) {
+			kept[i * candidateCount / keptCount] = valuesByCandidate;
+		}
+		break;
+	case Sampling::RANDOM: {
+		// selection sampling (Knuth): each candidate is kept with the probability
+		// remaining / left, which keeps exactly keptCount candidates in the order of the file.
+		// The draws are taken from the raw output of the engine, which the standard fixes,
+		// unlike the distributions: the sample is the same with every standard library.
+		mt19937_64 generator(RANDOM_SEED);
+		size_t remaining = keptCount;
+		for (size_t i = 0; i < candidateCount && remaining > 0; i++) {
+			if (generator() % (candidateCount - i) < remaining) {
+				kept[i] = valuesByCandidate;
+				remaining--;
+			}
+		}
+		break;
+	}
+	}
+	const auto last = find_if(kept.rbegin(), kept.rend(), [](size_t count) {return count > 0;});
+	*last = sampleCount - (keptCount - 1) * valuesByCandidate;
+	return kept;
+}
+
+}
+} /* namespace vega */
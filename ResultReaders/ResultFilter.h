@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * ResultFilter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef RESULTREADERS_RESULTFILTER_H_
+#define RESULTREADERS_RESULTFILTER_H_
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "../Abstract/Dof.h"
+
+namespace vega {
+
+class ConfigurationParameters;
+class Model;
+
+namespace result {
+
+/**
+ * Selection of the values of a result file that are turned into assertions, tested by the
+ * result readers while they parse the file, so that the values left out cost no object.
+ *
+ * The selection is given by the test-* options of the configuration (empty for everything):
+ *  - nodes: ids, id ranges "first:last" and names of groups, e.g. "1:1000,2005,TOP";
+ *  - dofs: "DX,DY,DZ,DRX,DRY,DRZ" (or RX..., T1..., R1...);
+ *  - subcases: ids and id ranges;
+ *  - steps: load steps, times or frequencies, single values and ranges "min:max". Values
+ *    that are not given by step (e.g. a linear static displacement) are always kept;
+ *  - sample count: number of values kept, at most, among the selected ones, chosen evenly
+ *    (stride) or at random (with a fixed seed, so that two translations give the same tests).
+ */
+class ResultFilter final {
+public:
+	enum class Sampling {
+		STRIDE,
+		RANDOM
+	};
+private:
+	typedef std::pair<int, int> IdRange;
+	bool allNodes = true;
+	std::unordered_set<int> nodeIds;
+	std::vector<IdRange> nodeRanges;
+	bool allSubcases = true;
+	std::vector<IdRange> subcaseRanges;
+	std::vector<std::pair<double, double>> stepRanges;
+	DOFS dofs = DOFS::ALL_DOFS;
+	std::size_t sampleCount = 0;
+	Sampling sampling = Sampling::STRIDE;
+	static const unsigned int RANDOM_SEED = 5489u;
+	static IdRange parseIdRange(const std::string& token, const std::string& option);
+	static DOF parseDOF(const std::string& token);
+	ResultFilter(const ConfigurationParameters& configuration, const Model* model);
+public:
+	/**
+	 * Throws invalid_argument if an option can't be read, or names an unknown group.
+	 */
+	ResultFilter(const ConfigurationParameters& configuration, const Model& model);
+	/**
+	 * Filter used before the model is known: if groups are selected, all the nodes are
+	 * accepted, the nodes have to be checked again with the filter of the model.
+	 */
+	explicit ResultFilter(const ConfigurationParameters& configuration);
+	bool acceptsNode(int nodeId) const {
+		if (allNodes || nodeIds.find(nodeId) != nodeIds.end()) {
+			return true;
+		}
+		for (const IdRange& range : nodeRanges) {
+			if (nodeId >= range.first && nodeId <= range.second) {
+				return true;
+			}
+		}
+		return false;
+	}
+	bool acceptsSubcase(int subcaseId) const;
+	bool acceptsStep(double step) const;
+	bool acceptsDOF(const DOF& dof) const {
+		return dofs.contains(dof);
+	}
+	/**
+	 * True if the selected values are sampled.
+	 */
+	bool isSampled() const {
+		return sampleCount > 0;
+	}
+	/**
+	 * Chooses, among candidateCount candidates of valuesByCandidate values each (e.g. the
+	 * lines of displacements and their selected DOFs), the values kept so that at most the
+	 * sample count of values are kept. Returns, at the index of each candidate, the number of
+	 * its first values kept: 0 if it is left out, and less than valuesByCandidate only for the
+	 * last kept candidate.
+	 */
+	std::vector<std::size_t> sample(std::size_t candidateCount,
+			std::size_t valuesByCandidate = 1) const;
+};
+
+}
+} /* namespace vega */
+
+#endif /* RESULTREADERS_RESULTFILTER_H_ */
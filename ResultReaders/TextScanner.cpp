@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * TextScanner.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "TextScanner.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace vega {
+namespace result {
+
+using namespace std;
+
+namespace {
+
+inline bool isBlank(char c) {
+	return isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+inline bool isDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+/**
+ * Powers of ten exactly represented by a double.
+ */
+const double EXACT_POWERS_OF_TEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+const int MAX_EXACT_POWER = 22;
+const uint64_t MAX_EXACT_MANTISSA = uint64_t(1) << 53;
+const int MAX_SIGNIFICANT_DIGITS = 19;
+
+bool parseDoubleWithStrtod(const TextRange& field, double& value) {
+	const string text = field.str();
+	char* stop;
+	value = strtod(text.c_str(), &stop);
+	return !text.empty() && stop == text.c_str() + text.size();
+}
+
+}
+
+bool TextRange::contains(const char* text) const {
+	const size_t length = strlen(text);
+	return length == 0 || search(begin, end, text, text + length) != end;
+}
+
+TextRange TextRange::trimmed() const {
+	const char* first = begin;
+	const char* last = end;
+	while (first < last && isBlank(*first)) {
+		first++;
+	}
+	while (last > first && isBlank(*(last - 1))) {
+		last--;
+	}
+	return TextRange(first, last);
+}
+
+bool TextRange::operator==(const char* text) const {
+	const size_t length = strlen(text);
+	return size() == length && memcmp(begin, text, length) == 0;
+}
+
+bool LineScanner::readLine(TextRange& line) {
+	while (position < end) {
+		const char* lineBegin = position;
+		const char* lineEnd = static_cast<const char*>(memchr(position, '\n',
+				static_cast<size_t>(end - position)));
+		if (lineEnd == nullptr) {
+			lineEnd = end;
+			position = end;
+		} else {
+			position = lineEnd + 1;
+		}
+		lineNumber++;
+		if (lineEnd > lineBegin && *(lineEnd - 1) == '\r') {
+			lineEnd--;
+		}
+		const char* first = lineBegin;
+		while (first < lineEnd && isBlank(*first)) {
+			first++;
+		}
+		if (first < lineEnd) {
+			line = TextRange(lineBegin, lineEnd);
+			return true;
+		}
+	}
+	return false;
+}
+
+size_t splitFields(const TextRange& line, TextRange* fields, size_t maxFields) {
+	size_t count = 0;
+	const char* position = line.begin;
+	while (true) {
+		while (position < line.end && isBlank(*position)) {
+			position++;
+		}
+		if (position == line.end) {
+			return count;
+		}
+		const char* fieldBegin = position;
+		while (position < line.end && !isBlank(*position)) {
+			position++;
+		}
+		if (count < maxFields) {
+			fields[count] = TextRange(fieldBegin, position);
+		}
+		count++;
+	}
+}
+
+size_t splitFields(const TextRange& line, char separator, TextRange* fields, size_t maxFields) {
+	size_t count = 0;
+	const char* position = line.begin;
+	while (true) {
+		TextRange field(position, line.end);
+		bool quoted = false;
+		const char* first = position;
+		while (first < line.end && isBlank(*first)) {
+			first++;
+		}
+		if (first < line.end && *first == '"') {
+			// quoted field, in which "" is an escaped quote
+			const char* last = first + 1;
+			while (last < line.end
+					&& (*last != '"' || (last + 1 < line.end && *(last + 1) == '"'))) {
+				last += *last == '"' ? 2 : 1;
+			}
+			quoted = true;
+			field = TextRange(first + 1, last);
+			position = last < line.end ? last + 1 : line.end;
+		}
+		// memchr is vectorized by the C library: the fields are skipped a block at a time
+		const char* next = static_cast<const char*>(memchr(position, separator,
+				static_cast<size_t>(line.end - position)));
+		if (!quoted) {
+			field.end = next == nullptr ? line.end : next;
+		}
+		if (count < maxFields) {
+			fields[count] = field;
+		}
+		count++;
+		if (next == nullptr) {
+			return count;
+		}
+		position = next + 1;
+	}
+}
+
+vector<const char*> splitLines(const char* begin, const char* end, size_t chunkCount) {
+	const size_t size = static_cast<size_t>(end - begin);
+	vector<const char*> chunkBegins = { begin };
+	for (size_t chunk = 1; chunk < chunkCount; chunk++) {
+		const char* chunkBegin = max(chunkBegins.back(), begin + chunk * size / chunkCount);
+		const char* lineEnd = static_cast<const char*>(memchr(chunkBegin, '\n',
+				static_cast<size_t>(end - chunkBegin)));
+		chunkBegins.push_back(lineEnd == nullptr ? end : lineEnd + 1);
+	}
+	chunkBegins.push_back(end);
+	return chunkBegins;
+}
+
+bool parseInt(const TextRange& field, int& value) {
+	const char* position = field.begin;
+	bool negative = false;
+	if (position < field.end && (*position == '+' || *position == '-')) {
+		negative = *position == '-';
+		position++;
+	}
+	if (position == field.end) {
+		return false;
+	}
+	long long result = 0;
+	for (; position < field.end; position++) {
+		if (!isDigit(*position)) {
+			return false;
+		}
+		result = result * 10 + (*position - '0');
+		if (result > static_cast<long long>(INT_MAX) + 1) {
+			return false;
+		}
+	}
+	result = negative ? -result : result;
+	if (result > INT_MAX) {
+		return false;
+	}
+	value = static_cast<int>(result);
+	return true;
+}
+
+bool parseDouble(const TextRange& field, double& value) {
+	const char* position = field.begin;
+	bool negative = false;
+	if (position < field.end && (*position == '+' || *position == '-')) {
+		negative = *position == '-';
+		position++;
+	}
+	uint64_t mantissa = 0;
+	int significantDigits = 0;
+	int exponent = 0;
+	bool hasDigits = false;
+	for (; position < field.end && isDigit(*position); position++) {
+		hasDigits = true;
+		if (mantissa != 0 || *position != '0') {
+			if (++significantDigits > MAX_SIGNIFICANT_DIGITS) {
+				return parseDoubleWithStrtod(field, value);
+			}
+			mantissa = mantissa * 10 + static_cast<uint64_t>(*position - '0');
+		}
+	}
+	if (position < field.end && *position == '.') {
+		for (position++; position < field.end && isDigit(*position); position++) {
+			hasDigits = true;
+			exponent--;
+			if (mantissa != 0 || *position != '0') {
+				if (++significantDigits > MAX_SIGNIFICANT_DIGITS) {
+					return parseDoubleWithStrtod(field, value);
+				}
+				mantissa = mantissa * 10 + static_cast<uint64_t>(*position - '0');
+			}
+		}
+	}
+	if (!hasDigits) {
+		// inf, nan...
+		return parseDoubleWithStrtod(field, value);
+	}
+	if (position < field.end && (*position == 'E' || *position == 'e' || *position == 'D'
+			|| *position == 'd')) {
+		position++;
+		bool negativeExponent = false;
+		if (position < field.end && (*position == '+' || *position == '-')) {
+			negativeExponent = *position == '-';
+			position++;
+		}
+		if (position == field.end) {
+			return false;
+		}
+		int explicitExponent = 0;
+		for (; position < field.end && isDigit(*position); position++) {
+			explicitExponent = min(explicitExponent * 10 + (*position - '0'), 100000);
+		}
+		exponent += negativeExponent ? -explicitExponent : explicitExponent;
+	}
+	if (position != field.end) {
+		return false;
+	}
+	if (mantissa == 0) {
+		value = negative ? -0.0 : 0.0;
+		return true;
+	}
+	if (mantissa > MAX_EXACT_MANTISSA || exponent > MAX_EXACT_POWER || exponent < -MAX_EXACT_POWER) {
+		return parseDoubleWithStrtod(field, value);
+	}
+	// a single correctly rounded operation on exact operands: the result is correctly rounded
+	const double exactMantissa = static_cast<double>(mantissa);
+	value = exponent < 0 ? exactMantissa / EXACT_POWERS_OF_TEN[-exponent] :
+			exactMantissa * EXACT_POWERS_OF_TEN[exponent];
+	value = negative ? -value : value;
+	return true;
+}
+
+}
+} /* namespace vega */
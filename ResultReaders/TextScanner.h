@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * TextScanner.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#ifndef RESULTREADERS_TEXTSCANNER_H_
+#define RESULTREADERS_TEXTSCANNER_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace vega {
+namespace result {
+
+/**
+ * Characters [begin, end) of a text in memory, e.g. a line or a field of a MappedFile.
+ */
+struct TextRange final {
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	TextRange() = default;
+	TextRange(const char* begin, const char* end) :
+			begin(begin), end(end) {
+	}
+	std::size_t size() const {
+		return static_cast<std::size_t>(end - begin);
+	}
+	bool contains(const char* text) const;
+	TextRange trimmed() const;
+	bool operator==(const char* text) const;
+	std::string str() const {
+		return std::string(begin, end);
+	}
+};
+
+/**
+ * Reads the lines of a text in memory, skipping the blank ones.
+ */
+class LineScanner final {
+private:
+	const char* position;
+	const char* end;
+public:
+	/**
+	 * Number of the last line read, from firstLineNumber, blank lines included.
+	 */
+	int lineNumber;
+	LineScanner(const char* begin, const char* end, int firstLineNumber = 1) :
+			position(begin), end(end), lineNumber(firstLineNumber - 1) {
+	}
+	/**
+	 * Reads the next non blank line, without its end of line characters. Returns false at the
+	 * end of the text.
+	 */
+	bool readLine(TextRange& line);
+	const char* getPosition() const {
+		return position;
+	}
+};
+
+/**
+ * Splits a line into the fields separated by blanks, storing at most maxFields of them.
+ * Returns the number of fields in the line, which may be larger than maxFields.
+ */
+std::size_t splitFields(const TextRange& line, TextRange* fields, std::size_t maxFields);
+
+/**
+ * Splits a line into the fields separated by the separator (e.g. ',' in a CSV file), storing
+ * at most maxFields of them. A field between double quotes may contain the separator, its
+ * range is then the text between the quotes. Returns the number of fields in the line.
+ */
+std::size_t splitFields(const TextRange& line, char separator, TextRange* fields,
+		std::size_t maxFields);
+
+/**
+ * Splits a text into chunkCount chunks of whole lines, of about the same size, to be read by
+ * different threads. Returns the chunkCount + 1 boundaries of the chunks.
+ */
+std::vector<const char*> splitLines(const char* begin, const char* end, std::size_t chunkCount);
+
+/**
+ * Parses a whole field as an integer or a floating point number, with or without exponent
+ * (1, -2.5, 4.901961E-01, 1.D+3). Returns false if the field is not a number.
+ *
+ * The usual numbers of the result files (less than 19 significant digits and a small
+ * exponent) are converted without strtod, and exactly as strtod does.
+ */
+bool parseInt(const TextRange& field, int& value);
+bool parseDouble(const TextRange& field, double& value);
+
+}
+} /* namespace vega */
+
+#endif /* RESULTREADERS_TEXTSCANNER_H_ */
@@ -115,6 +115,42 @@ public:
 };
 
 
+/**
+ * Numbered records of values, like the Systus vectors or lists. Records are numbered
+ * from 1, in order of addition, and their values are stored one after the other in
+ * a single pool.
+ */
+template<typename T>
+class SystusRecords{
+private:
+    std::vector<T> values;
+    std::vector<size_t> offsets = {0};
+public:
+    /**
+     * Appends a record and returns its number.
+     */
+    long unsigned int add(const std::vector<T>& record){
+        values.insert(values.end(), record.begin(), record.end());
+        offsets.push_back(values.size());
+        return size();
+    }
+    long unsigned int size() const{
+        return static_cast<long unsigned int>(offsets.size() - 1);
+    }
+    /**
+     * First value of record number id (from 1 to size()).
+     */
+    const T* begin(long unsigned int id) const{
+        return values.data() + offsets[id - 1];
+    }
+    const T* end(long unsigned int id) const{
+        return values.data() + offsets[id];
+    }
+    void clear(){
+        values.clear();
+        offsets.resize(1);
+    }
+};
 
 }
 #endif /* SYSTUSASC_H_ */
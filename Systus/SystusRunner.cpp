@@ -41,14 +41,15 @@ Runner::ExitCode SystusRunner::execSolver(const ConfigurationParameters &configu
 
     fs::path modelFilePath(modelFile);
     string fname = modelFilePath.stem().string();
-    string command = "systus -batch -exec " + modelFile + " > " + fname + ".stdout 2> " + fname
-            + ".stderr";
     fs::path outputFsPath(configuration.outputPath);
     cout << configuration.outputPath << endl;
     if (!fs::is_directory(outputFsPath))
         return SOLVER_NOT_FOUND;
-    if (configuration.outputPath != ".")
-        command = "cd " + configuration.outputPath + " && " + command;
+    SolverJob job;
+    job.arguments = { "systus", "-batch", "-exec", fs::absolute(modelFilePath).string() };
+    job.workingDirectory = configuration.outputPath;
+    job.stdoutFile = (outputFsPath / fs::path(fname + ".stdout")).string();
+    job.stderrFile = (outputFsPath / fs::path(fname + ".stderr")).string();
 
     // delete previous results
     for (fs::directory_iterator it(outputFsPath); it != fs::directory_iterator(); it++) {
@@ -65,25 +66,12 @@ Runner::ExitCode SystusRunner::execSolver(const ConfigurationParameters &configu
         }
     }
 
-    //run command
-    int i = system(command.c_str());
-    if (i != 0) {
-        cerr << "Command " << command << " exit code:" << i << endl;
-    } else if (configuration.logLevel >= LogLevel::DEBUG) {
-        cout << "Command " << command << " ended with exit code " << i << endl;
-    }
-
-    ExitCode exitCode = convertExecResult(i);
-
-    // test if any error occurred during computation
-    string outputFileStr = (outputFsPath / fs::path(fname + ".stdout")).string();
-    ifstream outputFile(outputFileStr);
-    string line;
-    int lineNumber = 0;
-    while (getline(outputFile, line)) {
-        lineNumber += 1;
-        if (line.find("ERROR") != string::npos && line.find("NO ERROR") == string::npos){
-            cerr << "Error found : line " << lineNumber << " file: " << outputFileStr << endl;
+    //run command, test if any error occurred during computation
+    job.patterns.push_back({ "ERROR", "NO ERROR" });
+    const SolverJobResult result = runJob(configuration, job);
+    ExitCode exitCode = convertJobResult(result);
+    for (const LogMatch& match : result.matches) {
+        if (match.file == job.stdoutFile) {
             exitCode = SOLVER_EXIT_NOT_ZERO;
         }
     }
@@ -32,6 +32,7 @@
 #include "SystusWriter.h"
 #include "SystusAsc.h"
 #include "../Abstract/CoordinateSystem.h"
+#include "../Abstract/NumberFormat.h"
 #include "build_properties.h"
 #include "cmath" /* M_PI */
 #include <ctime>
@@ -370,7 +371,7 @@ string SystusWriter::writeModel(const shared_ptr<Model> model,
     }
 
     // On Systus output, we build a "general" solver file
-    ofstream dat_file_ofs;
+    BufferedOfstream dat_file_ofs;
     string dat_path = systusModel.getOutputFileName("_ALL.DAT");
     if (configuration.systusOutputProduct=="systus"){
         dat_file_ofs.open(dat_path.c_str(), ios::trunc);
@@ -392,7 +393,7 @@ string SystusWriter::writeModel(const shared_ptr<Model> model,
 
         /* ASCI file */
         string asc_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1)+ "_DATA1.ASC");
-        ofstream asc_file_ofs;
+        BufferedOfstream asc_file_ofs;
         asc_file_ofs.precision(DBL_DIG);
         asc_file_ofs.open(asc_path.c_str(), ios::trunc | ios::out);
         if (!asc_file_ofs.is_open()) {
@@ -406,7 +407,7 @@ string SystusWriter::writeModel(const shared_ptr<Model> model,
         this->writeMatrixFiles(systusModel, idSubcase);
 
         /* Analysis file */
-        ofstream analyse_file_ofs;
+        BufferedOfstream analyse_file_ofs;
         analyse_file_ofs.precision(DBL_DIG);
         string analyse_path = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + ".DAT");
         analyse_file_ofs.open(analyse_path.c_str(), ios::trunc);
@@ -927,7 +928,7 @@ void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int
                     }
                     int node = nodalForce->getNode().position;
                     if (!is_zero(normvec)){
-                        vectors[vectorId]=vec;
+                        vectors.add(vec);
                         loadingVectorsIdByLocalLoadingByNodePosition[node][idLoadCase].push_back(vectorId);
                         vectorId++;
                     }
@@ -950,7 +951,7 @@ void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int
                             vec.push_back(moment.y()); normvec=max(normvec, abs(moment.y()));
                             vec.push_back(moment.z()); normvec=max(normvec, abs(moment.z()));
                             if (!is_zero(normvec)){
-                                vectors[vectorId]=vec;
+                                vectors.add(vec);
                                 loadingVectorsIdByLocalLoadingByNodePosition[rotNodePosition][idLoadCase].push_back(vectorId);
                                 vectorId++;
                             }
@@ -977,7 +978,7 @@ void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int
                         if (loadingVectorIdByLocalLoading[idLoadCase]!=0){
                             handleWritingWarning("GRAVITY already defined for this loadcase. Dismissing load "+ to_string(gravity->bestId()) );
                         }else{
-                            vectors[vectorId]=vec;
+                            vectors.add(vec);
                             loadingVectorIdByLocalLoading[idLoadCase]= vectorId;
                             vectorId++;
                         }
@@ -1049,7 +1050,7 @@ void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int
                         }
                         int node = nodalForce->getNode().position;
                         if (!is_zero(normvec)){
-                            vectors[vectorId]=vec;
+                            vectors.add(vec);
                             loadingVectorsIdByLocalLoadingByNodePosition[node][idLoadCase].push_back(vectorId);
                             vectorId++;
                         }
@@ -1072,7 +1073,7 @@ void SystusWriter::fillLoadingsVectors(const SystusModel& systusModel, const int
                                 vec.push_back(amplitude*moment.y()); normvec=max(normvec, abs(amplitude*moment.y()));
                                 vec.push_back(amplitude*moment.z()); normvec=max(normvec, abs(amplitude*moment.z()));
                                 if (!is_zero(normvec)){
-                                    vectors[vectorId]=vec;
+                                    vectors.add(vec);
                                     loadingVectorsIdByLocalLoadingByNodePosition[rotNodePosition][idLoadCase].push_back(vectorId);
                                     vectorId++;
                                 }
@@ -1147,7 +1148,7 @@ void SystusWriter::fillConstraintsVectors(const SystusModel& systusModel, const
                             handleWritingError("systusOption not supported");
 
                         if (!is_zero(normvec)){
-                            vectors[vectorId]=vec;
+                            vectors.add(vec);
                             for (const auto& it : localLoadingIdByLoadsetIdByAnalysisId[analysis->getId()]){
                                 for (int nodePosition : constraint->nodePositions()){
                                     constraintVectorsIdByLocalLoadingByNodePosition[nodePosition][it.second].push_back(vectorId);
@@ -1185,7 +1186,7 @@ void SystusWriter::fillConstraintsVectors(const SystusModel& systusModel, const
                                             constraintVectorsIdByLocalLoadingByNodePosition[rotNodePosition][it2.second].push_back(vectorId);
                                         }
                                         if (firstTime){
-                                            vectors[vectorId]=vec;
+                                            vectors.add(vec);
                                             vectorId++;
                                             firstTime = false;
                                         }
@@ -1301,7 +1302,7 @@ void SystusWriter::fillCoordinatesVectors(const SystusModel& systusModel, const
                 vec.push_back(0.0);
             }
             }
-            vectors[vectorId]=vec;
+            vectors.add(vec);
             localVectorIdByNodePosition[node.position]=vectorId;
             vectorId++;
         }
@@ -1356,12 +1357,7 @@ void SystusWriter::fillConstraintsNodes(const SystusModel& systusModel, const in
 
                     // We compute the Degree Of Freedom of the node (see ASC Manual)
                     DOFS constrained = constraint->getDOFSForNode(nodePosition);
-                    if (constraintByNodePosition.find(nodePosition) == constraintByNodePosition.end()){
-                        constraintByNodePosition[nodePosition] = char(constrained) & dofCode;
-                    }else{
-                        constraintByNodePosition[nodePosition] = (char(constrained) & dofCode)
-                                            | constraintByNodePosition[nodePosition];
-                    }
+                    constraintByNodePosition[nodePosition] = char(constraintByNodePosition[nodePosition] | (char(constrained) & dofCode));
 
                     // Rigid Body Element in option 3D.
                     // We report the constraints from the master node to the master rotational node.
@@ -1371,12 +1367,7 @@ void SystusWriter::fillConstraintsNodes(const SystusModel& systusModel, const in
                         if (it != rotationNodeIdByTranslationNodeId.end()){
                             DOFS constrainedRot(constrained.contains(DOF::RX),constrained.contains(DOF::RY),constrained.contains(DOF::RZ));
                             int rotNodePosition= mesh->findNodePosition(it->second);
-                            if (constraintByNodePosition.find(rotNodePosition) == constraintByNodePosition.end()){
-                                constraintByNodePosition[rotNodePosition] = char(constrainedRot) & dofCode;
-                            }else{
-                                constraintByNodePosition[rotNodePosition] = (char(constrainedRot) & dofCode)
-                                                    | constraintByNodePosition[rotNodePosition];
-                            }
+                            constraintByNodePosition[rotNodePosition] = char(constraintByNodePosition[rotNodePosition] | (char(constrainedRot) & dofCode));
                         }
                     }
                 }
@@ -1418,7 +1409,7 @@ void SystusWriter::fillLists(const SystusModel& systusModel, const int idSubcase
                 sl.push_back(vectorId);
             }
         }
-        lists[idSystusList]= sl;
+        lists.add(sl);
         idSystusList++;
     }
 
@@ -1432,7 +1423,7 @@ void SystusWriter::fillLists(const SystusModel& systusModel, const int idSubcase
                 sl.push_back(vectorId);
             }
         }
-        lists[idSystusList]= sl;
+        lists.add(sl);
         idSystusList++;
     }
 }
@@ -1489,8 +1480,8 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 // Building the table
                 for (const auto np : sm->nodePairs()){
                     int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-                    shared_ptr<DOFMatrix> dM = sm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFBlock dM = sm->findSubmatrix(np.first, np.second);
+                    for (const auto dof: dM){
                         int dofCode = 10*DOFToInt(dof.first.first) + DOFToInt(dof.first.second);
                         aTable.add(pairCode+dofCode);
                         aTable.add(dof.second);
@@ -1516,8 +1507,8 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 // Building the table
                 for (const auto np : mm->nodePairs()){
                     int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-                    shared_ptr<DOFMatrix> dM = mm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFBlock dM = mm->findSubmatrix(np.first, np.second);
+                    for (const auto dof: dM){
                         int dofCode = 10*DOFToInt(dof.first.first) + DOFToInt(dof.first.second);
                         aTable.add(pairCode+dofCode);
                         aTable.add(dof.second);
@@ -1543,8 +1534,8 @@ void SystusWriter::fillTables(const SystusModel& systusModel, const int idSubcas
                 // Building the table
                 for (const auto np : dm->nodePairs()){
                     int pairCode = positionToSytusNumber[np.first]*1000 + positionToSytusNumber[np.second]*100;
-                    shared_ptr<DOFMatrix> dM = dm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFBlock dM = dm->findSubmatrix(np.first, np.second);
+                    for (const auto dof: dM){
                         int dofCode = 10*DOFToInt(dof.first.first) + DOFToInt(dof.first.second);
                         aTable.add(pairCode+dofCode);
                         aTable.add(dof.second);
@@ -1687,8 +1678,8 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                 for (const auto np : dam->nodePairs()){
                     int nI = positionToSytusNumber[np.first];
                     int nJ = positionToSytusNumber[np.second];
-                    shared_ptr<DOFMatrix> dM = dam->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFBlock dM = dam->findSubmatrix(np.first, np.second);
+                    for (const auto dof: dM){
                         int dofI = DOFToInt(dof.first.first);
                         int dofJ = DOFToInt(dof.first.second);
                         aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
@@ -1719,8 +1710,8 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                 for (const auto np : mm->nodePairs()){
                     int nI = positionToSytusNumber[np.first];
                     int nJ = positionToSytusNumber[np.second];
-                    shared_ptr<DOFMatrix> dM = mm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFBlock dM = mm->findSubmatrix(np.first, np.second);
+                    for (const auto dof: dM){
                         int dofI = DOFToInt(dof.first.first);
                         int dofJ = DOFToInt(dof.first.second);
                         aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
@@ -1751,8 +1742,8 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
                 for (const auto np : sm->nodePairs()){
                     int nI = positionToSytusNumber[np.first];
                     int nJ = positionToSytusNumber[np.second];
-                    shared_ptr<DOFMatrix> dM = sm->findSubmatrix(np.first, np.second);
-                    for (const auto dof: dM->componentByDofs){
+                    const DOFBlock dM = sm->findSubmatrix(np.first, np.second);
+                    for (const auto dof: dM){
                         int dofI = DOFToInt(dof.first.first);
                         int dofJ = DOFToInt(dof.first.second);
                         aMatrix.setValue(nI, nJ, dofI, dofJ, dof.second);
@@ -1779,26 +1770,27 @@ void SystusWriter::fillMatrices(const SystusModel& systusModel, const int idSubc
 
 
 // Cleaning from previous analysis
-void SystusWriter::clear(){
+void SystusWriter::clear(int nbNodes){
+    const size_t size = static_cast<size_t>(nbNodes);
 
     // Clear loads
     localLoadingIdByLoadsetIdByAnalysisId.clear();
     localLoadingListName.clear();
 
     // Clear constraints nodes
-    constraintByNodePosition.clear();
+    constraintByNodePosition.assign(size, 0);
 
     // Clear vectors
     vectors.clear();
-    localVectorIdByNodePosition.clear();
+    localVectorIdByNodePosition.assign(size, 0);
     loadingVectorIdByLocalLoading.clear();
     loadingVectorsIdByLocalLoadingByNodePosition.clear();
     constraintVectorsIdByLocalLoadingByNodePosition.clear();
 
     // Clear lists
     lists.clear();
-    loadingListIdByNodePosition.clear();
-    constraintListIdByNodePosition.clear();
+    loadingListIdByNodePosition.assign(size, 0);
+    constraintListIdByNodePosition.assign(size, 0);
 
     // Clear tables
     tables.clear();
@@ -1815,7 +1807,7 @@ void SystusWriter::clear(){
 
 void SystusWriter::translate(const SystusModel &systusModel, const int idSubcase){
 
-    this->clear();
+    this->clear(systusModel.model->mesh->countNodes());
 
     fillMatrices(systusModel, idSubcase);
 
@@ -1975,23 +1967,12 @@ void SystusWriter::writeNodes(const SystusModel& systusModel, ostream& out) {
     for (const auto& node : mesh->nodes) {
         Node nNode = mesh->findNode(node.position, true, systusModel.model);
         int nid = nNode.id;
-        int iconst = 0;
-        auto it = constraintByNodePosition.find(node.position);
-        if (it != constraintByNodePosition.end())
-            iconst = int(it->second);
+        const size_t position = static_cast<size_t>(node.position);
+        int iconst = int(constraintByNodePosition[position]);
         int imeca = 0;
-        long unsigned int iangl = 0;
-        if (node.displacementCS != CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID){
-            iangl = localVectorIdByNodePosition[node.position];
-        }
-        int isol = 0;
-        auto it2 = loadingListIdByNodePosition.find(node.position);
-        if (it2 != loadingListIdByNodePosition.end())
-            isol = it2->second;
-        int idisp = 0;
-        it2 = constraintListIdByNodePosition.find(node.position);
-        if (it2 != constraintListIdByNodePosition.end())
-            idisp = it2->second;
+        long unsigned int iangl = localVectorIdByNodePosition[position];
+        int isol = loadingListIdByNodePosition[position];
+        int idisp = constraintListIdByNodePosition[position];
         out << nid << " " << iconst << " " << imeca << " " << iangl << " " << isol << " " << idisp
                 << " ";
         out << nNode.x << " " << nNode.y << " " << nNode.z << endl;
@@ -2241,6 +2222,7 @@ void SystusWriter::writeMaterials(const SystusModel& systusModel,
         const vega::ConfigurationParameters &configuration, ostream& out) {
 
     ostringstream ogmat;
+    useFastNumberFormat(ogmat);
     ogmat.precision(DBL_DIG);
     int nbmaterials= 0;
     int nbelements = 0;
@@ -2251,6 +2233,7 @@ void SystusWriter::writeMaterials(const SystusModel& systusModel,
         if (elementSet->cellGroup != nullptr){
 
             ostringstream omat;
+            useFastNumberFormat(omat);
             omat.precision(DBL_DIG);
             int nbElementsMaterial=0;
             bool isValid=true;
@@ -2461,14 +2444,15 @@ void SystusWriter::writeLoads(ostream& out) {
 void SystusWriter::writeLists(ostream& out) {
 
     ostringstream olist;
+    useFastNumberFormat(olist);
     olist.precision(DBL_DIG);
     long unsigned int nbElements=0;
-    for (const auto& list : lists) {
-        olist << list.first;
-        for (const long unsigned int d : list.second)
-            olist << " " << d;
+    for (long unsigned int listId = 1; listId <= lists.size(); listId++) {
+        olist << listId;
+        for (auto it = lists.begin(listId); it != lists.end(listId); ++it)
+            olist << " " << *it;
         olist << endl;
-        nbElements = nbElements + static_cast<long unsigned int>(list.second.size()/2);
+        nbElements = nbElements + static_cast<long unsigned int>((lists.end(listId) - lists.begin(listId))/2);
     }
 
     out << "BEGIN_LISTS ";
@@ -2479,10 +2463,10 @@ void SystusWriter::writeLists(ostream& out) {
 
 void SystusWriter::writeVectors(ostream& out) {
     out << "BEGIN_VECTORS " << vectors.size() << endl;
-    for (const auto& vector : vectors) {
-        out << vector.first;
-        for (const auto& d : vector.second)
-            out << " " << d;
+    for (long unsigned int vectorId = 1; vectorId <= vectors.size(); vectorId++) {
+        out << vectorId;
+        for (auto it = vectors.begin(vectorId); it != vectors.end(vectorId); ++it)
+            out << " " << *it;
         out << endl;
     }
     out << "END_VECTORS" << endl;
@@ -2998,7 +2982,7 @@ void SystusWriter::writeMatrixFiles(const SystusModel& systusModel, const int id
 
     /* Writing Damping Matrices */
     if (dampingMatrices.size()>0){
-        ofstream ofsMatrixFile;
+        BufferedOfstream ofsMatrixFile;
         ofsMatrixFile.precision(DBL_DIG);
         string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_DAMGEN.ASC");
         ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
@@ -3014,7 +2998,7 @@ void SystusWriter::writeMatrixFiles(const SystusModel& systusModel, const int id
 
     /* Writing Mass Matrices */
     if (massMatrices.size()>0){
-        ofstream ofsMatrixFile;
+        BufferedOfstream ofsMatrixFile;
         ofsMatrixFile.precision(DBL_DIG);
         string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_MASGEN.ASC");
         ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
@@ -3030,7 +3014,7 @@ void SystusWriter::writeMatrixFiles(const SystusModel& systusModel, const int id
 
     /* Writing Stiffness Matrices */
     if (stiffnessMatrices.size()>0){
-        ofstream ofsMatrixFile;
+        BufferedOfstream ofsMatrixFile;
         ofsMatrixFile.precision(DBL_DIG);
         string matrixFile = systusModel.getOutputFileName("_SC" + to_string(idSubcase+1) + "_STIGEN.ASC");
         ofsMatrixFile.open(matrixFile.c_str(), ios::trunc);
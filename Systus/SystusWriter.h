@@ -97,18 +97,19 @@ class SystusWriter: public Writer {
     static const int StiffnessAccessId;      /**< Access Id for the Stiffness Matrices file (Element X9XX type 0)**/
 
 
-    map<int, vector<long unsigned int> > lists;
-    map<long unsigned int, vector<double>> vectors;
+    SystusRecords<long unsigned int> lists; /**< Systus lists, pairs of (loadcase, vectorId). **/
+    SystusRecords<double> vectors;
     map<int, int> rotationNodeIdByTranslationNodeId; /**< nodeId, nodeId > :  map between the reference node and the reference rotation for 190X elements in 3D mode.**/
     map<int, map<int, int>> localLoadingIdByLoadsetIdByAnalysisId;
     map<int, long unsigned int> loadingVectorIdByLocalLoading;
     map<int, map<int, vector<long unsigned int>>> loadingVectorsIdByLocalLoadingByNodePosition;
     map<int, map<int, vector<long unsigned int>>> constraintVectorsIdByLocalLoadingByNodePosition;
-    map<int, long unsigned int> localVectorIdByNodePosition;  /**< nodePosition, vectorId> for all Coordinate Systems Vectors. **/
-    map<int, int> loadingListIdByNodePosition;
+    /* Tables indexed by node position, sized by clear(), 0 meaning "none" */
+    vector<long unsigned int> localVectorIdByNodePosition;  /**< vectorId for all Coordinate Systems Vectors. **/
+    vector<int> loadingListIdByNodePosition;
     map<int, string> localLoadingListName;
-    map<int, int> constraintListIdByNodePosition;
-    map<int, char> constraintByNodePosition;
+    vector<int> constraintListIdByNodePosition;
+    vector<char> constraintByNodePosition;
     vector< vector<int> > systusSubcases;   /**< < subcase , <loadcases ids> > : Ids of loadcases composing the subcase **/
     vector<SystusTable> tables;
     SystusMatrices dampingMatrices;   	    /**< All needed damping matrices (element X9XX type 0). **/
@@ -295,9 +296,10 @@ class SystusWriter: public Writer {
     void getSystusInformations(const SystusModel&, const ConfigurationParameters&);
 
     /** 
-     * Clear all maps, vectors, lists filled during a previous translation.
+     * Clear all maps, vectors, lists filled during a previous translation, and
+     * size the tables indexed by node position for nbNodes nodes.
      */
-    void clear();
+    void clear(int nbNodes);
 
     /**
      * Translate the model into a Systus compatible format.
@@ -127,6 +127,10 @@ BOOST_AUTO_TEST_CASE( test_CoordinateSystem ) {
         BOOST_CHECK(!!(k * Y == Xtran.vectorToGlobal(k * Y)));
         BOOST_CHECK(!!(k * Z == Xtran.vectorToGlobal(k * Z)));
 
+        // the base at a point can be computed without updating the coordinate system
+        BOOST_CHECK(!!(k * (-1 * X + Y) / sqrt(2) == Xtran.vectorToGlobalAt(Y, k * X)));
+        BOOST_CHECK(!!(k * X == Xtran.vectorToGlobal(k * X)));
+
         Xtran.updateLocalBase(Y); // 3*Pi/4 rotation because center of rotation changed
         BOOST_CHECK(!!(k * (-1 * X + Y) / sqrt(2) == Xtran.vectorToGlobal(k * X)));
         BOOST_CHECK(!!(k * (-1 * X - 1 * Y) / sqrt(2) == Xtran.vectorToGlobal(k * Y)));
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * Diagnostics_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#define BOOST_TEST_MODULE diagnostics_tests
+#include "../../Abstract/Diagnostics.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace vega;
+
+BOOST_AUTO_TEST_CASE(diagnostics_by_kind) {
+	DiagnosticCollector diagnostics;
+	for (int line = 1; line <= 1000; line++) {
+		diagnostics.add(DiagnosticCollector::Severity::WARNING, "THETA or MCID parameter ignored.",
+				"deck.bdf", line, "CQUAD4");
+	}
+	diagnostics.add(DiagnosticCollector::Severity::WARNING, "THETA or MCID parameter ignored.",
+			"deck.bdf", 1001, "CTRIA3");
+	diagnostics.add(DiagnosticCollector::Severity::ERROR, "Unknown keyword.", "include.bdf", 7,
+			"FOO");
+	BOOST_CHECK_EQUAL(diagnostics.size(), 1002u);
+	BOOST_CHECK_EQUAL(diagnostics.countKinds(), 3u);
+	BOOST_CHECK_EQUAL(diagnostics.count(DiagnosticCollector::Severity::ERROR), 1u);
+
+	ostringstream summary;
+	diagnostics.printSummary(summary, 2);
+	const string expected = "Parsing diagnostics: 1 errors, 1001 warnings, of 3 kinds.\n"
+			"Parsing error in FOO (file include.bdf line 7): Unknown keyword.\n"
+			"Parsing warning in CQUAD4 (file deck.bdf line 1): THETA or MCID parameter ignored. [1000 times]\n"
+			"... and 1 other kinds.\n";
+	BOOST_CHECK_EQUAL(summary.str(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(diagnostics_json) {
+	DiagnosticCollector diagnostics;
+	diagnostics.add(DiagnosticCollector::Severity::WARNING, "\"quoted\" message", "C:\\deck.bdf", 3,
+			"PARAM");
+	diagnostics.add(DiagnosticCollector::Severity::WARNING, "\"quoted\" message", "C:\\deck.bdf", 4,
+			"PARAM");
+	ostringstream json;
+	diagnostics.writeJson(json);
+	const string expected = "{\n  \"kinds\": [\n"
+			"    {\"id\": 0, \"severity\": \"warning\", \"keyword\": \"PARAM\", \"message\": \"\\\"quoted\\\" message\", \"count\": 2}\n"
+			"  ],\n  \"diagnostics\": [\n"
+			"    {\"kind\": 0, \"file\": \"C:\\\\deck.bdf\", \"line\": 3},\n"
+			"    {\"kind\": 0, \"file\": \"C:\\\\deck.bdf\", \"line\": 4}\n"
+			"  ]\n}\n";
+	BOOST_CHECK_EQUAL(json.str(), expected);
+	diagnostics.clear();
+	BOOST_CHECK_EQUAL(diagnostics.size(), 0u);
+}
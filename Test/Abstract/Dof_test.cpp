@@ -79,9 +79,71 @@ BOOST_AUTO_TEST_CASE( hash_DOFS ) {
 
 BOOST_AUTO_TEST_CASE( test_differentnodes ) {
 	double expected = -25000;
-	DOFMatrix matrix;
-	matrix.addComponent(DOF::RY, DOF::DX, expected);
-	double found = matrix.findComponent(DOF::RY, DOF::DX);
-	BOOST_CHECK(is_equal(found, expected));
-	BOOST_CHECK(!matrix.isDiagonal());
+	DOFBlockMatrix matrix;
+	matrix.addComponent(0, DOF::RY, 0, DOF::DX, expected);
+	DOFBlock block = matrix.findBlock(0, 0);
+	BOOST_CHECK(is_equal(block.findComponent(DOF::RY, DOF::DX), expected));
+	// not symmetric: the transposed component is not set
+	BOOST_CHECK(!block.hasComponent(DOF::DX, DOF::RY));
+	BOOST_CHECK(is_equal(block.findComponent(DOF::DX, DOF::RY), 0.0));
+}
+
+BOOST_AUTO_TEST_CASE( test_block_matrix ) {
+	DOFBlockMatrix matrix(true);
+	matrix.addComponent(3, DOF::RY, 3, DOF::DX, 2.0);
+	matrix.addComponent(7, DOF::DY, 3, DOF::DZ, -1.0);
+	matrix.addComponent(3, DOF::DX, 3, DOF::DX, 5.0);
+	BOOST_CHECK_EQUAL(matrix.countBlocks(), (size_t )2);
+	// symmetric diagonal block: the lower component is stored in the upper half, and found
+	// from both sides
+	DOFBlock diagonal = matrix.findBlock(3, 3);
+	BOOST_CHECK(is_equal(diagonal.findComponent(DOF::DX, DOF::RY), 2.0));
+	BOOST_CHECK(is_equal(diagonal.findComponent(DOF::RY, DOF::DX), 2.0));
+	BOOST_CHECK(diagonal.hasComponent(DOF::RY, DOF::DX));
+	BOOST_CHECK(diagonal.hasRotations());
+	int count = 0;
+	for (const auto& kv : diagonal) {
+		BOOST_CHECK(kv.first.first == DOF::DX);
+		count++;
+	}
+	BOOST_CHECK_EQUAL(count, 2);
+	// out of diagonal blocks are kept above the diagonal, transposed if needed
+	DOFBlock coupling = matrix.findBlock(3, 7);
+	BOOST_CHECK(is_equal(coupling.findComponent(DOF::DZ, DOF::DY), -1.0));
+	BOOST_CHECK(!coupling.hasRotations());
+	BOOST_CHECK(matrix.findBlock(7, 3).isEmpty());
+	BOOST_CHECK(matrix.getDOFSForNode(7) == DOFS(DOF::DY));
+	BOOST_CHECK(matrix.getDOFSForNode(3) == DOFS(true, false, true, false, true, false));
+	BOOST_CHECK_EQUAL(matrix.findInPairs(7).size(), (size_t )1);
+	BOOST_CHECK_EQUAL(matrix.findInPairs(3).size(), (size_t )1);
+	BOOST_CHECK_EQUAL(matrix.nodePairs().size(), (size_t )2);
+}
+
+BOOST_AUTO_TEST_CASE( test_dof_masks ) {
+	// large enough to be split between workers
+	const int nodeCount = static_cast<int>(4 * DOFMasks::MIN_POSITIONS_BY_WORKER);
+	vector<int> evenPositions;
+	for (int position = 0; position < nodeCount; position += 2) {
+		evenPositions.push_back(position);
+	}
+	vector<NodeSet> nodeSets;
+	nodeSets.push_back(NodeSet(evenPositions.begin(), evenPositions.end()));
+	nodeSets.push_back(NodeSet({ 1, 2, nodeCount + 5 }));
+	vector<DOFS> dofsBySet = { DOFS::TRANSLATIONS, DOFS::ROTATIONS };
+	DOFMasks masks;
+	masks.allow(3, DOF::DX);
+	masks.allowAll(nodeSets, [&dofsBySet](size_t i, int nodePosition) {
+		UNUSEDV(nodePosition);
+		return dofsBySet[i];
+	});
+	BOOST_CHECK_EQUAL(masks.size(), static_cast<size_t>(nodeCount + 6));
+	BOOST_CHECK(masks.find(0) == DOFS::TRANSLATIONS);
+	BOOST_CHECK(masks.find(1) == DOFS::ROTATIONS);
+	BOOST_CHECK(masks.find(2) == DOFS::ALL_DOFS);
+	BOOST_CHECK(masks.find(3) == DOF::DX);
+	BOOST_CHECK(masks.find(nodeCount - 2) == DOFS::TRANSLATIONS);
+	BOOST_CHECK(masks.find(nodeCount - 1) == DOFS::NO_DOFS);
+	BOOST_CHECK(masks.find(nodeCount + 5) == DOFS::ROTATIONS);
+	BOOST_CHECK(masks.find(nodeCount + 100) == DOFS::NO_DOFS);
+	BOOST_CHECK_EQUAL(masks.nodePositions().size(), static_cast<size_t>(nodeCount / 2 + 3));
 }
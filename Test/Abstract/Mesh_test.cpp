@@ -41,7 +41,7 @@ BOOST_AUTO_TEST_CASE( test_faceIds ) {
 	Mesh mesh(LogLevel::INFO, "test");
 	int cellPosition = mesh.addCell(1, CellType::HEXA8, nodeIds);
 	Cell hexa = mesh.findCell(cellPosition);
-	vector<int> face1NodeIds = hexa.faceids_from_two_nodes(101, 104);
+	vector<int> face1NodeIds = hexa.faceids_from_two_nodes(101, 103);
 	vector<int> expectedFace1NodeIds = { 101, 102, 103, 104 };
 	BOOST_CHECK_EQUAL_COLLECTIONS(face1NodeIds.begin(), face1NodeIds.end(),
 			expectedFace1NodeIds.begin(), expectedFace1NodeIds.end());
@@ -51,6 +51,57 @@ BOOST_AUTO_TEST_CASE( test_faceIds ) {
 			expectedFace2NodeIds.begin(), expectedFace2NodeIds.end());
 }
 
+BOOST_AUTO_TEST_CASE( test_faceIds_quadratic_and_penta ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	vector<int> tetraNodeIds = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	Cell tetra = mesh.findCell(mesh.addCell(1, CellType::TETRA10, tetraNodeIds));
+	// node 4 is the corner opposite to the loaded face
+	vector<int> tetraFace = tetra.faceids_from_two_nodes(1, 4);
+	vector<int> expectedTetraFace = { 1, 2, 3, 5, 6, 7 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(tetraFace.begin(), tetraFace.end(), expectedTetraFace.begin(),
+			expectedTetraFace.end());
+
+	vector<int> pentaNodeIds = { 11, 12, 13, 14, 15, 16 };
+	Cell penta = mesh.findCell(mesh.addCell(2, CellType::PENTA6, pentaNodeIds));
+	vector<int> pentaQuadFace = penta.faceids_from_two_nodes(12, 16);
+	vector<int> expectedPentaQuadFace = { 12, 13, 16, 15 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(pentaQuadFace.begin(), pentaQuadFace.end(),
+			expectedPentaQuadFace.begin(), expectedPentaQuadFace.end());
+	// no second node for a triangular face
+	vector<int> pentaTriaFace = penta.faceids_from_two_nodes(15);
+	vector<int> expectedPentaTriaFace = { 14, 15, 16 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(pentaTriaFace.begin(), pentaTriaFace.end(),
+			expectedPentaTriaFace.begin(), expectedPentaTriaFace.end());
+
+	vector<int> hexaNodeIds;
+	for (int i = 21; i <= 40; i++) {
+		hexaNodeIds.push_back(i);
+	}
+	Cell hexa = mesh.findCell(mesh.addCell(3, CellType::HEXA20, hexaNodeIds));
+	vector<int> hexaFace = hexa.faceids_from_two_nodes(22, 27);
+	vector<int> expectedHexaFace = { 22, 23, 27, 26, 30, 39, 34, 38 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(hexaFace.begin(), hexaFace.end(), expectedHexaFace.begin(),
+			expectedHexaFace.end());
+	BOOST_CHECK_THROW(hexa.faceids_from_two_nodes(21, 27), logic_error);
+	// two corners of an edge are on two faces, the second node must be diagonally opposite
+	BOOST_CHECK_THROW(hexa.faceids_from_two_nodes(21, 22), logic_error);
+
+	vector<int> pyraNodeIds = { 41, 42, 43, 44, 45 };
+	Cell pyra = mesh.findCell(mesh.addCell(4, CellType::PYRA5, pyraNodeIds));
+	vector<int> pyraQuadFace = pyra.faceids_from_two_nodes(41, 43);
+	vector<int> expectedPyraQuadFace = { 41, 42, 43, 44 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(pyraQuadFace.begin(), pyraQuadFace.end(),
+			expectedPyraQuadFace.begin(), expectedPyraQuadFace.end());
+	// a triangular face of a pyramid is identified by its base edge
+	vector<int> pyraTriaFace = pyra.faceids_from_two_nodes(42, 43);
+	vector<int> expectedPyraTriaFace = { 42, 43, 45 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(pyraTriaFace.begin(), pyraTriaFace.end(),
+			expectedPyraTriaFace.begin(), expectedPyraTriaFace.end());
+	// a corner, or a corner and the apex, are on several faces
+	BOOST_CHECK_THROW(pyra.faceids_from_two_nodes(41), logic_error);
+	BOOST_CHECK_THROW(pyra.faceids_from_two_nodes(41, 45), logic_error);
+}
+
 BOOST_AUTO_TEST_CASE( test_NodeGroup ) {
 	Mesh mesh(LogLevel::INFO, "test");
 	vector<int> nodeIds = { 101, 102, 103, 104 };
@@ -75,6 +126,38 @@ BOOST_AUTO_TEST_CASE( test_NodeGroup ) {
 	BOOST_ASSERT_MSG(groupById != nullptr, "Group found by id");
 }
 
+BOOST_AUTO_TEST_CASE( test_NodeSet ) {
+	NodeSet nodeSet = { 5, 1, 3, 1 };
+	BOOST_CHECK_EQUAL(nodeSet.size(), (size_t ) 3);
+	BOOST_CHECK(nodeSet.insert(4));
+	BOOST_CHECK(!nodeSet.insert(3));
+	BOOST_CHECK(nodeSet.insert(8));
+	vector<int> others = { 7, 2, 8, 0 };
+	nodeSet.insert(others.begin(), others.end());
+	NodeSet merged = { 9, 1, 6 };
+	nodeSet.insert(merged);
+	vector<int> expected = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(nodeSet.begin(), nodeSet.end(), expected.begin(), expected.end());
+	BOOST_CHECK(nodeSet.contains(6));
+	BOOST_CHECK_EQUAL(nodeSet.erase(6), (size_t ) 1);
+	BOOST_CHECK_EQUAL(nodeSet.erase(6), (size_t ) 0);
+	BOOST_CHECK(nodeSet.find(6) == nodeSet.end());
+	BOOST_CHECK_EQUAL(*nodeSet.find(7), 7);
+}
+
+BOOST_AUTO_TEST_CASE( test_CellGroup_nodePositions ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	CellGroup* cellGroup = mesh.createCellGroup("GM1");
+	mesh.addCell(1, CellType::SEG2, { 101, 102 });
+	mesh.addCell(2, CellType::SEG2, { 102, 103 });
+	cellGroup->addCell(1);
+	BOOST_CHECK_EQUAL(cellGroup->nodePositions().size(), (size_t ) 2);
+	// adding a cell resets the cached nodes
+	cellGroup->addCell(2);
+	BOOST_CHECK_EQUAL(cellGroup->nodePositions().size(), (size_t ) 3);
+	BOOST_CHECK(cellGroup->nodePositions().contains(mesh.findNodePosition(103)));
+}
+
 BOOST_AUTO_TEST_CASE( test_node_iterator ) {
 	Mesh mesh(LogLevel::INFO, "test");
 	double coords[12] = { 1.0, 250., 0., 433., 250., 0., 0., -500., 0., 0., 0., 1000. };
@@ -123,46 +206,79 @@ BOOST_AUTO_TEST_CASE( test_node_iterator ) {
 	}
 	BOOST_CHECK_EQUAL(mesh.countNodes(), i);
 }
-/* API change, review the test
- BOOST_AUTO_TEST_CASE( test_CellGroup2Families ) {
- vector<CellGroup *> cellGroups;
- vega::CellGroup* gn1 = new CellGroup(nullptr, "GMA1");
- Cell cell1 =  Cell(1, CellType::TRI3_CODE,{1,2,3});
- Cell cell2 =  Cell(2, CellType::SEG2_CODE,{1,3});
- Cell cell3 =  Cell(3, CellType::TRI3_CODE,{3,4,5});
- gn1->addCell(cell1);
- gn1->addCell(cell2);
- gn1->addCell(cell3);
- cellGroups.push_back(gn1);
- vega::CellGroup* gn2 = new CellGroup(nullptr, "GMA2");
- CellPositionInfo* cell4 = new CellPositionInfo(1, CellType::TRI3_CODE);
- gn2->addCell(cell4);
- cellGroups.push_back(gn2);
- unordered_map<CellType::Code, int,hash<int>> cellCountByType;
- cellCountByType[CellType::SEG2_CODE] = 3;
- cellCountByType[CellType::TRI3_CODE] = 3;
- CellGroup2Families cg2fam(cellCountByType, cellGroups);
- unordered_map<CellType::Code, vector<int>,hash<int>> result =
- cg2fam.getFamilyOnCells();
-
- int expectedTri3[] = { 0, -2, -1 };
- vector<int> tri3 = result.find(CellType::TRI3_CODE)->second;
- BOOST_CHECK_EQUAL_COLLECTIONS(tri3.begin(), tri3.end(), expectedTri3,
- expectedTri3 + 3);
-
- int expectedSeg2[] = { 0, 0, -1 };
- vector<int> seg2 = result.find(CellType::SEG2_CODE)->second;
- BOOST_CHECK_EQUAL_COLLECTIONS(seg2.begin(), seg2.end(), expectedSeg2,
- expectedSeg2 + 3);
-
- vector<Family> families = cg2fam.getFamilies();
- BOOST_CHECK_EQUAL(2, families.size());
- bool famGMA1_GMA2_found = false;
- for (Family fam : families) {
- famGMA1_GMA2_found |= fam.name == "GMA1_GMA2";
- }
- BOOST_CHECK(famGMA1_GMA2_found);
- delete (gn1);
- delete (gn2);
-
- }*/
+BOOST_AUTO_TEST_CASE( test_CellGroup2Families ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	mesh.addCell(1, CellType::TRI3, {1, 2, 3});
+	mesh.addCell(2, CellType::SEG2, {1, 3});
+	mesh.addCell(3, CellType::TRI3, {3, 4, 5});
+	mesh.addCell(4, CellType::SEG2, {4, 5});
+	vector<CellGroup *> cellGroups;
+	CellGroup* gma1 = mesh.createCellGroup("GMA1");
+	gma1->addCell(1);
+	gma1->addCell(2);
+	gma1->addCell(3);
+	cellGroups.push_back(gma1);
+	CellGroup* gma2 = mesh.createCellGroup("GMA2");
+	gma2->addCell(3);
+	cellGroups.push_back(gma2);
+	unordered_map<CellType::Code, int, hash<int>> cellCountByType;
+	cellCountByType[CellType::SEG2_CODE] = 2;
+	cellCountByType[CellType::TRI3_CODE] = 2;
+	CellGroup2Families cg2fam(&mesh, cellCountByType, cellGroups);
+
+	auto& result = cg2fam.getFamilyOnCells();
+	vector<int> expectedTri3 = { -1, -2 };
+	const vector<int>& tri3 = *result.find(CellType::TRI3_CODE)->second;
+	BOOST_CHECK_EQUAL_COLLECTIONS(tri3.begin(), tri3.end(), expectedTri3.begin(),
+			expectedTri3.end());
+	vector<int> expectedSeg2 = { -1, 0 };
+	const vector<int>& seg2 = *result.find(CellType::SEG2_CODE)->second;
+	BOOST_CHECK_EQUAL_COLLECTIONS(seg2.begin(), seg2.end(), expectedSeg2.begin(),
+			expectedSeg2.end());
+
+	vector<Family> families = cg2fam.getFamilies();
+	BOOST_REQUIRE_EQUAL((size_t )2, families.size());
+	BOOST_CHECK_EQUAL(families[0].num, -2);
+	BOOST_CHECK_EQUAL(families[0].name, "GMA1_GMA2");
+	BOOST_CHECK_EQUAL(families[0].groups.size(), (size_t )2);
+	BOOST_CHECK_EQUAL(families[1].num, -1);
+	BOOST_CHECK_EQUAL(families[1].name, "GMA1");
+}
+
+BOOST_AUTO_TEST_CASE( test_NodeGroup2Families_many_nodes ) {
+	Mesh mesh(LogLevel::INFO, "test");
+	const int nnodes = 300000;
+	vector<NodeGroup *> nodeGroups;
+	// each node is in the groups of the divisors of its position among 2, 3 and 5
+	for (int divisor : { 2, 3, 5 }) {
+		NodeGroup* group = mesh.findOrCreateNodeGroup(
+				"MULTIPLE_OF_A_RATHER_LONG_NUMBER_NAMED_" + to_string(divisor));
+		for (int position = 0; position < nnodes; position += divisor) {
+			group->addNodeByPosition(position);
+		}
+		nodeGroups.push_back(group);
+	}
+	NodeGroup2Families ng(nnodes, nodeGroups);
+	vector<Family> families = ng.getFamilies();
+	BOOST_REQUIRE_EQUAL((size_t )7, families.size());
+	const vector<int>& result = ng.getFamilyOnNodes();
+	BOOST_REQUIRE_EQUAL(result.size(), (size_t )nnodes);
+	for (int position : { 0, 1, 2, 3, 5, 6, 10, 15, 299999, 299990 }) {
+		const int family = result[static_cast<size_t>(position)];
+		if (family == 0) {
+			BOOST_CHECK(position % 2 != 0 && position % 3 != 0 && position % 5 != 0);
+			continue;
+		}
+		const Family& fam = families[static_cast<size_t>(family - 1)];
+		BOOST_CHECK_EQUAL(fam.num, family);
+		size_t expectedGroups = 0;
+		for (int divisor : { 2, 3, 5 }) {
+			expectedGroups += (position % divisor == 0) ? 1 : 0;
+		}
+		BOOST_CHECK_EQUAL(fam.groups.size(), expectedGroups);
+	}
+	// families in the order of their groups: {2}, {2, 3}, {2, 3, 5}... whose names joined are too
+	// long for MED
+	BOOST_CHECK_EQUAL(families[0].name, "MULTIPLE_OF_A_RATHER_LONG_NUMBER_NAMED_2");
+	BOOST_CHECK_EQUAL(families[2].name, "Family3");
+}
@@ -243,6 +243,184 @@ BOOST_AUTO_TEST_CASE( test_create_skin2d ) {
 			expectedFace1NodeIds.begin(), expectedFace1NodeIds.end());
 }
 
+BOOST_AUTO_TEST_CASE( test_create_skin2d_shared_face ) {
+	shared_ptr<Model> model = createModelWith1HEXA8();
+	// the same face loaded twice, identified by both of its diagonals
+	PressionFaceTwoNodes pression1(*model, 50, 52, VectorialValue(0, 0, 1.0), VectorialValue(0, 0, 0));
+	pression1.addCell(1);
+	model->add(pression1);
+	PressionFaceTwoNodes pression2(*model, 51, 53, VectorialValue(0, 0, 2.0), VectorialValue(0, 0, 0));
+	pression2.addCell(1);
+	model->add(pression2);
+	model->finish();
+	BOOST_CHECK(model->validate());
+	BOOST_CHECK_EQUAL(1, model->mesh->countCells(CellType::QUAD4));
+	BOOST_CHECK(model->mesh->findGroup("VSkin") != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE( test_create_skin2d_merged_loadings ) {
+	shared_ptr<Model> model = createModelWith1HEXA8();
+	Reference<LoadSet> loadSetReference(LoadSet::LOAD, 1);
+	// the same pressure on three faces, and another one on a fourth face
+	vector<pair<int, int>> diagonals = { { 50, 52 }, { 54, 56 }, { 50, 55 }, { 51, 56 } };
+	for (size_t i = 0; i < diagonals.size(); i++) {
+		PressionFaceTwoNodes pression(*model, diagonals[i].first, diagonals[i].second,
+				VectorialValue(0, 0, i < 3 ? 1.0 : 2.0), VectorialValue(0, 0, 0));
+		pression.addCell(1);
+		model->add(pression);
+		model->addLoadingIntoLoadSet(pression, loadSetReference);
+	}
+	model->finish();
+	BOOST_CHECK(model->validate());
+	BOOST_CHECK_EQUAL(4, model->mesh->countCells(CellType::QUAD4));
+	// a loading, and a group of skin cells, for each pressure
+	const set<shared_ptr<Loading>> forceSurfaces = model->find(loadSetReference)->getLoadingsByType(
+			Loading::FORCE_SURFACE);
+	BOOST_REQUIRE_EQUAL(2, forceSurfaces.size());
+	size_t cellCount = 0;
+	for (const auto& forceSurface : forceSurfaces) {
+		const vector<Cell> cells = static_pointer_cast<ForceSurface>(forceSurface)->getCells(true);
+		BOOST_CHECK_EQUAL(static_pointer_cast<ForceSurface>(forceSurface)->getForce().z() > 1.5 ? 1 : 3,
+				cells.size());
+		cellCount += cells.size();
+	}
+	BOOST_CHECK_EQUAL(4, cellCount);
+}
+
+BOOST_AUTO_TEST_CASE( test_create_skin2d_coordinate_systems ) {
+	shared_ptr<Model> model = createModelWith1HEXA8();
+	model->add(CartesianCoordinateSystem(*model, VectorialValue(0, 0, 0), VectorialValue(0, 1, 0),
+			VectorialValue(-1, 0, 0), 5));
+	Reference<LoadSet> loadSetReference(LoadSet::LOAD, 1);
+	// the same components on two faces, but in two coordinate systems
+	vector<pair<int, int>> diagonals = { { 50, 52 }, { 54, 56 } };
+	for (size_t i = 0; i < diagonals.size(); i++) {
+		PressionFaceTwoNodes pression(*model, diagonals[i].first, diagonals[i].second,
+				VectorialValue(1.0, 0, 0), VectorialValue(0, 0, 0), Loading::NO_ORIGINAL_ID,
+				i == 0 ? CoordinateSystem::GLOBAL_COORDINATE_SYSTEM_ID : 5);
+		pression.addCell(1);
+		model->add(pression);
+		model->addLoadingIntoLoadSet(pression, loadSetReference);
+	}
+	model->finish();
+	BOOST_CHECK(model->validate());
+	const set<shared_ptr<Loading>> forceSurfaces = model->find(loadSetReference)->getLoadingsByType(
+			Loading::FORCE_SURFACE);
+	BOOST_REQUIRE_EQUAL(2, forceSurfaces.size());
+	for (const auto& forceSurface : forceSurfaces) {
+		BOOST_CHECK_EQUAL(1, static_pointer_cast<ForceSurface>(forceSurface)->getCells(true).size());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_orientation_dedup ) {
+	Model model("orientations");
+	int byNode = model.addOrFindOrientation(1, 2, 3);
+	BOOST_CHECK(byNode != 0);
+	BOOST_CHECK_EQUAL(byNode, model.addOrFindOrientation(1, 2, 3));
+	BOOST_CHECK(byNode != model.addOrFindOrientation(2, 1, 3));
+	int byVector = model.addOrFindOrientation(1, 2, VectorialValue(0, 0, 1));
+	BOOST_CHECK(byVector != byNode);
+	// the vector is compared once normalized
+	BOOST_CHECK_EQUAL(byVector, model.addOrFindOrientation(1, 2, VectorialValue(0, 0, 5)));
+	BOOST_CHECK(byVector != model.addOrFindOrientation(1, 2, VectorialValue(0, 1, 0)));
+	OrientationCoordinateSystem ocs(model, 1, 2, VectorialValue(0, 0, 2));
+	BOOST_CHECK_EQUAL(byVector, model.findOrientation(ocs));
+	BOOST_CHECK_EQUAL(byVector, model.addOrFindOrientation(ocs));
+	BOOST_CHECK_EQUAL(4, model.coordinateSystems.size());
+}
+
+BOOST_AUTO_TEST_CASE( test_function_table_evaluate ) {
+	Model model("functions");
+	FunctionTable linear(model, FunctionTable::LINEAR, FunctionTable::LINEAR, FunctionTable::NONE,
+			FunctionTable::CONSTANT);
+	linear.setXY(1.0, 10.0);
+	linear.setXY(2.0, 20.0);
+	linear.setXY(4.0, 0.0);
+	BOOST_CHECK_CLOSE(linear.evaluate(1.5), 15.0, 1e-8);
+	BOOST_CHECK_CLOSE(linear.evaluate(2.0), 20.0, 1e-8);
+	BOOST_CHECK_CLOSE(linear.evaluate(3.0), 10.0, 1e-8);
+	BOOST_CHECK_SMALL(linear.evaluate(5.0), 1e-12);
+	BOOST_CHECK_THROW(linear.evaluate(0.5), out_of_range);
+	StepRange frequencies(model, 1.0, 0.5, 6);
+	vector<double> values = linear.evaluate(frequencies.getValues());
+	vector<double> expected = { 10.0, 15.0, 20.0, 15.0, 10.0, 5.0, 0.0 };
+	BOOST_REQUIRE_EQUAL(values.size(), expected.size());
+	for (size_t i = 0; i < values.size(); i++) {
+		BOOST_CHECK_SMALL(values[i] - expected[i], 1e-10);
+	}
+
+	FunctionTable logarithmic(model, FunctionTable::LOGARITHMIC, FunctionTable::LOGARITHMIC,
+			FunctionTable::LINEAR, FunctionTable::NONE);
+	logarithmic.setXY(10.0, 1.0);
+	logarithmic.setXY(100.0, 100.0);
+	// y = x^2 / 100 on a log-log scale
+	BOOST_CHECK_CLOSE(logarithmic.evaluate(50.0), 25.0, 1e-8);
+	BOOST_CHECK_CLOSE(logarithmic.evaluate(1.0), 0.01, 1e-8);
+	vector<double> logValues = logarithmic.evaluate(vector<double>({ 1.0, 20.0, 100.0 }));
+	BOOST_CHECK_CLOSE(logValues[0], 0.01, 1e-8);
+	BOOST_CHECK_CLOSE(logValues[1], 4.0, 1e-8);
+	BOOST_CHECK_CLOSE(logValues[2], 100.0, 1e-8);
+	BOOST_CHECK_THROW(logarithmic.evaluate(vector<double>({ 20.0, 200.0 })), out_of_range);
+	BOOST_CHECK_THROW(logarithmic.evaluate(vector<double>({ 20.0, 10.0 })), invalid_argument);
+	// out of the domain of the logarithm
+	BOOST_CHECK_THROW(logarithmic.evaluate(0.0), invalid_argument);
+	BOOST_CHECK_THROW(logarithmic.evaluate(vector<double>({ -1.0, 20.0 })), invalid_argument);
+	BOOST_CHECK_THROW(logarithmic.setXY(200.0, 0.0), invalid_argument);
+	FunctionTable logarithmicX(model, FunctionTable::LOGARITHMIC, FunctionTable::LINEAR,
+			FunctionTable::NONE, FunctionTable::NONE);
+	BOOST_CHECK_THROW(logarithmicX.setXY(0.0, 1.0), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( test_intern_definitions ) {
+	Model model("interning", "10.3", SolverName::NASTRAN,
+			ModelConfiguration(false, LogLevel::INFO, false, true, false, true, true, true, false,
+					true, true, false, 999, false, false, true));
+	model.mesh->addNode(1, 0.0, 0.0, 0.0);
+	model.mesh->addNode(2, 1.0, 0.0, 0.0);
+	model.mesh->addNode(3, 2.0, 0.0, 0.0);
+	model.mesh->addNode(4, 3.0, 0.0, 0.0);
+	for (int i = 1; i <= 3; i++) {
+		model.mesh->addCell(i, CellType::SEG2, {i, i + 1});
+		vega::CellGroup* group = model.mesh->createCellGroup("GM" + to_string(i));
+		group->addCell(i);
+		RectangularSectionBeam beam(model, 1.0, 2.0, Beam::EULER, 0.5, i);
+		beam.assignCellGroup(group);
+		beam.assignMaterial(i);
+		model.add(beam);
+	}
+	model.getOrCreateMaterial(1)->addNature(ElasticNature(model, 2.1e11, 0.3));
+	model.getOrCreateMaterial(2)->addNature(ElasticNature(model, 2.1e11, 0.3));
+	model.getOrCreateMaterial(3)->addNature(ElasticNature(model, 7e10, 0.3));
+	int vegaId11 = 0;
+	for (int id = 10; id <= 11; id++) {
+		FunctionTable stressStrain(model, FunctionTable::LINEAR, FunctionTable::LINEAR,
+				FunctionTable::NONE, FunctionTable::NONE, id);
+		stressStrain.setXY(0.0, 0.0);
+		stressStrain.setXY(0.1, 2.0e8);
+		model.add(stressStrain);
+		vegaId11 = stressStrain.getId();
+	}
+	model.getOrCreateMaterial(4)->addNature(NonLinearElasticNature(model, 10));
+	model.getOrCreateMaterial(5)->addNature(NonLinearElasticNature(model, 11));
+	model.getOrCreateMaterial(4)->assignMaterial(CellContainer(model.mesh));
+	model.finish();
+
+	BOOST_CHECK_EQUAL(model.values.size(), 1);
+	shared_ptr<Value> table10 = model.find(Reference<Value>(Value::FUNCTION_TABLE, 10));
+	BOOST_REQUIRE(table10);
+	BOOST_CHECK_EQUAL(model.find(Reference<Value>(Value::FUNCTION_TABLE, 11)), table10);
+	BOOST_CHECK_EQUAL(model.getValue(vegaId11), table10);
+	// the three beams have the same additional mass: a single material is added for them
+	BOOST_CHECK_EQUAL(model.materials.size(), 4);
+	BOOST_CHECK(model.materials.find(2) == nullptr);
+	BOOST_CHECK(model.materials.find(5) == nullptr);
+	BOOST_CHECK_EQUAL(model.elementSets.find(1)->material->getOriginalId(), 1);
+	BOOST_CHECK_EQUAL(model.elementSets.find(2)->material->getOriginalId(), 1);
+	BOOST_CHECK_EQUAL(model.elementSets.find(3)->material->getOriginalId(), 3);
+	CellContainer assignment = model.materials.find(1)->getAssignment();
+	BOOST_CHECK_EQUAL(assignment.getCellGroups().size(), (size_t )2);
+}
+
 BOOST_AUTO_TEST_CASE(test_Analysis) {
 	ModelConfiguration configuration(false, LogLevel::DEBUG, false, false, false, false, false);
 	Model model("inputfile", "10.3", SolverName::NASTRAN, configuration);
@@ -455,6 +633,78 @@ BOOST_AUTO_TEST_CASE(test_rbe3_assertions_not_removed) {
 	BOOST_CHECK_EQUAL(assertions.size(), (size_t )2);
 }
 
+BOOST_AUTO_TEST_CASE(test_boundary_dofs) {
+	shared_ptr<Model> model = createModelWith1HEXA8();
+	SinglePointConstraint commonSpc(*model, DOF::DX, 0.0);
+	commonSpc.addNodeId(50);
+	model->add(commonSpc);
+	model->addConstraintIntoConstraintSet(commonSpc, model->commonConstraintSet);
+	ConstraintSet constraintSet(*model, ConstraintSet::SPC, 2);
+	model->add(constraintSet);
+	SinglePointConstraint specificSpc(*model, DOF::DZ, 0.0);
+	specificSpc.addNodeId(51);
+	model->add(specificSpc);
+	model->addConstraintIntoConstraintSet(specificSpc, constraintSet);
+	LinearMecaStat analysis1(*model);
+	model->add(analysis1);
+	LinearMecaStat analysis2(*model);
+	analysis2.add(constraintSet.getReference());
+	model->add(analysis2);
+	model->finish();
+	const int nodePosition50 = model->mesh->findNodePosition(50);
+	const int nodePosition51 = model->mesh->findNodePosition(51);
+	BOOST_CHECK_EQUAL(model->commonBoundaryDOFS.find(nodePosition50), DOF::DX);
+	BOOST_CHECK_EQUAL(model->commonBoundaryDOFS.find(nodePosition51), DOFS::NO_DOFS);
+	shared_ptr<Analysis> foundAnalysis1 = model->find(analysis1.getReference());
+	shared_ptr<Analysis> foundAnalysis2 = model->find(analysis2.getReference());
+	BOOST_CHECK_EQUAL(foundAnalysis1->findBoundaryDOFS(nodePosition50), DOF::DX);
+	BOOST_CHECK_EQUAL(foundAnalysis1->findBoundaryDOFS(nodePosition51), DOFS::NO_DOFS);
+	BOOST_CHECK_EQUAL(foundAnalysis2->findBoundaryDOFS(nodePosition50), DOF::DX);
+	BOOST_CHECK_EQUAL(foundAnalysis2->findBoundaryDOFS(nodePosition51), DOF::DZ);
+	BOOST_CHECK_EQUAL(foundAnalysis2->boundaryNodePositions().size(), (size_t ) 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_redundant_spcs) {
+	shared_ptr<Model> model = createModelWith1HEXA8();
+	SinglePointConstraint spc1(*model, DOF::DX, 0.0);
+	spc1.addNodeId(50);
+	model->add(spc1);
+	model->addConstraintIntoConstraintSet(spc1, model->commonConstraintSet);
+	SinglePointConstraint spc2(*model, DOFS(true, true, false), 0.0);
+	spc2.addNodeId(50);
+	model->add(spc2);
+	model->addConstraintIntoConstraintSet(spc2, model->commonConstraintSet);
+	LinearMecaStat analysis(*model);
+	model->add(analysis);
+	model->finish();
+	const int nodePosition = model->mesh->findNodePosition(50);
+	int dxCount = 0;
+	for (const auto& constraint : model->commonConstraintSet.getConstraints()) {
+		if (constraint->nodePositions().contains(nodePosition)
+				&& constraint->getDOFSForNode(nodePosition).contains(DOF::DX)) {
+			dxCount++;
+		}
+	}
+	BOOST_CHECK_EQUAL(dxCount, 1);
+	BOOST_CHECK_EQUAL(model->find(analysis.getReference())->findBoundaryDOFS(nodePosition),
+			DOFS(true, true, false));
+}
+
+BOOST_AUTO_TEST_CASE(test_conflicting_spcs) {
+	shared_ptr<Model> model = createModelWith1HEXA8();
+	SinglePointConstraint spc1(*model, DOF::DX, 0.0);
+	spc1.addNodeId(50);
+	model->add(spc1);
+	model->addConstraintIntoConstraintSet(spc1, model->commonConstraintSet);
+	SinglePointConstraint spc2(*model, DOF::DX, 1.0);
+	spc2.addNodeId(50);
+	model->add(spc2);
+	model->addConstraintIntoConstraintSet(spc2, model->commonConstraintSet);
+	LinearMecaStat analysis(*model);
+	model->add(analysis);
+	BOOST_CHECK_THROW(model->finish(), logic_error);
+}
+
 BOOST_AUTO_TEST_CASE(test_spc_dof_remove) {
 	shared_ptr<Model> model = createModelWith1HEXA8();
 	LinearMecaStat analysis1(*model);
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * SolverProcess_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#define BOOST_TEST_MODULE solver_process_tests
+#include "build_properties.h"
+#include "../../Abstract/SolverProcess.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vega;
+namespace fs = boost::filesystem;
+
+namespace {
+
+const string MOCK_SOLVER = PROJECT_BASE_DIR "/Test/Abstract/mock_solver.sh";
+
+string outputFile(const string& name) {
+	return fs::path(PROJECT_BINARY_DIR "/bin/" + name).make_preferred().string();
+}
+
+vector<string> readLines(const string& path) {
+	vector<string> lines;
+	ifstream file(path);
+	string line;
+	while (getline(file, line)) {
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+/**
+ * Highest number of jobs running together, from the "start" and "end" lines they appended to
+ * a file.
+ */
+int countConcurrentJobs(const string& path) {
+	int running = 0;
+	int maxRunning = 0;
+	for (const string& line : readLines(path)) {
+		running += line == "start" ? 1 : -1;
+		maxRunning = max(maxRunning, running);
+	}
+	return maxRunning;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_streamed_output ) {
+	SolverJob job;
+	job.arguments = { MOCK_SOLVER, "--out", "first", "--out", "TEST NOOK", "--err", "NO ERROR",
+			"--err", "FATAL ERROR", "study.export" };
+	job.stdoutFile = outputFile("mock.stdout");
+	job.stderrFile = outputFile("mock.stderr");
+	job.patterns = { { "NOOK", "" }, { "ERROR", "NO ERROR" } };
+	const SolverJobResult result = runSolverJob(job);
+	BOOST_CHECK(result.started);
+	BOOST_CHECK(!result.timedOut);
+	BOOST_CHECK(!result.signaled);
+	BOOST_CHECK_EQUAL(result.exitCode, 0);
+	BOOST_REQUIRE_EQUAL(result.matches.size(), 2);
+	for (const LogMatch& match : result.matches) {
+		BOOST_CHECK_EQUAL(match.lineNumber, 2);
+		if (match.pattern == "NOOK") {
+			BOOST_CHECK_EQUAL(match.file, job.stdoutFile);
+			BOOST_CHECK_EQUAL(match.line, "TEST NOOK");
+		} else {
+			BOOST_CHECK_EQUAL(match.file, job.stderrFile);
+			BOOST_CHECK_EQUAL(match.line, "FATAL ERROR");
+		}
+	}
+	const vector<string> expectedStdout = { "first", "TEST NOOK" };
+	const vector<string> stdoutLines = readLines(job.stdoutFile);
+	BOOST_CHECK_EQUAL_COLLECTIONS(stdoutLines.begin(), stdoutLines.end(), expectedStdout.begin(),
+			expectedStdout.end());
+}
+
+BOOST_AUTO_TEST_CASE( test_exit_codes ) {
+	SolverJob job;
+	job.arguments = { MOCK_SOLVER, "--exit", "4" };
+	SolverJobResult result = runSolverJob(job);
+	BOOST_CHECK(result.started);
+	BOOST_CHECK_EQUAL(result.exitCode, 4);
+
+	job.arguments = { outputFile("no_such_solver") };
+	result = runSolverJob(job);
+	BOOST_CHECK(!result.started);
+
+	job.arguments = { MOCK_SOLVER };
+	job.workingDirectory = outputFile("no_such_directory");
+	result = runSolverJob(job);
+	BOOST_CHECK(!result.started);
+}
+
+BOOST_AUTO_TEST_CASE( test_timeout ) {
+	SolverJob job;
+	job.arguments = { MOCK_SOLVER, "--out", "started", "--sleep", "30" };
+	job.stdoutFile = outputFile("timeout.stdout");
+	job.timeout = 0.5;
+	const SolverJobResult result = runSolverJob(job);
+	BOOST_CHECK(result.started);
+	BOOST_CHECK(result.timedOut);
+	BOOST_CHECK(result.signaled);
+	BOOST_CHECK_LT(result.elapsed, 10);
+	BOOST_CHECK_EQUAL(readLines(job.stdoutFile).size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_queue_budget ) {
+	const string cpuLog = outputFile("queue_cpus.log");
+	const string memoryLog = outputFile("queue_memory.log");
+	fs::remove(cpuLog);
+	fs::remove(memoryLog);
+	{
+		SolverQueue queue(2);
+		vector<future<SolverJobResult>> results;
+		for (int i = 0; i < 4; i++) {
+			SolverJob job;
+			job.arguments = { MOCK_SOLVER, "--file", cpuLog, "start", "--sleep", "0.3", "--file",
+					cpuLog, "end" };
+			results.push_back(queue.submit(job));
+		}
+		// larger than the whole budget: runs alone
+		SolverJob largeJob;
+		largeJob.arguments = { MOCK_SOLVER, "--exit", "0" };
+		largeJob.cpus = 8;
+		results.push_back(queue.submit(largeJob));
+		for (auto& result : results) {
+			BOOST_CHECK_EQUAL(result.get().exitCode, 0);
+		}
+	}
+	BOOST_CHECK_EQUAL(readLines(cpuLog).size(), 8);
+	// the budget is used: two jobs at a time, never more
+	BOOST_CHECK_EQUAL(countConcurrentJobs(cpuLog), 2);
+	{
+		SolverQueue queue(4, 100);
+		vector<future<SolverJobResult>> results;
+		for (int i = 0; i < 3; i++) {
+			SolverJob job;
+			job.arguments = { MOCK_SOLVER, "--file", memoryLog, "start", "--sleep", "0.2", "--file",
+					memoryLog, "end" };
+			job.memory = 60;
+			results.push_back(queue.submit(job));
+		}
+		for (auto& result : results) {
+			BOOST_CHECK_EQUAL(result.get().exitCode, 0);
+		}
+	}
+	BOOST_CHECK_EQUAL(readLines(memoryLog).size(), 6);
+	BOOST_CHECK_EQUAL(countConcurrentJobs(memoryLog), 1);
+}
@@ -6,7 +6,11 @@
 #define BOOST_TEST_MODULE utility_tests
 #include "build_properties.h"
 #include "../../Abstract/Utility.h"
+#include "../../Abstract/NumberFormat.h"
 #include <boost/test/unit_test.hpp>
+#include <cfloat>
+#include <iomanip>
+#include <sstream>
 
 using namespace std;
 using namespace vega;
@@ -56,3 +60,59 @@ BOOST_AUTO_TEST_CASE( valueOrReference_ref ) {
 	ValueOrReference ref2a = ref2;
 	BOOST_CHECK_EQUAL(ref2a, ref2);
 }
+
+static string formatted(double value) {
+	char chars[NUMBER_MAX_CHARS];
+	return string(chars, formatDouble(value, chars));
+}
+
+static string nastranField(double value, size_t width) {
+	char chars[NUMBER_MAX_CHARS];
+	return string(chars, formatNastranDouble(value, width, chars));
+}
+
+BOOST_AUTO_TEST_CASE( format_double ) {
+	BOOST_CHECK_EQUAL(formatted(0.0), "0");
+	BOOST_CHECK_EQUAL(formatted(2.0), "2");
+	BOOST_CHECK_EQUAL(formatted(-12.5), "-12.5");
+	BOOST_CHECK_EQUAL(formatted(0.1), "0.1");
+	BOOST_CHECK_EQUAL(formatted(0.00025), "0.00025");
+	BOOST_CHECK_EQUAL(formatted(1.5e-7), "1.5e-07");
+	BOOST_CHECK_EQUAL(formatted(2.1e11), "210000000000");
+	BOOST_CHECK_EQUAL(formatted(1e20), "1e+20");
+	BOOST_CHECK_EQUAL(formatted(0.1 + 0.2), "0.30000000000000004");
+	const double values[] = { 1. / 3., -2. / 7., 7.8e-9, 123456.789, 6.02214076e23, 1e-300,
+			M_PI };
+	for (double value : values) {
+		BOOST_CHECK_EQUAL(strtod(formatted(value).c_str(), nullptr), value);
+	}
+	char chars[NUMBER_MAX_CHARS];
+	BOOST_CHECK_EQUAL(string(chars, formatInteger(-1234, chars)), "-1234");
+	BOOST_CHECK_EQUAL(string(chars, formatInteger(0, chars)), "0");
+}
+
+BOOST_AUTO_TEST_CASE( format_nastran_double ) {
+	BOOST_CHECK_EQUAL(nastranField(2.0, 8), "2.");
+	BOOST_CHECK_EQUAL(nastranField(-0.5, 8), "-.5");
+	BOOST_CHECK_EQUAL(nastranField(2.1e11, 8), "2.1+11");
+	BOOST_CHECK_EQUAL(nastranField(1.5e-7, 8), "1.5-7");
+	BOOST_CHECK_EQUAL(nastranField(1. / 3., 8), ".3333333");
+	BOOST_CHECK_EQUAL(nastranField(-123456.789, 8), "-123457.");
+	BOOST_CHECK_EQUAL(nastranField(12345678., 8), "1.2346+7");
+	BOOST_CHECK_EQUAL(nastranField(1. / 3., 16), ".333333333333333");
+	BOOST_CHECK_EQUAL(nastranField(123456.789, 16), "123456.789");
+}
+
+BOOST_AUTO_TEST_CASE( fast_number_put ) {
+	ostringstream out;
+	useFastNumberFormat(out);
+	out.precision(DBL_DIG);
+	out << 0.1 + 0.2 << " " << 42 << " " << -7L << " " << 2.5;
+	BOOST_CHECK_EQUAL(out.str(), "0.30000000000000004 42 -7 2.5");
+	out.str("");
+	out << setw(6) << 1.5 << "|" << left << setw(4) << 3 << "|";
+	BOOST_CHECK_EQUAL(out.str(), "   1.5|3   |");
+	out.str("");
+	out << scientific << 1.5;
+	BOOST_CHECK_EQUAL(out.str(), "1.500000000000000e+00");
+}
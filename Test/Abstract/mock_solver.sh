@@ -0,0 +1,20 @@
+#!/bin/bash
+# Stands in for as_run, systus or nastran in the tests of the solver runners.
+# The actions are executed in order:
+#   --out TEXT         prints a line on the standard output
+#   --err TEXT         prints a line on the standard error
+#   --file PATH TEXT   appends a line to a file (relative to the working directory)
+#   --sleep SECONDS    waits
+#   --exit CODE        exits with the code
+# Other arguments, such as the model file, are ignored.
+while [ $# -gt 0 ]; do
+    case "$1" in
+    --out) echo "$2"; shift 2 ;;
+    --err) echo "$2" >&2; shift 2 ;;
+    --file) echo "$3" >> "$2"; shift 3 ;;
+    --sleep) sleep "$2"; shift 2 ;;
+    --exit) exit "$2" ;;
+    *) shift ;;
+    esac
+done
+exit 0
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * AsterResources_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "../../Abstract/ConfigurationParameters.h"
+#include "../../Abstract/Model.h"
+#include "../../Abstract/Parallel.h"
+#include "../../Aster/AsterResources.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE aster_resources_test
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vega;
+using namespace vega::aster;
+
+namespace {
+
+/**
+ * A finished model of beams in line, with a linear static or a modal analysis.
+ */
+unique_ptr<Model> createBeamModel(int nodeCount, bool modal = false) {
+	unique_ptr<Model> model(new Model("beams", "10.3", NASTRAN));
+	for (int i = 1; i <= nodeCount; i++) {
+		model->mesh->addNode(i, static_cast<double>(i), 0.0, 0.0);
+	}
+	CellGroup* beamGroup = model->mesh->createCellGroup("BEAMS");
+	for (int i = 1; i < nodeCount; i++) {
+		model->mesh->addCell(i, CellType::SEG2, { i, i + 1 });
+		beamGroup->addCell(i);
+	}
+	RectangularSectionBeam beam(*model, 1.0, 2.0, Beam::EULER, 1);
+	beam.assignCellGroup(beamGroup);
+	beam.assignMaterial(1);
+	model->add(beam);
+	model->getOrCreateMaterial(1)->addNature(ElasticNature(*model, 2.1e11, 0.3));
+	if (modal) {
+		FrequencyBand frequencyBand(*model, 0.0, 100.0, 30, "MASS", 1);
+		model->add(frequencyBand);
+		LinearModal analysis(*model, 1);
+		model->add(analysis);
+	} else {
+		LinearMecaStat analysis(*model);
+		model->add(analysis);
+	}
+	model->finish();
+	return model;
+}
+
+string findKeyword(const vector<pair<string, string>>& keywords, const string& keyword) {
+	for (const auto& keywordAndValue : keywords) {
+		if (keywordAndValue.first == keyword) {
+			return keywordAndValue.second;
+		}
+	}
+	return "";
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_small_model ) {
+	unique_ptr<Model> model = createBeamModel(11);
+	ConfigurationParameters configuration("beams.dat", CODE_ASTER);
+	AsterResources resources(*model, configuration);
+	BOOST_CHECK_EQUAL(resources.dofCount, 66);
+	BOOST_CHECK_EQUAL(resources.mpiCpus, 1);
+	BOOST_CHECK_EQUAL(resources.threads, 1);
+	BOOST_CHECK(!resources.distributedMesh);
+	BOOST_CHECK(!resources.outOfCore);
+	BOOST_CHECK_CLOSE(resources.memoryLimit, AsterResources::MIN_MEMORY, 1e-9);
+	BOOST_CHECK_CLOSE(resources.timeLimit, AsterResources::MIN_TIME, 1e-9);
+	const auto& keywords = resources.getSolverKeywords(Analysis::LINEAR_MECA_STAT);
+	BOOST_REQUIRE_EQUAL(keywords.size(), 2);
+	BOOST_CHECK_EQUAL(keywords[0].first, "RENUM");
+	BOOST_CHECK_EQUAL(keywords[0].second, "'PORD'");
+	BOOST_CHECK_EQUAL(keywords[1].first, "METHODE");
+	BOOST_CHECK_EQUAL(keywords[1].second, "'MUMPS'");
+}
+
+BOOST_AUTO_TEST_CASE( test_large_model ) {
+	unique_ptr<Model> model = createBeamModel(20000);
+	ConfigurationParameters configuration("beams.dat", CODE_ASTER, "", "vega", ".",
+			LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, "", 0.02, false, "", "",
+			"lagrangian", 0.0, 1.0, "auto", "systus", {}, "table", 9, "direct", "small", 16);
+	AsterResources resources(*model, configuration);
+	BOOST_CHECK_EQUAL(resources.dofCount, 120000);
+	BOOST_CHECK_EQUAL(resources.mpiCpus, 3);
+	BOOST_CHECK_EQUAL(resources.threads, 1);
+	BOOST_CHECK(resources.distributedMesh);
+	const auto& keywords = resources.getSolverKeywords(Analysis::LINEAR_MECA_STAT);
+	BOOST_CHECK_EQUAL(findKeyword(keywords, "RENUM"), "'SCOTCH'");
+	BOOST_CHECK_EQUAL(findKeyword(keywords, "METHODE"), "'MUMPS'");
+	BOOST_CHECK_EQUAL(findKeyword(keywords, "MATR_DISTRIBUEE"), "'OUI'");
+}
+
+BOOST_AUTO_TEST_CASE( test_host_cpus ) {
+	unique_ptr<Model> model = createBeamModel(20000);
+	ConfigurationParameters configuration("beams.dat", CODE_ASTER);
+	AsterResources resources(*model, configuration);
+	// 3 processors are needed, no more than the hardware threads of the host are used
+	BOOST_CHECK_EQUAL(resources.mpiCpus, min(3, static_cast<int>(countWorkers())));
+	BOOST_CHECK_EQUAL(resources.threads, 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_command_line_limits ) {
+	unique_ptr<Model> model = createBeamModel(20000);
+	ConfigurationParameters configuration("beams.dat", CODE_ASTER, "", "vega", ".",
+			LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, "", 0.02, false, "", "",
+			"lagrangian", 0.0, 1.0, "auto", "systus", {}, "table", 9, "direct", "small", 1, 700,
+			100);
+	AsterResources resources(*model, configuration);
+	BOOST_CHECK_EQUAL(resources.mpiCpus, 1);
+	BOOST_CHECK_EQUAL(resources.threads, 1);
+	BOOST_CHECK(!resources.distributedMesh);
+	BOOST_CHECK(resources.outOfCore);
+	BOOST_CHECK_CLOSE(resources.memoryLimit, 700, 1e-9);
+	BOOST_CHECK_CLOSE(resources.getMemjeveux(), 87.5, 1e-9);
+	BOOST_CHECK_CLOSE(resources.timeLimit, 100, 1e-9);
+	const auto& keywords = resources.getSolverKeywords(Analysis::LINEAR_MECA_STAT);
+	BOOST_CHECK_EQUAL(findKeyword(keywords, "RENUM"), "'METIS'");
+	BOOST_CHECK_EQUAL(findKeyword(keywords, "GESTION_MEMOIRE"), "'OUT_OF_CORE'");
+	BOOST_CHECK_EQUAL(findKeyword(keywords, "MATR_DISTRIBUEE"), "");
+}
+
+BOOST_AUTO_TEST_CASE( test_modal_bands ) {
+	unique_ptr<Model> model = createBeamModel(11, true);
+	ConfigurationParameters configuration("beams.dat", CODE_ASTER, "", "vega", ".",
+			LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, "", 0.02, false, "", "",
+			"lagrangian", 0.0, 1.0, "auto", "systus", {}, "table", 9, "direct", "small", 16, 0,
+			0, 4);
+	AsterResources resources(*model, configuration);
+	BOOST_CHECK_EQUAL(resources.modeCount, 30);
+	BOOST_CHECK_EQUAL(resources.modalBands, 4);
+	BOOST_CHECK_EQUAL(resources.mpiCpus, 4);
+	BOOST_CHECK_EQUAL(resources.threads, 1);
+	BOOST_CHECK(resources.distributedMesh);
+}
+
+BOOST_AUTO_TEST_CASE( test_modal_bands_above_max_cpus ) {
+	unique_ptr<Model> model = createBeamModel(11, true);
+	ConfigurationParameters configuration("beams.dat", CODE_ASTER, "", "vega", ".",
+			LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, "", 0.02, false, "", "",
+			"lagrangian", 0.0, 1.0, "auto", "systus", {}, "table", 9, "direct", "small", 2, 0,
+			0, 4);
+	AsterResources resources(*model, configuration);
+	// a sub-band by MPI process at most
+	BOOST_CHECK_EQUAL(resources.mpiCpus, 2);
+	BOOST_CHECK_EQUAL(resources.modalBands, 2);
+}
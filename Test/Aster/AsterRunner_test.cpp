@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ *
+ * AsterRunner_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: devel
+ */
+
+#include "build_properties.h"
+#include "../../Abstract/ConfigurationParameters.h"
+#include "../../Aster/AsterRunner.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#define BOOST_TEST_MODULE aster_runner_test
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vega;
+using namespace vega::aster;
+namespace fs = boost::filesystem;
+
+namespace {
+
+const string MOCK_SOLVER = PROJECT_BASE_DIR "/Test/Abstract/mock_solver.sh";
+
+/**
+ * Writes the export file of a study in its own output directory, and returns its path.
+ */
+string createStudy(const string& name) {
+	const fs::path outputPath = fs::path(PROJECT_BINARY_DIR "/Testing/aster_runner") / name;
+	fs::create_directories(outputPath);
+	const fs::path exportPath = outputPath / (name + ".export");
+	ofstream exportFile(exportPath.string());
+	exportFile << "P mpi_nbcpu 1" << endl;
+	exportFile << "P ncpus 1" << endl;
+	exportFile << "P memory_limit 1024" << endl;
+	return exportPath.string();
+}
+
+Runner::ExitCode runMockAster(const string& exportPath, const string& mockArguments) {
+	const string outputPath = fs::path(exportPath).parent_path().string();
+	ConfigurationParameters configuration("study.dat", CODE_ASTER, "", "vega", outputPath,
+			LogLevel::INFO, ConfigurationParameters::BEST_EFFORT, "", 0.02, true, "",
+			MOCK_SOLVER + " " + mockArguments);
+	AsterRunnerImpl runner;
+	return runner.execSolver(configuration, exportPath);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_successful_run ) {
+	const string exportPath = createStudy("success");
+	BOOST_CHECK_EQUAL(runMockAster(exportPath, "--out OK --file success.resu OK"), Runner::OK);
+	BOOST_CHECK(fs::exists(fs::path(exportPath).parent_path() / "success.stdout"));
+}
+
+BOOST_AUTO_TEST_CASE( test_failures ) {
+	const string exportPath = createStudy("failure");
+	BOOST_CHECK_EQUAL(runMockAster(exportPath, "--out NOOK --file failure.resu NOOK"),
+			Runner::TEST_FAIL);
+	BOOST_CHECK_EQUAL(runMockAster(exportPath, "--out OK"), Runner::SOLVER_RESULT_NOT_FOUND);
+	BOOST_CHECK_EQUAL(runMockAster(exportPath, "--exit 1"), Runner::SOLVER_EXIT_NOT_ZERO);
+	BOOST_CHECK_EQUAL(runMockAster(exportPath, "--exit 4"), Runner::TRANSLATION_SYNTAX_ERROR);
+}
+
+BOOST_AUTO_TEST_CASE( test_quoted_command ) {
+	const string exportPath = createStudy("quoted");
+	const fs::path outputPath = fs::path(exportPath).parent_path();
+	BOOST_CHECK_EQUAL(
+			runMockAster(exportPath,
+					"--file 'single quoted.txt' \"OK \\\"1\\\"\" --file escaped\\ name.txt '' --file quoted.resu OK"),
+			Runner::OK);
+	ifstream singleQuoted((outputPath / "single quoted.txt").string());
+	string line;
+	BOOST_REQUIRE(getline(singleQuoted, line));
+	BOOST_CHECK_EQUAL(line, "OK \"1\"");
+	BOOST_CHECK(fs::exists(outputPath / "escaped name.txt"));
+	BOOST_CHECK_THROW(runMockAster(exportPath, "--out 'OK"), invalid_argument);
+}
@@ -93,4 +93,87 @@ BOOST_AUTO_TEST_CASE(test_comments_in_the_end) {
 	}
 	//expected 1 material elastic
 }
+
+BOOST_AUTO_TEST_CASE(test_write_all_cell_types) {
+	string testLocation = fs::path(
+	PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/cells.dat").make_preferred().string();
+	string outputPath = fs::path(PROJECT_BINARY_DIR "/bin").make_preferred().string();
+	const ConfigurationParameters configuration(testLocation, NASTRAN, "", "", outputPath);
+	nastran::NastranParser parser;
+	const shared_ptr<Model> model = parser.parse(configuration);
+	model->finish();
+	nastran::NastranWriter writer;
+	string writtenFile = writer.writeModel(model, configuration);
+
+	nastran::NastranParser parser2;
+	const shared_ptr<Model> model2 = parser2.parse(
+			ConfigurationParameters(writtenFile, NASTRAN, "", "", outputPath));
+	BOOST_CHECK_EQUAL(model->mesh->countCells(), model2->mesh->countCells());
+	for (int cellId = 1; cellId <= 14; cellId++) {
+		const Cell cell = model->mesh->findCell(model->mesh->findCellPosition(cellId));
+		const Cell cell2 = model2->mesh->findCell(model2->mesh->findCellPosition(cellId));
+		BOOST_CHECK_EQUAL(cell.type.code, cell2.type.code);
+		BOOST_CHECK_EQUAL_COLLECTIONS(cell.nodeIds.begin(), cell.nodeIds.end(),
+				cell2.nodeIds.begin(), cell2.nodeIds.end());
+	}
+	shared_ptr<ElementSet> mass = model2->find(Reference<ElementSet>(ElementSet::NODAL_MASS, 14));
+	BOOST_REQUIRE(mass);
+	const NodalMass& nodalMass = dynamic_cast<const NodalMass&>(*mass);
+	BOOST_CHECK_CLOSE(2.5, nodalMass.getMassAsForce(), 1e-12);
+	// the parser stores IXY = -I21
+	BOOST_CHECK_CLOSE(0.1, nodalMass.ixy, 1e-12);
+	BOOST_CHECK_CLOSE(0.2, nodalMass.ey, 1e-12);
+}
+
 //____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_dmig ) {
+	string testLocation = fs::path(
+	PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/dmig.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	const shared_ptr<Model> model = parser.parse(
+			ConfigurationParameters(testLocation, CODE_ASTER, "", ""));
+	vector<shared_ptr<ElementSet>> matrices = model->filterElements(ElementSet::STIFFNESS_MATRIX);
+	BOOST_REQUIRE_EQUAL(matrices.size(), (size_t )1);
+	shared_ptr<MatrixElement> matrix = static_pointer_cast<MatrixElement>(matrices[0]);
+	const int nodePosition1 = model->mesh->findNodePosition(1);
+	const int nodePosition2 = model->mesh->findNodePosition(2);
+	BOOST_CHECK_CLOSE(matrix->findSubmatrix(nodePosition1, nodePosition1).findComponent(DOF::DX, DOF::DX), 1000., 1e-9);
+	BOOST_CHECK_CLOSE(matrix->findSubmatrix(nodePosition1, nodePosition2).findComponent(DOF::DX, DOF::DX), -1000., 1e-9);
+	// repeated term: the last value is kept
+	BOOST_CHECK_CLOSE(matrix->findSubmatrix(nodePosition2, nodePosition2).findComponent(DOF::DX, DOF::DX), 2000., 1e-9);
+	BOOST_CHECK_EQUAL(matrix->nodePairs().size(), (size_t )3);
+}
+
+BOOST_AUTO_TEST_CASE( test_dmig_buffer_spill ) {
+	shared_ptr<Model> model = make_shared<Model>("dmig", "UNKNOWN", NASTRAN);
+	shared_ptr<MatrixElement> matrix = make_shared<StiffnessMatrix>(*model);
+	// room for two terms only: each run holds two terms
+	nastran::DMIGBuffer buffer(48);
+	const int index = buffer.addMatrix("K", matrix);
+	BOOST_CHECK_EQUAL(buffer.findMatrixIndex("K"), index);
+	BOOST_CHECK_EQUAL(buffer.findMatrixIndex("M"), nastran::DMIGBuffer::NO_MATRIX);
+	for (int node = 10; node >= 1; node--) {
+		buffer.addComponent(index, node, DOF::DX, node, DOF::DX, node);
+	}
+	buffer.addComponent(index, 5, DOF::DX, 5, DOF::DX, 50.);
+	BOOST_CHECK_GE(buffer.countSpilledRuns(), (size_t )4);
+	buffer.assemble();
+	BOOST_CHECK_EQUAL(buffer.countSpilledRuns(), (size_t )0);
+	BOOST_CHECK_EQUAL(matrix->nodePairs().size(), (size_t )10);
+	const int nodePosition5 = model->mesh->findNodePosition(5);
+	const int nodePosition7 = model->mesh->findNodePosition(7);
+	BOOST_CHECK_CLOSE(matrix->findSubmatrix(nodePosition5, nodePosition5).findComponent(DOF::DX, DOF::DX), 50., 1e-9);
+	BOOST_CHECK_CLOSE(matrix->findSubmatrix(nodePosition7, nodePosition7).findComponent(DOF::DX, DOF::DX), 7., 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( test_tabled1_logarithmic ) {
+	string testLocation = fs::path(
+	PROJECT_BASE_DIR "/testdata/unitTest/nastranparser/tabled1_log.dat").make_preferred().string();
+	nastran::NastranParser parser;
+	const shared_ptr<Model> model = parser.parse(
+			ConfigurationParameters(testLocation, CODE_ASTER, "", ""));
+	BOOST_CHECK(model->find(Reference<Value>(Value::FUNCTION_TABLE, 1)));
+	// the point (0, 1) can't be interpolated on a logarithmic scale
+	BOOST_CHECK(!model->find(Reference<Value>(Value::FUNCTION_TABLE, 2)));
+}
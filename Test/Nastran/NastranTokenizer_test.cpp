@@ -33,6 +33,7 @@ using namespace std;
 
 #include "build_properties.h"
 #include "../../Nastran/NastranTokenizer.h"
+#include "../../Nastran/NastranWriter.h"
 
 BOOST_AUTO_TEST_CASE(nastran_short_with_comments) {
     string nastranLine = "$comment comment \nKEYWORD 12345\n2NDLINE 1234567 1234567 ";
@@ -310,3 +311,83 @@ void countGridElems(NastranTokenizer& tok) {
     BOOST_CHECK_EQUAL(4, symcount);
 }
 
+
+/**
+ * Exact comparison, or relative one with a tolerance in percent.
+ */
+void checkReadReal(double expected, double actual, double tolerance, bool exact) {
+    if (exact) {
+        BOOST_CHECK_EQUAL(expected, actual);
+    } else {
+        BOOST_CHECK_CLOSE(expected, actual, tolerance);
+    }
+}
+
+void checkCardWriterRoundTrip(vega::nastran::CardWriter::FieldFormat fieldFormat, double tolerance,
+        bool exact = false) {
+    ostringstream ostr;
+    vega::nastran::CardWriter cards(ostr, fieldFormat);
+    cards.writeRuler();
+    cards << vega::nastran::Line("CARD").add(1).add().add(1.5e-7).add(-123456.789).add(
+            vector<int> { 3, 4, 5, 6, 7 }).add(0.1).add(12345678).add(0.1 + 0.2);
+    cards << vega::nastran::Line("TEST").add(2);
+    istringstream istr(ostr.str());
+    NastranTokenizer tok(istr);
+    tok.bulkSection();
+    tok.nextLine();
+    BOOST_CHECK_EQUAL("CARD", tok.nextString());
+    BOOST_CHECK_EQUAL(1, tok.nextInt());
+    BOOST_CHECK(tok.isNextEmpty());
+    tok.skip(1);
+    checkReadReal(1.5e-7, tok.nextDouble(), tolerance, exact);
+    checkReadReal(-123456.789, tok.nextDouble(), tolerance, exact);
+    for (int i = 3; i <= 7; i++) {
+        BOOST_CHECK_EQUAL(i, tok.nextInt());
+    }
+    checkReadReal(0.1, tok.nextDouble(), tolerance, exact);
+    BOOST_CHECK_EQUAL(12345678, tok.nextInt());
+    // 0.30000000000000004: 17 significant digits
+    checkReadReal(0.1 + 0.2, tok.nextDouble(), tolerance, exact);
+    BOOST_CHECK_EQUAL(tok.nextSymbolType, NastranTokenizer::SYMBOL_KEYWORD);
+    tok.nextLine();
+    BOOST_CHECK_EQUAL("TEST", tok.nextString());
+    BOOST_CHECK_EQUAL(2, tok.nextInt());
+}
+
+BOOST_AUTO_TEST_CASE(skipped_card_filter) {
+    string nastranLines = "GRID    1\n"
+            "DMIG    UNUSED  1       1               1       1       1.\n"
+            "+       2       1       2.\n"
+            "$ comment inside the card\n"
+            "+       3       1       3.\n"
+            "DMIG,USED,1,1,,1,1,1.\n"
+            "DMIGROT UNUSED  1\n"
+            "GRID    2\n";
+    istringstream istr(nastranLines);
+    NastranTokenizer tokenizer(istr);
+    tokenizer.bulkSection();
+    tokenizer.setSkippedCardFilter("dmig", [](const string& field1, const string& field2) {
+        return field1 == "UNUSED" && field2 == "1";
+    });
+    tokenizer.nextLine();
+    BOOST_CHECK_EQUAL(tokenizer.nextString(), "GRID");
+    tokenizer.nextLine();
+    BOOST_CHECK_EQUAL(tokenizer.nextString(), "DMIG");
+    BOOST_CHECK_EQUAL(tokenizer.nextString(), "USED");
+    tokenizer.nextLine();
+    // another keyword, which only starts like the filtered one
+    BOOST_CHECK_EQUAL(tokenizer.nextString(), "DMIGROT");
+    tokenizer.nextLine();
+    BOOST_CHECK_EQUAL(tokenizer.nextString(), "GRID");
+    BOOST_CHECK_EQUAL(tokenizer.nextInt(), 2);
+    tokenizer.nextLine();
+    BOOST_CHECK_EQUAL(tokenizer.nextSymbolType, NastranTokenizer::SYMBOL_EOF);
+}
+
+BOOST_AUTO_TEST_CASE(card_writer_round_trip) {
+    // tolerances in percent: small field keeps 8 chars, "-123457." for -123456.789, large
+    // field 16 chars. Free field is exact.
+    checkCardWriterRoundTrip(vega::nastran::CardWriter::SMALL_FIELD, 1e-3);
+    checkCardWriterRoundTrip(vega::nastran::CardWriter::LARGE_FIELD, 1e-12);
+    checkCardWriterRoundTrip(vega::nastran::CardWriter::FREE_FIELD, 0, true);
+}
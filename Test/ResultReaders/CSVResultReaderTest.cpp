@@ -6,10 +6,13 @@
 
 #include "build_properties.h"
 #include "../../ResultReaders/CSVResultReader.h"
+#include "../../ResultReaders/TextScanner.h"
 #include "../../Abstract/ConfigurationParameters.h"
 #include "../../Abstract/Model.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
 #include <string>
 
 using namespace std;
@@ -30,3 +33,51 @@ BOOST_AUTO_TEST_CASE(read_tut_01_csv) {
 	BOOST_CHECK_EQUAL(model->objectives.size(), 126);
 }
 
+
+BOOST_AUTO_TEST_CASE(read_csv_rows) {
+	const string testLocation = PROJECT_BINARY_DIR "/bin/rows.csv";
+	{
+		ofstream csv(testLocation);
+		csv << "#\n#D I S P L A C E M E N T S\n";
+		csv << " ,RESULTAT ,NOM_CHAM ,INST        ,\"NOEUD\" ,DX          ,DY          ,DRX\n";
+		csv << " ,RESU1    ,DEPL     , 0.00000E+00,N1    , 1.00000E-01, 2.00000E-01,\n";
+		csv << " ,RESU1    ,\"D\"\"E,PL\"  , 0.00000E+00,\"N2\"  , 3.00000E-01, 4.00000E-01, 5.0E-01\n";
+		csv << "\n";
+		csv << " ,RESU2    ,DEPL     , 1.00000E+00,N2    , 6.00000E-01,-7.00000E-01, 8.0D-01\n";
+		csv << " ,RESU2    ,DEPL     , 1.00000E+00\n";
+	}
+	vega::ConfigurationParameters params(string(""), vega::CODE_ASTER, string(""), string(""),
+			string("."), vega::LogLevel::INFO,
+			vega::ConfigurationParameters::TranslationMode::BEST_EFFORT, testLocation);
+	shared_ptr<vega::Model> model = make_shared<vega::Model>("rows", "", vega::SolverName::CODE_ASTER,
+			params.getModelConfiguration());
+	model->add(vega::LinearMecaStat(*model, "", 1));
+	model->add(vega::LinearMecaStat(*model, "", 2));
+	vega::result::CSVResultReader reader;
+	ostringstream errors;
+	streambuf* cerrBuffer = cerr.rdbuf(errors.rdbuf());
+	reader.add_assertions(params, model);
+	cerr.rdbuf(cerrBuffer);
+	// the empty DRX cell of N1 gives no assertion, the short row is an error
+	BOOST_CHECK_MESSAGE(errors.str().find("Line number 8 Row has 4 cells, the header 8")
+			!= string::npos, errors.str());
+	BOOST_CHECK_EQUAL(model->analyses.find(1)->getAssertions().size(), (size_t ) 5);
+	vector<shared_ptr<vega::Assertion>> assertions2 = model->analyses.find(2)->getAssertions();
+	BOOST_REQUIRE_EQUAL(assertions2.size(), (size_t ) 3);
+	vega::NodalDisplacementAssertion& drx =
+			dynamic_cast<vega::NodalDisplacementAssertion&>(*assertions2[2]);
+	BOOST_CHECK_EQUAL(drx.dof, vega::DOF::RX);
+	BOOST_CHECK_EQUAL(drx.value, 0.8);
+	BOOST_CHECK_EQUAL(drx.instant, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(split_csv_fields) {
+	const string line = " ,RESU1 ,\"a,\"\"b\"\"\" ,, 2.5";
+	vega::result::TextRange fields[5];
+	BOOST_REQUIRE_EQUAL(vega::result::splitFields(
+			vega::result::TextRange(line.data(), line.data() + line.size()), ',', fields, 5), 5u);
+	BOOST_CHECK_EQUAL(fields[1].str(), "RESU1 ");
+	BOOST_CHECK_EQUAL(fields[2].str(), "a,\"\"b\"\"");
+	BOOST_CHECK_EQUAL(fields[3].size(), 0u);
+	BOOST_CHECK_EQUAL(fields[4].str(), " 2.5");
+}
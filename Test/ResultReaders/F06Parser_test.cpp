@@ -12,10 +12,17 @@
 #include "build_properties.h"
 #include "../../Abstract/Model.h"
 #include "../../ResultReaders/F06Parser.h"
+#include "../../ResultReaders/ResultFilter.h"
+#include "../../ResultReaders/TextScanner.h"
 #include <boost/test/unit_test.hpp>
 //#include <valgrind/memcheck.h>
 #include <boost/pointer_cast.hpp>
 #include <boost/assign.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
 #include <string>
 
 using namespace std;
@@ -162,3 +169,154 @@ BOOST_AUTO_TEST_CASE(test_4a) {
 
 }
 
+
+BOOST_AUTO_TEST_CASE(test_number_scanner) {
+	const vector<string> numbers = { "4.901961E-01", "-1.5E-13", "0.0", "-0.0", "12", "3.",
+			".25", "1.234567890123E+05", "9.999999E+22", "1.0E-300", "123456789012345678901234",
+			"0.000123456", "+7.5e3" };
+	for (const string& number : numbers) {
+		double value;
+		BOOST_CHECK_MESSAGE(vega::result::parseDouble(
+				vega::result::TextRange(number.data(), number.data() + number.size()), value),
+				number);
+		BOOST_CHECK_EQUAL(value, strtod(number.c_str(), nullptr));
+	}
+	const char* fortran = "1.5D+02";
+	double value;
+	BOOST_CHECK(vega::result::parseDouble(
+			vega::result::TextRange(fortran, fortran + strlen(fortran)), value));
+	BOOST_CHECK_EQUAL(value, 150.0);
+	for (const char* invalid : { "", "-", "G", "1.0E", "1.0-05", "1,5" }) {
+		BOOST_CHECK_MESSAGE(!vega::result::parseDouble(
+				vega::result::TextRange(invalid, invalid + strlen(invalid)), value), invalid);
+	}
+	int intValue;
+	const string integer = "-42";
+	BOOST_CHECK(vega::result::parseInt(
+			vega::result::TextRange(integer.data(), integer.data() + integer.size()), intValue));
+	BOOST_CHECK_EQUAL(intValue, -42);
+}
+
+/**
+ * Writes a F06 file with the displacements of nodes 1 and 2 in subcase 1, and of node 2 in
+ * subcase 2, and returns a model with these nodes and subcases.
+ */
+shared_ptr<Model> writeSectionsF06(const string& testLocation) {
+	ofstream f06(testLocation);
+	f06 << "1    MSC.NASTRAN JOB                                                         PAGE     1\n";
+	f06 << "0                                                                            SUBCASE 1\n";
+	f06 << " \n";
+	f06 << "                                       D I S P L A C E M E N T   V E C T O R\n";
+	f06 << " \n";
+	f06 << "      POINT ID.   TYPE          T1             T2             T3             R1             R2             R3\n";
+	f06 << "             1      G      1.000000E-01   0.0            0.0            0.0            0.0            0.0\n";
+	f06 << "             2      G      2.000000E-01  -1.500000E-13   0.0            0.0            0.0            0.0\n";
+	f06 << "1    MSC.NASTRAN JOB                                                         PAGE     2\n";
+	f06 << "0                                                                            SUBCASE 2\n";
+	f06 << "                                       D I S P L A C E M E N T   V E C T O R\n";
+	f06 << "      POINT ID.   TYPE          T1             T2             T3             R1             R2             R3\n";
+	f06 << "             2      G      3.000000E-01   0.0            0.0            0.0            0.0            0.0\n";
+	shared_ptr<Model> model(new Model("mname", "unknown", NASTRAN, true));
+	model->mesh->addNode(1, 0, 0, 0);
+	model->mesh->addNode(2, 1, 0, 0);
+	model->add(LinearMecaStat(*model, "", 1));
+	model->add(LinearMecaStat(*model, "", 2));
+	return model;
+}
+
+BOOST_AUTO_TEST_CASE(f06_sections_by_subcase) {
+	const string testLocation = PROJECT_BINARY_DIR "/bin/sections.f06";
+	shared_ptr<Model> model = writeSectionsF06(testLocation);
+	ConfigurationParameters confParams("inputFile", vega::CODE_ASTER, "..", "vega", ".",
+			LogLevel::INFO, ConfigurationParameters::MODE_STRICT, testLocation, 0.0003);
+	F06Parser f06parser;
+	f06parser.add_assertions(confParams, model);
+
+	shared_ptr<Analysis> analysis1 = model->analyses.find(1);
+	shared_ptr<Analysis> analysis2 = model->analyses.find(2);
+	BOOST_REQUIRE(analysis1 != nullptr && analysis2 != nullptr);
+	BOOST_CHECK_EQUAL(analysis1->getAssertions().size(), (size_t ) 12);
+	vector<shared_ptr<Assertion>> assertions2 = analysis2->getAssertions();
+	BOOST_REQUIRE_EQUAL(assertions2.size(), (size_t ) 6);
+	NodalDisplacementAssertion& dx = dynamic_cast<NodalDisplacementAssertion&>(*assertions2[0]);
+	BOOST_CHECK_EQUAL(dx.dof, DOF::DX);
+	BOOST_CHECK_EQUAL(dx.value, 0.3);
+	for (const auto& assertion : analysis1->getAssertions()) {
+		NodalDisplacementAssertion& displacement =
+				dynamic_cast<NodalDisplacementAssertion&>(*assertion);
+		if (displacement.dof == DOF::DY) {
+			// values under 1e-12 are zeroed
+			BOOST_CHECK_EQUAL(displacement.value, 0.0);
+		}
+	}
+}
+
+ConfigurationParameters filteredConfiguration(const string& testLocation, const string& nodes,
+		const string& dofs, const string& subcases, int sampleCount, const string& sampling) {
+	ConfigurationParameters configuration("inputFile", vega::CODE_ASTER, "..", "vega", ".",
+			LogLevel::INFO, ConfigurationParameters::MODE_STRICT, testLocation, 0.0003);
+	configuration.testNodes = nodes;
+	configuration.testDofs = dofs;
+	configuration.testSubcases = subcases;
+	configuration.testSampleCount = sampleCount;
+	configuration.testSampling = sampling;
+	return configuration;
+}
+
+BOOST_AUTO_TEST_CASE(f06_result_filter) {
+	const string testLocation = PROJECT_BINARY_DIR "/bin/filtered_sections.f06";
+	shared_ptr<Model> model = writeSectionsF06(testLocation);
+	F06Parser f06parser;
+	f06parser.add_assertions(filteredConfiguration(testLocation, "2", "DX,DRZ", "", 0, "stride"),
+			model);
+	BOOST_CHECK_EQUAL(model->analyses.find(1)->getAssertions().size(), (size_t ) 2);
+	BOOST_CHECK_EQUAL(model->analyses.find(2)->getAssertions().size(), (size_t ) 2);
+
+	model = writeSectionsF06(testLocation);
+	f06parser.add_assertions(filteredConfiguration(testLocation, "1:5", "T1", "1", 1, "stride"),
+			model);
+	vector<shared_ptr<Assertion>> assertions1 = model->analyses.find(1)->getAssertions();
+	BOOST_REQUIRE_EQUAL(assertions1.size(), (size_t ) 1);
+	NodalDisplacementAssertion& dx = dynamic_cast<NodalDisplacementAssertion&>(*assertions1[0]);
+	BOOST_CHECK_EQUAL(dx.dof, DOF::DX);
+	BOOST_CHECK_EQUAL(dx.value, 0.1);
+	BOOST_CHECK(model->analyses.find(2)->getAssertions().empty());
+
+	BOOST_CHECK_THROW(
+			result::ResultFilter(filteredConfiguration(testLocation, "UNKNOWN", "", "", 0, "stride"), *model),
+			invalid_argument);
+	BOOST_CHECK_THROW(
+			result::ResultFilter(filteredConfiguration(testLocation, "", "DW", "", 0, "stride"), *model),
+			invalid_argument);
+	const result::ResultFilter randomFilter(
+			filteredConfiguration(testLocation, "", "", "", 30, "random"), *model);
+	const vector<size_t> kept = randomFilter.sample(1000, 3);
+	BOOST_CHECK_EQUAL(count(kept.begin(), kept.end(), size_t(3)), 10);
+	BOOST_CHECK_EQUAL(count(kept.begin(), kept.end(), size_t(0)), 990);
+	BOOST_CHECK(randomFilter.sample(1000, 3) == kept);
+	// 31 values: the last of the 11 candidates is cut to 1 value
+	const result::ResultFilter strideFilter(
+			filteredConfiguration(testLocation, "", "", "", 31, "stride"), *model);
+	const vector<size_t> strided = strideFilter.sample(1000, 3);
+	BOOST_CHECK_EQUAL(accumulate(strided.begin(), strided.end(), size_t(0)), (size_t ) 31);
+	BOOST_CHECK_EQUAL(count(strided.begin(), strided.end(), size_t(3)), 10);
+	const auto last = find_if(strided.rbegin(), strided.rend(),
+			[](size_t count) {return count > 0;});
+	BOOST_CHECK_EQUAL(*last, (size_t ) 1);
+}
+
+BOOST_AUTO_TEST_CASE(f06_read_before_model) {
+	const string testLocation = PROJECT_BINARY_DIR "/bin/read_sections.f06";
+	shared_ptr<Model> model = writeSectionsF06(testLocation);
+	const ConfigurationParameters configuration = filteredConfiguration(testLocation, "TOP", "DX",
+			"", 0, "stride");
+	F06Parser f06parser;
+	// the file is read without the model, the group is only known once the model is parsed
+	f06parser.read(configuration);
+	model->mesh->findOrCreateNodeGroup("TOP")->addNode(2);
+	f06parser.add_assertions(configuration, model);
+	BOOST_CHECK_EQUAL(model->analyses.find(1)->getAssertions().size(), (size_t ) 1);
+	vector<shared_ptr<Assertion>> assertions2 = model->analyses.find(2)->getAssertions();
+	BOOST_REQUIRE_EQUAL(assertions2.size(), (size_t ) 1);
+	BOOST_CHECK_EQUAL(dynamic_cast<NodalDisplacementAssertion&>(*assertions2[0]).value, 0.3);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) Alneos, s. a r. l. (contact@alneos.fr)
+ * Released under the GNU General Public License
+ */
+#define BOOST_TEST_MODULE ResultComparatorTest
+
+#include "../../ResultReaders/ResultComparator.h"
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vega::result;
+namespace fs = boost::filesystem;
+
+namespace {
+
+DisplacementReference makeReference(const string& resultName, double instant, int nodeNumber,
+		const string& component, double value, double tolerance, bool relative) {
+	DisplacementReference reference;
+	reference.resultName = resultName;
+	reference.instant = instant;
+	reference.nodeNumber = nodeNumber;
+	reference.nodeId = 100 + nodeNumber;
+	reference.component = component;
+	reference.value = value;
+	reference.tolerance = tolerance;
+	reference.relative = relative;
+	return reference;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(test_references_roundtrip) {
+	vector<DisplacementReference> references = {
+			makeReference("RESU1", DisplacementReference::FIRST_STEP, 3, "DX", 1.0 / 3.0, 0.02, true),
+			makeReference("RESU2", 0.5, 7, "DRZ", 0.0, 1e-5, false) };
+	const fs::path path = fs::temp_directory_path() / fs::unique_path("vega-%%%%-%%%%.ref");
+	ResultComparator::writeReferences(path.string(), references);
+	vector<DisplacementReference> read = ResultComparator::readReferences(path.string());
+	fs::remove(path);
+	BOOST_REQUIRE_EQUAL(read.size(), references.size());
+	for (size_t i = 0; i < read.size(); i++) {
+		BOOST_CHECK_EQUAL(read[i].resultName, references[i].resultName);
+		BOOST_CHECK_EQUAL(read[i].nodeNumber, references[i].nodeNumber);
+		BOOST_CHECK_EQUAL(read[i].nodeId, references[i].nodeId);
+		BOOST_CHECK_EQUAL(read[i].component, references[i].component);
+		BOOST_CHECK_EQUAL(read[i].relative, references[i].relative);
+		// written with all the digits: read back exactly
+		BOOST_CHECK_EQUAL(read[i].value, references[i].value);
+		BOOST_CHECK_EQUAL(read[i].instant, references[i].instant);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_compare_fields) {
+	ResultComparator comparator;
+	NodalField full;
+	full.components = { "DX", "DY", "DZ" };
+	// nodes 1 to 3
+	full.values = { 1.0, 2.0, 3.0, 0.0, 0.0, 0.0, -1.0, -2.0, -3.0 };
+	comparator.addField("RESU1", 1, 0.0, full);
+	NodalField partial;
+	partial.components = { "DX", "DY", "DZ", "DRX", "DRY", "DRZ" };
+	// nodes 5 and 2, in this order
+	partial.nodeNumbers = { 5, 2 };
+	partial.values = { 0.5, 0, 0, 0, 0, 0.25, 0.1, 0, 0, 0, 0, 0 };
+	comparator.addField("RESU2", 1, 1.0, partial);
+	comparator.addField("RESU2", 2, 2.0, full);
+
+	vector<DisplacementReference> references = {
+			makeReference("RESU1", DisplacementReference::FIRST_STEP, 1, "DY", 2.01, 0.01, true),
+			makeReference("RESU1", DisplacementReference::FIRST_STEP, 2, "DZ", 5e-6, 1e-5, false),
+			makeReference("RESU2", 1.0, 5, "DRZ", 0.25, 1e-3, true),
+			makeReference("RESU2", 1.0, 2, "DX", 0.1, 1e-3, true),
+			makeReference("RESU2", 2.0, 3, "DZ", -3.0, 1e-3, true) };
+	ComparisonSummary summary = comparator.compare(references);
+	BOOST_CHECK(summary.ok());
+	BOOST_CHECK_EQUAL(summary.comparedCount, references.size());
+	BOOST_CHECK_CLOSE(summary.maxError, 0.01 / 2.01, 1e-6);
+
+	references.push_back(makeReference("RESU1", DisplacementReference::FIRST_STEP, 3, "DX", -1.1, 0.01, true));
+	references.push_back(makeReference("RESU2", 1.0, 3, "DX", 0.0, 1e-5, false));
+	references.push_back(makeReference("RESU3", DisplacementReference::FIRST_STEP, 1, "DX", 0.0, 1e-5, false));
+	summary = comparator.compare(references);
+	BOOST_CHECK(!summary.ok());
+	BOOST_CHECK_EQUAL(summary.failedCount, 1);
+	BOOST_CHECK_EQUAL(summary.missingCount, 2);
+	vector<int> expectedNodeIds = { 101, 103 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(summary.failingNodeIds.begin(), summary.failingNodeIds.end(),
+			expectedNodeIds.begin(), expectedNodeIds.end());
+}